@@ -0,0 +1,66 @@
+#ifndef LOADPROGRESS_H
+#define LOADPROGRESS_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace MarcSLM {
+namespace Application {
+
+/**
+ * @brief Progress and cancellation token shared between a loader and its caller
+ *
+ * The loader reports how many bytes of the input it has processed and
+ * polls isCancelled() between blocks of work; the caller (typically the
+ * GUI thread) reads the counters and may request cancellation at any time.
+ * All members are lock-free atomics, so both sides can use it concurrently.
+ *
+ * Loaders that pass over the input more than once (e.g. hashing it for a
+ * cache lookup before parsing) announce each pass as a phase and restart
+ * the byte count, so the caller can label what the bar is showing.
+ */
+class LoadProgress {
+public:
+    enum class Phase : std::uint8_t {
+        Loading,    // reading and decoding the model
+        Hashing     // identifying the file for a cache lookup
+    };
+
+    LoadProgress() = default;
+    LoadProgress(const LoadProgress&) = delete;
+    LoadProgress& operator=(const LoadProgress&) = delete;
+
+    void setTotalBytes(std::uint64_t bytes) { m_totalBytes.store(bytes, std::memory_order_relaxed); }
+    void addBytes(std::uint64_t bytes) { m_bytesDone.fetch_add(bytes, std::memory_order_relaxed); }
+    void setBytesDone(std::uint64_t bytes) { m_bytesDone.store(bytes, std::memory_order_relaxed); }
+
+    std::uint64_t totalBytes() const { return m_totalBytes.load(std::memory_order_relaxed); }
+    std::uint64_t bytesDone() const { return m_bytesDone.load(std::memory_order_relaxed); }
+
+    /// Completed fraction in [0, 1]; 0 while the total is unknown
+    double fraction() const {
+        const std::uint64_t total = totalBytes();
+        if (total == 0) {
+            return 0.0;
+        }
+        const double f = static_cast<double>(bytesDone()) / static_cast<double>(total);
+        return f < 1.0 ? f : 1.0;
+    }
+
+    void setPhase(Phase phase) { m_phase.store(phase, std::memory_order_relaxed); }
+    Phase phase() const { return m_phase.load(std::memory_order_relaxed); }
+
+    void cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+    bool isCancelled() const { return m_cancelled.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<std::uint64_t> m_totalBytes{0};
+    std::atomic<std::uint64_t> m_bytesDone{0};
+    std::atomic<bool> m_cancelled{false};
+    std::atomic<Phase> m_phase{Phase::Loading};
+};
+
+} // namespace Application
+} // namespace MarcSLM
+
+#endif // LOADPROGRESS_H
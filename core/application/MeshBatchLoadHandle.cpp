@@ -0,0 +1,191 @@
+#include "MeshBatchLoadHandle.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <numeric>
+#include <system_error>
+#include <thread>
+
+namespace MarcSLM {
+namespace Application {
+
+MeshBatchLoadHandle::~MeshBatchLoadHandle() {
+    abandon();
+}
+
+MeshBatchLoadHandle& MeshBatchLoadHandle::operator=(MeshBatchLoadHandle&& other) {
+    if (this != &other) {
+        abandon();
+        m_state = std::move(other.m_state);
+        m_workers = std::move(other.m_workers);
+        m_takenCancelled = other.m_takenCancelled;
+    }
+    return *this;
+}
+
+void MeshBatchLoadHandle::abandon() {
+    if (m_state) {
+        cancel();
+        for (auto& worker : m_workers) {
+            worker.wait();
+        }
+        m_workers.clear();
+        m_state.reset();
+    }
+}
+
+MeshBatchLoadHandle MeshBatchLoadHandle::start(std::shared_ptr<IStlFileLoader> loader,
+                                               std::vector<std::string> filePaths,
+                                               unsigned maxWorkers) {
+    MeshBatchLoadHandle handle;
+    auto state = std::make_shared<State>();
+    state->loader = std::move(loader);
+    state->filePaths = std::move(filePaths);
+
+    const std::size_t count = state->filePaths.size();
+    state->progress.reserve(count);
+    state->results.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        state->progress.push_back(std::make_unique<LoadProgress>());
+
+        // Loaders that know better (e.g. compressed formats) may override this
+        std::error_code ec;
+        const std::uintmax_t size = std::filesystem::file_size(
+            std::filesystem::u8path(state->filePaths[i]), ec);
+        if (!ec) {
+            state->progress[i]->setTotalBytes(size);
+        }
+    }
+
+    // Largest files first: the batch then ends shortly after its largest
+    // part instead of waiting for a big file picked up last
+    state->order.resize(count);
+    std::iota(state->order.begin(), state->order.end(), std::size_t{0});
+    std::stable_sort(state->order.begin(), state->order.end(), [&](std::size_t a, std::size_t b) {
+        return state->progress[a]->totalBytes() > state->progress[b]->totalBytes();
+    });
+
+    handle.m_state = state;
+    if (count == 0) {
+        return handle;
+    }
+
+    const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (maxWorkers == 0) {
+        maxWorkers = hardwareThreads;
+    }
+    const std::size_t workers = std::min<std::size_t>(maxWorkers, count);
+    state->threads = std::make_unique<Domain::ParallelWorkerShare>(
+        hardwareThreads, static_cast<unsigned>(workers));
+    handle.m_workers.reserve(workers);
+    for (std::size_t w = 0; w < workers; ++w) {
+        handle.m_workers.push_back(std::async(std::launch::async, [state]() {
+            runWorker(*state);
+        }));
+    }
+    return handle;
+}
+
+void MeshBatchLoadHandle::runWorker(State& state) {
+    runFiles(state);
+    state.threads->taskFinished();
+}
+
+void MeshBatchLoadHandle::runFiles(State& state) {
+    // Readers and welders parallelise internally; without a limit every
+    // worker would split its loops across all cores again
+    Domain::ScopedParallelWorkerLimit limit(*state.threads);
+
+    const std::size_t count = state.order.size();
+    for (std::size_t n = state.nextFile.fetch_add(1); n < count; n = state.nextFile.fetch_add(1)) {
+        const std::size_t i = state.order[n];
+        LoadProgress& progress = *state.progress[i];
+        if (!state.cancelled.load(std::memory_order_relaxed) && state.loader) {
+            state.results[i] = state.loader->loadWithProgress(state.filePaths[i], progress);
+        }
+        if (state.results[i] && !progress.isCancelled()) {
+            state.results[i]->collisionMesh = Domain::MeshBvh::build(state.results[i]->mesh);
+            state.results[i]->hull = Domain::HullVertices::build(state.results[i]->mesh);
+        }
+        state.finished.fetch_add(1, std::memory_order_release);
+    }
+}
+
+bool MeshBatchLoadHandle::isReady() const {
+    if (!m_state) {
+        return false;
+    }
+    for (const auto& worker : m_workers) {
+        if (worker.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void MeshBatchLoadHandle::cancel() {
+    if (!m_state) {
+        return;
+    }
+    m_state->cancelled.store(true, std::memory_order_relaxed);
+    for (auto& progress : m_state->progress) {
+        progress->cancel();
+    }
+}
+
+bool MeshBatchLoadHandle::isCancelled() const {
+    return m_state ? m_state->cancelled.load(std::memory_order_relaxed) : m_takenCancelled;
+}
+
+const std::vector<std::string>& MeshBatchLoadHandle::filePaths() const {
+    static const std::vector<std::string> none;
+    return m_state ? m_state->filePaths : none;
+}
+
+std::size_t MeshBatchLoadHandle::finishedCount() const {
+    return m_state ? m_state->finished.load(std::memory_order_acquire) : 0;
+}
+
+double MeshBatchLoadHandle::progress() const {
+    if (!m_state || m_state->progress.empty()) {
+        return 0.0;
+    }
+
+    std::uint64_t total = 0;
+    std::uint64_t done = 0;
+    for (const auto& p : m_state->progress) {
+        const std::uint64_t t = p->totalBytes();
+        total += t;
+        done += std::min(p->bytesDone(), t);
+    }
+    if (total == 0) {
+        return static_cast<double>(finishedCount()) / static_cast<double>(m_state->progress.size());
+    }
+    return static_cast<double>(done) / static_cast<double>(total);
+}
+
+std::vector<std::unique_ptr<MeshData>> MeshBatchLoadHandle::take() {
+    std::vector<std::unique_ptr<MeshData>> results;
+    if (!m_state) {
+        return results;
+    }
+
+    for (auto& worker : m_workers) {
+        worker.get();
+    }
+    m_workers.clear();
+
+    results = std::move(m_state->results);
+    m_takenCancelled = isCancelled();
+    if (m_takenCancelled) {
+        for (auto& meshData : results) {
+            meshData.reset();
+        }
+    }
+    m_state.reset();
+    return results;
+}
+
+} // namespace Application
+} // namespace MarcSLM
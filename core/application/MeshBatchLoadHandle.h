@@ -0,0 +1,107 @@
+#ifndef MESHBATCHLOADHANDLE_H
+#define MESHBATCHLOADHANDLE_H
+
+#include "LoadProgress.h"
+#include "interfaces/IStlFileLoader.h"
+#include "../domain/ParallelFor.h"
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace MarcSLM {
+namespace Application {
+
+/**
+ * @brief Several mesh loads running concurrently on a small worker pool
+ *
+ * The batch counterpart of MeshLoadHandle. Workers pull the next file
+ * from a shared counter, so a plate of many small parts and one large
+ * part finishes in roughly the time of the large part. Every file has
+ * its own LoadProgress; progress() weights them by file size. As in
+ * MeshLoadHandle, workers also build each mesh's collision BVH and hull.
+ * The loaders' own parallel loops share the hardware threads among the
+ * workers still running, so a batch never runs more threads than cores.
+ *
+ * Results come back from take() in the order the paths were given,
+ * independent of which worker loaded which file. A file that failed to
+ * load yields nullptr in its slot; a cancelled batch yields only nullptr.
+ *
+ * Destroying an unfinished handle cancels all loads and waits for the
+ * workers to return.
+ */
+class MeshBatchLoadHandle {
+public:
+    MeshBatchLoadHandle() = default;
+    ~MeshBatchLoadHandle();
+
+    MeshBatchLoadHandle(MeshBatchLoadHandle&&) = default;
+    MeshBatchLoadHandle& operator=(MeshBatchLoadHandle&& other);
+    MeshBatchLoadHandle(const MeshBatchLoadHandle&) = delete;
+    MeshBatchLoadHandle& operator=(const MeshBatchLoadHandle&) = delete;
+
+    /**
+     * @brief Start loading filePaths in the background
+     * @param loader Shared by all workers; must be safe to call concurrently
+     * @param maxWorkers Upper bound on concurrent loads; 0 uses the number
+     *        of hardware threads
+     */
+    static MeshBatchLoadHandle start(std::shared_ptr<IStlFileLoader> loader,
+                                     std::vector<std::string> filePaths,
+                                     unsigned maxWorkers = 0);
+
+    /// True between start() and take()
+    bool isValid() const { return static_cast<bool>(m_state); }
+
+    /// True once take() will not block
+    bool isReady() const;
+
+    void cancel();
+    /// Still answers after take(), for the batch that was taken
+    bool isCancelled() const;
+
+    std::size_t fileCount() const { return m_state ? m_state->filePaths.size() : 0; }
+    const std::vector<std::string>& filePaths() const;
+
+    /// Number of files whose load has returned (successfully or not)
+    std::size_t finishedCount() const;
+
+    /// Completed fraction of all bytes in the batch, in [0, 1]
+    double progress() const;
+
+    /**
+     * @brief Wait for every load to finish and return the results
+     * @return One entry per path, in input order; nullptr where loading
+     *         failed, and for every file if the batch was cancelled
+     */
+    std::vector<std::unique_ptr<MeshData>> take();
+
+private:
+    struct State {
+        std::shared_ptr<IStlFileLoader> loader;
+        std::vector<std::string> filePaths;
+        std::vector<std::unique_ptr<LoadProgress>> progress;  // one per file
+        std::vector<std::unique_ptr<MeshData>> results;       // one per file
+        std::vector<std::size_t> order;                       // load order, largest first
+        std::atomic<std::size_t> nextFile{0};
+        std::atomic<std::size_t> finished{0};
+        std::atomic<bool> cancelled{false};
+        std::unique_ptr<Domain::ParallelWorkerShare> threads;  // for loops inside a load
+    };
+
+    std::shared_ptr<State> m_state;
+    std::vector<std::future<void>> m_workers;
+    bool m_takenCancelled = false;  // isCancelled() after take()
+
+    static void runWorker(State& state);
+    static void runFiles(State& state);
+    void abandon();
+};
+
+} // namespace Application
+} // namespace MarcSLM
+
+#endif // MESHBATCHLOADHANDLE_H
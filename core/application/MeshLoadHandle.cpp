@@ -0,0 +1,76 @@
+#include "MeshLoadHandle.h"
+
+#include <chrono>
+#include <filesystem>
+#include <system_error>
+
+namespace MarcSLM {
+namespace Application {
+
+MeshLoadHandle::~MeshLoadHandle() {
+    abandon();
+}
+
+MeshLoadHandle& MeshLoadHandle::operator=(MeshLoadHandle&& other) {
+    if (this != &other) {
+        abandon();
+        m_progress = std::move(other.m_progress);
+        m_result = std::move(other.m_result);
+    }
+    return *this;
+}
+
+void MeshLoadHandle::abandon() {
+    if (m_result.valid()) {
+        cancel();
+        m_result.wait();
+    }
+}
+
+MeshLoadHandle MeshLoadHandle::start(std::shared_ptr<IStlFileLoader> loader, const std::string& filePath) {
+    MeshLoadHandle handle;
+    handle.m_progress = std::make_shared<LoadProgress>();
+
+    // Loaders that know better (e.g. compressed formats) may override this
+    std::error_code ec;
+    const std::uintmax_t size = std::filesystem::file_size(std::filesystem::u8path(filePath), ec);
+    if (!ec) {
+        handle.m_progress->setTotalBytes(size);
+    }
+
+    std::shared_ptr<LoadProgress> progress = handle.m_progress;
+    handle.m_result = std::async(std::launch::async, [loader, progress, filePath]() {
+        std::unique_ptr<MeshData> meshData;
+        if (loader) {
+            meshData = loader->loadWithProgress(filePath, *progress);
+        }
+        if (meshData && !progress->isCancelled()) {
+            meshData->collisionMesh = Domain::MeshBvh::build(meshData->mesh);
+            meshData->hull = Domain::HullVertices::build(meshData->mesh);
+        }
+        return meshData;
+    });
+    return handle;
+}
+
+bool MeshLoadHandle::isReady() const {
+    return m_result.valid() &&
+           m_result.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void MeshLoadHandle::cancel() {
+    if (m_progress) {
+        m_progress->cancel();
+    }
+}
+
+std::unique_ptr<MeshData> MeshLoadHandle::take() {
+    if (!m_result.valid()) {
+        return nullptr;
+    }
+    std::unique_ptr<MeshData> meshData = m_result.get();
+    return isCancelled() ? nullptr : std::move(meshData);
+}
+
+} // namespace Application
+} // namespace MarcSLM
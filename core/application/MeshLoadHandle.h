@@ -0,0 +1,70 @@
+#ifndef MESHLOADHANDLE_H
+#define MESHLOADHANDLE_H
+
+#include "LoadProgress.h"
+#include "interfaces/IStlFileLoader.h"
+
+#include <future>
+#include <memory>
+#include <string>
+
+namespace MarcSLM {
+namespace Application {
+
+/**
+ * @brief A mesh load running on a background thread
+ *
+ * Created by start(); the caller polls isReady() and progress() from its
+ * own thread (e.g. a GUI timer) and collects the result with take().
+ * cancel() asks the loader to stop at its next checkpoint; a cancelled
+ * load yields nullptr. Besides loading, the worker builds the mesh's
+ * collision BVH and hull into the result.
+ *
+ * Destroying an unfinished handle cancels the load and waits for the
+ * worker to return, so the loader is never left running unowned.
+ */
+class MeshLoadHandle {
+public:
+    MeshLoadHandle() = default;
+    ~MeshLoadHandle();
+
+    MeshLoadHandle(MeshLoadHandle&&) = default;
+    MeshLoadHandle& operator=(MeshLoadHandle&& other);
+    MeshLoadHandle(const MeshLoadHandle&) = delete;
+    MeshLoadHandle& operator=(const MeshLoadHandle&) = delete;
+
+    /**
+     * @brief Start loading filePath on a new thread
+     * @param loader Kept alive by the handle until the load returns
+     */
+    static MeshLoadHandle start(std::shared_ptr<IStlFileLoader> loader, const std::string& filePath);
+
+    /// True between start() and take()
+    bool isValid() const { return m_result.valid(); }
+
+    /// True once take() will not block
+    bool isReady() const;
+
+    void cancel();
+    bool isCancelled() const { return m_progress && m_progress->isCancelled(); }
+
+    /// Live progress of the running load; valid while isValid()
+    const LoadProgress& progress() const { return *m_progress; }
+
+    /**
+     * @brief Wait for the load to finish and return its result
+     * @return The mesh data, or nullptr on failure or cancellation
+     */
+    std::unique_ptr<MeshData> take();
+
+private:
+    std::shared_ptr<LoadProgress> m_progress;
+    std::future<std::unique_ptr<MeshData>> m_result;
+
+    void abandon();
+};
+
+} // namespace Application
+} // namespace MarcSLM
+
+#endif // MESHLOADHANDLE_H
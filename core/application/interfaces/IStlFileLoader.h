@@ -2,6 +2,10 @@
 #define ISTLFILELOADER_H
 
 #include "../../domain/BoundingBox.h"
+#include "../../domain/HullVertices.h"
+#include "../../domain/MeshBvh.h"
+#include "../../domain/TriangleMesh.h"
+#include "../LoadProgress.h"
 #include <memory>
 #include <string>
 
@@ -19,9 +23,22 @@ struct MeshData {
     Domain::BoundingBox bounds;
     int triangleCount = 0;
     double volume = 0.0;
+    double surfaceArea = 0.0;
+    
+    // Indexed geometry, when the loader produces it natively. nativeData
+    // may reference these buffers directly, so they are shared, not copied.
+    std::shared_ptr<const Domain::TriangleMesh> mesh;
+    
+    // Collision BVH and convex hull of mesh, built by the load handles on
+    // their worker threads so that adding the model does not build them on
+    // the GUI thread
+    std::shared_ptr<const Domain::MeshBvh> collisionMesh;
+    std::shared_ptr<const Domain::HullVertices> hull;
     
     // Opaque shared ownership of infrastructure-specific data (e.g., vtkPolyData)
     // Use std::shared_ptr<void> so core interfaces don't include VTK headers.
+    // Null when the loader produced metrics only (e.g. a file too large to
+    // hold in memory); such data cannot be displayed.
     std::shared_ptr<void> nativeData;
 };
 
@@ -42,6 +59,23 @@ public:
      *         Returns nullptr on failure
      */
     virtual std::unique_ptr<MeshData> load(const std::string& filePath) = 0;
+    
+    /**
+     * @brief Load with progress reporting and cancellation
+     * 
+     * Implementations report processed input bytes to progress and return
+     * nullptr soon after progress.isCancelled() becomes true. The default
+     * falls back to the plain load() and only reports completion.
+     * Must be safe to call from a worker thread.
+     */
+    virtual std::unique_ptr<MeshData> loadWithProgress(const std::string& filePath, LoadProgress& progress) {
+        if (progress.isCancelled()) {
+            return nullptr;
+        }
+        auto meshData = load(filePath);
+        progress.setBytesDone(progress.totalBytes());
+        return progress.isCancelled() ? nullptr : std::move(meshData);
+    }
 };
 
 } // namespace Application
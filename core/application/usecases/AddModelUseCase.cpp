@@ -30,14 +30,55 @@ Result AddModelUseCase::execute(const std::string& filePath) {
     if (!meshData) {
         return Result::error("Failed to load STL file: " + filePath);
     }
+    meshData->collisionMesh = Domain::MeshBvh::build(meshData->mesh);
+    meshData->hull = Domain::HullVertices::build(meshData->mesh);
     
+    return addLoadedModel(filePath, *meshData);
+}
+
+Result AddModelUseCase::startLoad(const std::string& filePath, MeshLoadHandle& handle) {
+    if (!std::filesystem::exists(filePath)) {
+        return Result::error("File does not exist: " + filePath);
+    }
+    if (!m_fileLoader) return Result::error("No file loader available");
+    
+    notifyProgress("Loading model file...");
+    handle = MeshLoadHandle::start(m_fileLoader, filePath);
+    return Result::success();
+}
+
+Result AddModelUseCase::finishLoad(const std::string& filePath, MeshLoadHandle& handle) {
+    if (!handle.isValid()) {
+        return Result::error("No load in progress for: " + filePath);
+    }
+    
+    auto meshData = handle.take();
+    if (handle.isCancelled()) {
+        return Result::error("Loading cancelled: " + filePath);
+    }
+    if (!meshData) {
+        return Result::error("Failed to load model file: " + filePath);
+    }
+    
+    return addLoadedModel(filePath, *meshData);
+}
+
+Result AddModelUseCase::addLoadedModel(const std::string& filePath, const MeshData& meshData) {
+    m_addedModelId = -1;
+    m_addedActorId = -1;
+    if (m_renderer && !meshData.nativeData) {
+        return Result::error("Model too large to display (" +
+            std::to_string(meshData.triangleCount) + " triangles), not added: " + filePath);
+    }
     notifyProgress("Creating model entity...");
     
     // Create domain model
     Domain::Model model(filePath);
-    model.setBounds(meshData->bounds);
-    model.setTriangleCount(meshData->triangleCount);
-    model.setVolume(meshData->volume);
+    model.setBounds(meshData.bounds);
+    model.setTriangleCount(meshData.triangleCount);
+    model.setVolume(meshData.volume);
+    model.setCollisionMesh(meshData.collisionMesh);
+    model.setHull(meshData.hull);
     
     // Validate model is within build volume
     // (Allow adding for now, but could make this configurable)
@@ -54,11 +95,12 @@ Result AddModelUseCase::execute(const std::string& filePath) {
     if (!addedModel) {
         return Result::error("Failed to add model to build plate");
     }
+    m_addedModelId = assignedId;
     
     // Render if renderer available
-    if (m_renderer && meshData->nativeData) {
+    if (m_renderer && meshData.nativeData) {
         notifyProgress("Rendering model...");
-        m_renderer->addModel(*addedModel, meshData->nativeData);
+        m_addedActorId = m_renderer->addModel(*addedModel, meshData.nativeData);
         m_renderer->render();
     }
     
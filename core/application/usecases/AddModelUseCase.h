@@ -2,6 +2,7 @@
 #define ADDMODELUSECASE_H
 
 #include "../Result.h"
+#include "../MeshLoadHandle.h"
 #include "../interfaces/IStlFileLoader.h"
 #include "../interfaces/IModelRenderer.h"
 #include "../../domain/BuildPlate.h"
@@ -18,11 +19,19 @@ namespace Application {
  * 
  * Workflow:
  * 1. Load STL file using IStlFileLoader
- * 2. Create domain Model entity
+ * 2. Create domain Model entity with its collision BVH and hull
  * 3. Add model to BuildPlate
  * 4. Render model using IModelRenderer
  * 
  * This encapsulates the entire "Add Model" business process.
+ * 
+ * With a renderer, files the loader could only measure (no nativeData to
+ * display) are refused rather than placed as invisible parts; headless
+ * use places them by their bounds.
+ * 
+ * For interactive use the process is split in two: startLoad() runs step 1
+ * on a background thread, finishLoad() performs steps 2-4 and must be
+ * called on the thread that owns the build plate and renderer.
  */
 class AddModelUseCase {
 public:
@@ -47,6 +56,29 @@ public:
      */
     Result execute(const std::string& filePath);
     
+    /**
+     * @brief Start loading a file in the background
+     * @param filePath Absolute path to the model file
+     * @param handle Receives the running load (progress, cancellation)
+     * @return Error if the file does not exist or no loader is available
+     */
+    Result startLoad(const std::string& filePath, MeshLoadHandle& handle);
+    
+    /**
+     * @brief Complete a load started with startLoad()
+     * 
+     * Blocks until the load has finished, then creates the model, adds it
+     * to the build plate and renders it.
+     * @return Error if loading failed or was cancelled
+     */
+    Result finishLoad(const std::string& filePath, MeshLoadHandle& handle);
+    
+    /// BuildPlate id of the model added by the last successful call, -1 if none
+    int addedModelId() const { return m_addedModelId; }
+    
+    /// Renderer actor id of that model, -1 if it was not rendered
+    int addedActorId() const { return m_addedActorId; }
+    
     /**
      * @brief Set a callback for progress updates
      * @param callback Function called with status messages
@@ -60,8 +92,11 @@ private:
     std::shared_ptr<Domain::BuildPlate> m_buildPlate;
     std::shared_ptr<IModelRenderer> m_renderer;
     ProgressCallback m_progressCallback;
+    int m_addedModelId = -1;
+    int m_addedActorId = -1;
     
     void notifyProgress(const std::string& message);
+    Result addLoadedModel(const std::string& filePath, const MeshData& meshData);
 };
 
 } // namespace Application
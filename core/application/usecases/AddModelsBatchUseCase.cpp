@@ -0,0 +1,144 @@
+#include "AddModelsBatchUseCase.h"
+#include <filesystem>
+
+namespace MarcSLM {
+namespace Application {
+
+AddModelsBatchUseCase::AddModelsBatchUseCase(
+    std::shared_ptr<IStlFileLoader> fileLoader,
+    std::shared_ptr<Domain::BuildPlate> buildPlate,
+    std::shared_ptr<IModelRenderer> renderer
+)
+    : m_fileLoader(std::move(fileLoader))
+    , m_buildPlate(std::move(buildPlate))
+    , m_renderer(std::move(renderer))
+    , m_progressCallback(nullptr)
+{
+}
+
+std::vector<AddModelsBatchUseCase::AddedModel> AddModelsBatchUseCase::execute(
+    const std::vector<std::string>& filePaths) {
+    MeshBatchLoadHandle handle;
+    Result started = startLoad(filePaths, handle);
+    if (started.isError()) {
+        std::vector<AddedModel> added(filePaths.size());
+        for (std::size_t i = 0; i < filePaths.size(); ++i) {
+            added[i].filePath = filePaths[i];
+            added[i].errorMessage = started.errorMessage();
+        }
+        return added;
+    }
+    return finishLoad(handle);
+}
+
+Result AddModelsBatchUseCase::startLoad(const std::vector<std::string>& filePaths,
+                                        MeshBatchLoadHandle& handle) {
+    if (filePaths.empty()) return Result::error("No model files given");
+    if (!m_fileLoader) return Result::error("No file loader available");
+
+    notifyProgress("Loading " + std::to_string(filePaths.size()) + " model files...");
+    handle = MeshBatchLoadHandle::start(m_fileLoader, filePaths, m_maxWorkers);
+    return Result::success();
+}
+
+std::vector<AddModelsBatchUseCase::AddedModel> AddModelsBatchUseCase::finishLoad(
+    MeshBatchLoadHandle& handle) {
+    const std::vector<std::string> filePaths = handle.filePaths();
+    std::vector<AddedModel> added(filePaths.size());
+    for (std::size_t i = 0; i < filePaths.size(); ++i) {
+        added[i].filePath = filePaths[i];
+    }
+    if (!handle.isValid()) {
+        return added;
+    }
+
+    std::vector<std::unique_ptr<MeshData>> meshes = handle.take();
+    if (handle.isCancelled() || meshes.size() != filePaths.size()) {
+        for (auto& entry : added) {
+            entry.errorMessage = "Loading cancelled: " + entry.filePath;
+        }
+        return added;
+    }
+
+    notifyProgress("Creating model entities...");
+
+    // Create domain models for every file that loaded
+    std::vector<Domain::Model> models;
+    std::vector<std::size_t> sourceIndex;
+    models.reserve(meshes.size());
+    sourceIndex.reserve(meshes.size());
+    for (std::size_t i = 0; i < meshes.size(); ++i) {
+        if (!meshes[i]) {
+            added[i].errorMessage = std::filesystem::exists(filePaths[i])
+                ? "Failed to load model file: " + filePaths[i]
+                : "File does not exist: " + filePaths[i];
+            continue;
+        }
+        if (m_renderer && !meshes[i]->nativeData) {
+            added[i].errorMessage = "Model too large to display (" +
+                std::to_string(meshes[i]->triangleCount) + " triangles), not added: " + filePaths[i];
+            continue;
+        }
+        Domain::Model model(filePaths[i]);
+        model.setBounds(meshes[i]->bounds);
+        model.setTriangleCount(meshes[i]->triangleCount);
+        model.setVolume(meshes[i]->volume);
+        model.setCollisionMesh(meshes[i]->collisionMesh);
+        model.setHull(meshes[i]->hull);
+
+        // Validate model is within build volume
+        // (Allow adding for now, but could make this configurable)
+        if (m_buildPlate && !m_buildPlate->isInsideBuildVolume(model)) {
+            notifyProgress("Warning: Model may be outside build volume: " + filePaths[i]);
+        }
+        models.push_back(std::move(model));
+        sourceIndex.push_back(i);
+    }
+
+    if (!m_buildPlate) {
+        for (std::size_t i : sourceIndex) {
+            added[i].errorMessage = "No build plate available";
+        }
+        return added;
+    }
+    if (models.empty()) {
+        return added;
+    }
+
+    // Add to build plate in one pass (assigns IDs)
+    std::vector<int> assignedIds = m_buildPlate->addModels(models);
+
+    if (m_renderer) {
+        notifyProgress("Rendering models...");
+    }
+    for (std::size_t k = 0; k < assignedIds.size(); ++k) {
+        const std::size_t i = sourceIndex[k];
+        auto addedModel = m_buildPlate->getModel(assignedIds[k]);
+        if (!addedModel) {
+            added[i].errorMessage = "Failed to add model to build plate";
+            continue;
+        }
+        added[i].modelId = assignedIds[k];
+        if (m_renderer && meshes[i]->nativeData) {
+            added[i].actorId = m_renderer->addModel(*addedModel, meshes[i]->nativeData);
+        }
+    }
+
+    // One render for the whole batch
+    if (m_renderer) {
+        m_renderer->render();
+    }
+
+    notifyProgress(std::to_string(models.size()) + " of " +
+                   std::to_string(filePaths.size()) + " models added");
+    return added;
+}
+
+void AddModelsBatchUseCase::notifyProgress(const std::string& message) {
+    if (m_progressCallback) {
+        m_progressCallback(message);
+    }
+}
+
+} // namespace Application
+} // namespace MarcSLM
@@ -0,0 +1,112 @@
+#ifndef ADDMODELSBATCHUSECASE_H
+#define ADDMODELSBATCHUSECASE_H
+
+#include "../Result.h"
+#include "../MeshBatchLoadHandle.h"
+#include "../interfaces/IStlFileLoader.h"
+#include "../interfaces/IModelRenderer.h"
+#include "../../domain/BuildPlate.h"
+#include "../../domain/Model.h"
+#include <string>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace MarcSLM {
+namespace Application {
+
+/**
+ * @brief Use case for adding many model files to the build plate at once
+ *
+ * Workflow:
+ * 1. Load all files concurrently (MeshBatchLoadHandle)
+ * 2. Create a domain Model, with its collision BVH and hull, for every file that loaded
+ * 3. Add them to BuildPlate in one pass
+ * 4. Hand every model to IModelRenderer, then render once
+ *
+ * A file that fails to load does not stop the others; its entry in the
+ * returned list carries the error instead of an id. As in AddModelUseCase,
+ * with a renderer a file that could only be measured is refused.
+ *
+ * As with AddModelUseCase, startLoad() only starts step 1 in the
+ * background and finishLoad() performs steps 2-4 on the calling thread.
+ */
+class AddModelsBatchUseCase {
+public:
+    using ProgressCallback = std::function<void(const std::string&)>;
+
+    /**
+     * @brief Outcome for one file of the batch
+     */
+    struct AddedModel {
+        std::string filePath;
+        int modelId = -1;           // BuildPlate id, -1 if not added
+        int actorId = -1;           // Renderer actor id, -1 if not rendered
+        std::string errorMessage;
+
+        bool isSuccess() const { return modelId >= 0; }
+    };
+
+    /**
+     * @brief Construct the use case with required dependencies
+     * @param fileLoader Model file loading service; called from several threads
+     * @param buildPlate Build plate domain model
+     * @param renderer Rendering service (optional, can be null for headless mode)
+     */
+    AddModelsBatchUseCase(
+        std::shared_ptr<IStlFileLoader> fileLoader,
+        std::shared_ptr<Domain::BuildPlate> buildPlate,
+        std::shared_ptr<IModelRenderer> renderer = nullptr
+    );
+
+    /**
+     * @brief Load and add all files, blocking until done
+     * @param filePaths Absolute paths to model files
+     * @return One entry per path, in input order
+     */
+    std::vector<AddedModel> execute(const std::vector<std::string>& filePaths);
+
+    /**
+     * @brief Start loading all files in the background
+     * @param filePaths Absolute paths to model files
+     * @param handle Receives the running batch (progress, cancellation)
+     * @return Error if no path was given or no loader is available
+     */
+    Result startLoad(const std::vector<std::string>& filePaths, MeshBatchLoadHandle& handle);
+
+    /**
+     * @brief Complete a batch started with startLoad()
+     *
+     * Blocks until every load has finished. A cancelled batch adds nothing.
+     * @return One entry per path, in input order
+     */
+    std::vector<AddedModel> finishLoad(MeshBatchLoadHandle& handle);
+
+    /**
+     * @brief Set a callback for progress updates
+     * @param callback Function called with status messages
+     */
+    void setProgressCallback(ProgressCallback callback) {
+        m_progressCallback = std::move(callback);
+    }
+
+    /**
+     * @brief Limit the number of files loaded at the same time
+     * @param maxWorkers 0 (default) uses the number of hardware threads
+     */
+    void setMaxConcurrentLoads(unsigned maxWorkers) { m_maxWorkers = maxWorkers; }
+
+private:
+    std::shared_ptr<IStlFileLoader> m_fileLoader;
+    std::shared_ptr<Domain::BuildPlate> m_buildPlate;
+    std::shared_ptr<IModelRenderer> m_renderer;
+    ProgressCallback m_progressCallback;
+    unsigned m_maxWorkers = 0;
+
+    void notifyProgress(const std::string& message);
+};
+
+} // namespace Application
+} // namespace MarcSLM
+
+#endif // ADDMODELSBATCHUSECASE_H
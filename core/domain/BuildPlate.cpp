@@ -1,6 +1,7 @@
 #include "BuildPlate.h"
 #include <cmath>
 #include <algorithm>
+#include <iterator>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -26,20 +27,43 @@ int BuildPlate::addModel(const Model& model) {
         newModel.setBounds(model.bounds());
         newModel.setTriangleCount(model.triangleCount());
         newModel.setVolume(model.volume());
+        newModel.setCollisionMesh(model.collisionMesh());
+        newModel.setHull(model.hull());
         m_modelsById[assignedId] = std::make_shared<Model>(newModel);  // ? Map insertion, no reallocation of existing elements!
     } else {
         assignedId = model.id();
         m_nextId = std::max(m_nextId, model.id() + 1);
         m_modelsById[assignedId] = std::make_shared<Model>(model);  // ? Safe insertion
+        sweepRemove(assignedId);  // replaced model
     }
     
+    sweepInsert(assignedId, m_modelsById[assignedId]->worldBounds());
+    m_dirtyModels.insert(assignedId);
     return assignedId;
 }
 
+std::vector<int> BuildPlate::addModels(const std::vector<Model>& models) {
+    std::vector<int> assignedIds;
+    assignedIds.reserve(models.size());
+    m_modelsById.reserve(m_modelsById.size() + models.size());
+    m_sweep.reserve(m_sweep.size() + models.size());
+    
+    for (const auto& model : models) {
+        assignedIds.push_back(addModel(model));
+    }
+    
+    return assignedIds;
+}
+
 bool BuildPlate::removeModel(int id) {
     auto it = m_modelsById.find(id);
     if (it != m_modelsById.end()) {
         m_modelsById.erase(it);
+        sweepRemove(id);
+        m_dirtyModels.erase(id);
+        for (auto pair = m_collisionPairs.begin(); pair != m_collisionPairs.end();) {
+            pair = (pair->first == id || pair->second == id) ? m_collisionPairs.erase(pair) : std::next(pair);
+        }
         return true;
     }
     return false;
@@ -47,12 +71,24 @@ bool BuildPlate::removeModel(int id) {
 
 void BuildPlate::clear() {
     m_modelsById.clear();
+    m_sweep.clear();
+    m_sweepWidths.clear();
+    m_collisionPairs.clear();
+    m_dirtyModels.clear();
     m_nextId = 1;
 }
 
-std::shared_ptr<Model> BuildPlate::getModel(int id) {
+bool BuildPlate::setModelTransform(int id, const Transform& transform) {
     auto it = m_modelsById.find(id);
-    return (it != m_modelsById.end()) ? it->second : nullptr;
+    if (it == m_modelsById.end()) {
+        return false;
+    }
+    
+    it->second->setTransform(transform);
+    sweepRemove(id);
+    sweepInsert(id, it->second->worldBounds());
+    m_dirtyModels.insert(id);
+    return true;
 }
 
 std::shared_ptr<const Model> BuildPlate::getModel(int id) const {
@@ -60,15 +96,6 @@ std::shared_ptr<const Model> BuildPlate::getModel(int id) const {
     return (it != m_modelsById.end()) ? it->second : nullptr;  // ? Safe const pointer
 }
 
-std::vector<std::shared_ptr<Model>> BuildPlate::getAllModels() {
-    std::vector<std::shared_ptr<Model>> result;
-    result.reserve(m_modelsById.size());
-    for (auto& pair : m_modelsById) {
-        result.push_back(pair.second);
-    }
-    return result;
-}
-
 std::vector<std::shared_ptr<const Model>> BuildPlate::getAllModels() const {
     std::vector<std::shared_ptr<const Model>> result;
     result.reserve(m_modelsById.size());
@@ -86,6 +113,13 @@ bool BuildPlate::isInsideBuildVolume(const Model& model) const {
         return false;
     }
     
+    // The cylinder is convex, so the part is inside exactly when its
+    // hull is
+    auto hull = model.hull();
+    if (hull && !hull->empty()) {
+        return hull->maxRadius(model.transform()) <= m_radius;
+    }
+    
     // Check if all 8 corners of bounding box are inside cylinder
     double corners[8][3] = {
         {bounds.minX, bounds.minY, bounds.minZ},
@@ -108,24 +142,121 @@ bool BuildPlate::isInsideBuildVolume(const Model& model) const {
 }
 
 bool BuildPlate::hasCollisions() const {
-    return !detectCollisions().empty();
+    std::lock_guard<std::mutex> lock(m_collisionMutex);
+    refreshCollisions();
+    return !m_collisionPairs.empty();
 }
 
 std::vector<std::pair<int, int>> BuildPlate::detectCollisions() const {
-    std::vector<std::pair<int, int>> collisions;
+    std::lock_guard<std::mutex> lock(m_collisionMutex);
+    refreshCollisions();
+    return std::vector<std::pair<int, int>>(m_collisionPairs.begin(), m_collisionPairs.end());
+}
+
+void BuildPlate::refreshCollisions() const {
+    if (m_dirtyModels.empty()) {
+        return;
+    }
+    
+    for (auto pair = m_collisionPairs.begin(); pair != m_collisionPairs.end();) {
+        bool stale = m_dirtyModels.count(pair->first) || m_dirtyModels.count(pair->second);
+        pair = stale ? m_collisionPairs.erase(pair) : std::next(pair);
+    }
     
-    // Build vector of all models for collision detection
-    auto allModels = getAllModels();
+    for (int id : m_dirtyModels) {
+        auto it = m_modelsById.find(id);
+        if (it == m_modelsById.end()) {
+            continue;
+        }
+        const Model& model = *it->second;
+        for (int otherId : sweepNeighbours(model.worldBounds())) {
+            // Pairs of two dirty models are tested from the lower id only
+            if (otherId == id || (otherId < id && m_dirtyModels.count(otherId))) {
+                continue;
+            }
+            if (model.collidesWith(*m_modelsById.at(otherId))) {
+                m_collisionPairs.insert({std::min(id, otherId), std::max(id, otherId)});
+            }
+        }
+    }
+    m_dirtyModels.clear();
+}
+
+std::vector<ModelClearance> BuildPlate::detectClearanceViolations(double minimumClearance) const {
+    std::vector<ModelClearance> violations;
+    if (minimumClearance <= 0.0) {
+        for (const auto& pair : detectCollisions()) {
+            violations.push_back(ModelClearance{pair.first, pair.second, 0.0, true});
+        }
+        return violations;
+    }
     
-    for (size_t i = 0; i < allModels.size(); ++i) {
-        for (size_t j = i + 1; j < allModels.size(); ++j) {
-            if (allModels[i]->collidesWith(*allModels[j])) {
-                collisions.push_back({allModels[i]->id(), allModels[j]->id()});
+    for (const auto& pair : sweepOverlaps(minimumClearance)) {
+        const Model& a = *m_modelsById.at(pair.first);
+        const Model& b = *m_modelsById.at(pair.second);
+        double distance = a.clearanceTo(b, minimumClearance);
+        if (distance >= minimumClearance) {
+            continue;
+        }
+        violations.push_back(ModelClearance{pair.first, pair.second, distance, distance <= 0.0});
+    }
+    return violations;
+}
+
+void BuildPlate::sweepInsert(int id, const BoundingBox& bounds) {
+    auto pos = std::upper_bound(m_sweep.begin(), m_sweep.end(), bounds.minX,
+                                [](double minX, const SweepEntry& entry) { return minX < entry.bounds.minX; });
+    m_sweep.insert(pos, SweepEntry{bounds, id});
+    m_sweepWidths.insert(bounds.maxX - bounds.minX);
+}
+
+void BuildPlate::sweepRemove(int id) {
+    auto it = std::find_if(m_sweep.begin(), m_sweep.end(),
+                           [id](const SweepEntry& entry) { return entry.id == id; });
+    if (it != m_sweep.end()) {
+        // Same expression as on insert, so the width is found exactly
+        auto width = m_sweepWidths.find(it->bounds.maxX - it->bounds.minX);
+        if (width != m_sweepWidths.end()) {
+            m_sweepWidths.erase(width);
+        }
+        m_sweep.erase(it);
+    }
+}
+
+std::vector<std::pair<int, int>> BuildPlate::sweepOverlaps(double margin) const {
+    std::vector<std::pair<int, int>> overlaps;
+    for (size_t i = 0; i < m_sweep.size(); ++i) {
+        BoundingBox a = m_sweep[i].bounds;
+        a.minX -= margin; a.maxX += margin;
+        a.minY -= margin; a.maxY += margin;
+        a.minZ -= margin; a.maxZ += margin;
+        
+        // Later boxes start at or after a; once one starts past a's end,
+        // all the rest do too
+        for (size_t j = i + 1; j < m_sweep.size() && m_sweep[j].bounds.minX <= a.maxX; ++j) {
+            if (!a.intersects(m_sweep[j].bounds)) {
+                continue;
             }
+            overlaps.push_back({std::min(m_sweep[i].id, m_sweep[j].id),
+                                std::max(m_sweep[i].id, m_sweep[j].id)});
         }
     }
+    return overlaps;
+}
+
+std::vector<int> BuildPlate::sweepNeighbours(const BoundingBox& bounds) const {
+    // No box is wider than the widest in the index, so none starting
+    // before this can reach bounds
+    auto it = std::lower_bound(m_sweep.begin(), m_sweep.end(), bounds.minX - sweepMaxWidth(),
+                               [](const SweepEntry& entry, double minX) { return entry.bounds.minX < minX; });
     
-    return collisions;
+    std::vector<int> neighbours;
+    for (; it != m_sweep.end() && it->bounds.minX <= bounds.maxX; ++it) {
+        if (it->bounds.intersects(bounds)) {
+            neighbours.push_back(it->id);
+        }
+    }
+    return neighbours;
 }
 
 void BuildPlate::setDimensions(double radius, double height) {
@@ -2,14 +2,27 @@
 #define BUILDPLATE_H
 
 #include "Model.h"
+#include <set>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 namespace MarcSLM {
 namespace Domain {
 
+/**
+ * @brief Two models closer than a required clearance
+ */
+struct ModelClearance {
+    int first = -1;           // lower id
+    int second = -1;
+    double distance = 0.0;    // 0 when the parts interfere
+    bool interfering = false;
+};
+
 /**
  * @brief Manages the collection of models on the build plate
  * 
@@ -25,6 +38,9 @@ namespace Domain {
  * Build volume is defined as a cylinder:
  * - Radius: horizontal extent (X-Y plane)
  * - Height: vertical extent (Z-axis)
+ * 
+ * Const queries may run concurrently with each other (e.g. the UI and a
+ * worker); changes to the plate must not overlap any other call.
  */
 class BuildPlate {
 public:
@@ -37,21 +53,67 @@ public:
     
     // Model management
     int addModel(const Model& model);
+    
+    /**
+     * @brief Add several models in one pass
+     * 
+     * Same id rules as addModel(); the table is grown once for the whole
+     * batch instead of rehashing as it fills.
+     * @return Assigned ids, in the order of the input
+     */
+    std::vector<int> addModels(const std::vector<Model>& models);
     bool removeModel(int id);
     void clear();
     
+    /**
+     * @brief Move a model and update the collision index
+     * 
+     * The only way to move a model: lookups hand out const models, so
+     * the collision index always sees the change.
+     * @return false if there is no model with this id
+     */
+    bool setModelTransform(int id, const Transform& transform);
+    
     // Queries
-    std::shared_ptr<Model> getModel(int id);
     std::shared_ptr<const Model> getModel(int id) const;
-    std::vector<std::shared_ptr<Model>> getAllModels();
     std::vector<std::shared_ptr<const Model>> getAllModels() const;
     int modelCount() const { return static_cast<int>(m_modelsById.size()); }
     
     // Validation
     bool isInsideBuildVolume(const Model& model) const;
     bool hasCollisions() const;
+    
+    /**
+     * @brief Pairs of models that interfere
+     * 
+     * Broad phase: sweep and prune over the index kept by addModel(),
+     * removeModel() and setModelTransform(): boxes are held sorted by
+     * minimum X, so only pairs that overlap along X are tested further,
+     * which keeps plates of hundreds of small parts close to linear.
+     * 
+     * Narrow phase: pairs whose boxes intersect go through
+     * Model::collidesWith(), triangle against triangle for models with a
+     * collision mesh.
+     * 
+     * Results are cached between calls. Models added or moved since the
+     * last call are marked dirty, and only they are tested again, against
+     * their broad-phase neighbours; so while a part is dragged every call
+     * costs one model's neighbourhood, not the whole plate.
+     * @return Each pair once, lower id first, sorted
+     */
     std::vector<std::pair<int, int>> detectCollisions() const;
     
+    /**
+     * @brief Pairs of models closer than a minimum clearance
+     * 
+     * Same two phases as detectCollisions(), with the boxes grown by the
+     * clearance for the broad phase and Model::clearanceTo() as the
+     * narrow phase.
+     * @param minimumClearance Required gap between parts in millimeters
+     * @return Each pair once, lower id first, interfering pairs included
+     */
+    std::vector<ModelClearance> detectClearanceViolations(double minimumClearance) const;
+    
     // Build volume properties
     double radius() const { return m_radius; }
     double height() const { return m_height; }
@@ -67,7 +129,36 @@ private:
     double m_height;
     int m_nextId = 1;  // Auto-increment ID for new models
     
+    // Broad phase: world bounds of every model, sorted by minX
+    struct SweepEntry {
+        BoundingBox bounds;
+        int id;
+    };
+    std::vector<SweepEntry> m_sweep;
+    std::multiset<double> m_sweepWidths;  // X extent of every box, widest last
+    
+    // Narrow-phase results as of the last query, and the models to test
+    // again before the next one. Refreshed from const queries under
+    // m_collisionMutex.
+    mutable std::mutex m_collisionMutex;
+    mutable std::set<std::pair<int, int>> m_collisionPairs;
+    mutable std::unordered_set<int> m_dirtyModels;
+    
     bool isInsideCylinder(double x, double y, double z) const;
+    void sweepInsert(int id, const BoundingBox& bounds);
+    void sweepRemove(int id);
+    
+    // Pairs whose boxes, grown by margin, intersect; lower id first
+    std::vector<std::pair<int, int>> sweepOverlaps(double margin) const;
+    
+    // Widest box along X currently in the index
+    double sweepMaxWidth() const { return m_sweepWidths.empty() ? 0.0 : *m_sweepWidths.rbegin(); }
+    
+    // Ids of the models whose boxes intersect bounds
+    std::vector<int> sweepNeighbours(const BoundingBox& bounds) const;
+    
+    // Re-test dirty models and update m_collisionPairs; caller holds m_collisionMutex
+    void refreshCollisions() const;
 };
 
 } // namespace Domain
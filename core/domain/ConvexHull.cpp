@@ -0,0 +1,455 @@
+#include "ConvexHull.h"
+#include "Footprint.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+
+namespace MarcSLM {
+namespace Domain {
+
+namespace {
+
+using Point = ConvexHull::Point;
+
+Point sub(const Point& a, const Point& b) {
+    return { a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+}
+
+Point cross(const Point& a, const Point& b) {
+    return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+}
+
+double dot(const Point& a, const Point& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+double length(const Point& a) {
+    return std::sqrt(dot(a, a));
+}
+
+struct HullFace {
+    int v[3];
+    Point normal;             // unit, pointing out
+    double offset = 0.0;      // normal . x on the plane
+    std::vector<int> outside; // points above this face not yet on the hull
+    int farthest = -1;
+    double farthestDistance = 0.0;
+    bool alive = true;
+    unsigned visited = 0;     // iteration that last classified this face
+    bool visible = false;
+};
+
+std::uint64_t edgeKey(int a, int b) {
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(a)) << 32) |
+           static_cast<std::uint32_t>(b);
+}
+
+class QuickHull {
+public:
+    QuickHull(const float* xyz, std::size_t count, double eps)
+        : m_xyz(xyz), m_count(count), m_eps(eps) {}
+
+    Point point(int i) const {
+        const float* p = m_xyz + 3 * static_cast<std::size_t>(i);
+        return { p[0], p[1], p[2] };
+    }
+
+    double distance(const HullFace& f, int i) const {
+        return dot(f.normal, point(i)) - f.offset;
+    }
+
+    // Face a-b-c, flipped if needed so that `inside` lies below it
+    int addFace(int a, int b, int c, const Point& inside) {
+        HullFace f;
+        f.v[0] = a;
+        f.v[1] = b;
+        f.v[2] = c;
+        Point n = cross(sub(point(b), point(a)), sub(point(c), point(a)));
+        if (dot(n, sub(inside, point(a))) > 0.0) {
+            std::swap(f.v[1], f.v[2]);
+            n = { -n[0], -n[1], -n[2] };
+        }
+        return push(f, n);
+    }
+
+    // Face a-b-c as wound (outward already)
+    int addOrientedFace(int a, int b, int c) {
+        HullFace f;
+        f.v[0] = a;
+        f.v[1] = b;
+        f.v[2] = c;
+        return push(f, cross(sub(point(b), point(a)), sub(point(c), point(a))));
+    }
+
+    void assign(int i, const std::vector<int>& candidates) {
+        for (int fi : candidates) {
+            HullFace& f = m_faces[fi];
+            const double d = distance(f, i);
+            if (d > m_eps) {
+                f.outside.push_back(i);
+                if (d > f.farthestDistance) {
+                    f.farthestDistance = d;
+                    f.farthest = i;
+                }
+                return;
+            }
+        }
+    }
+
+    void build(const int initial[4]) {
+        Point centroid = { 0, 0, 0 };
+        for (int k = 0; k < 4; ++k) {
+            const Point p = point(initial[k]);
+            for (int j = 0; j < 3; ++j) centroid[j] += 0.25 * p[j];
+        }
+
+        std::vector<int> faces = {
+            addFace(initial[0], initial[1], initial[2], centroid),
+            addFace(initial[0], initial[1], initial[3], centroid),
+            addFace(initial[0], initial[2], initial[3], centroid),
+            addFace(initial[1], initial[2], initial[3], centroid),
+        };
+        for (std::size_t i = 0; i < m_count; ++i) {
+            const int index = static_cast<int>(i);
+            if (index == initial[0] || index == initial[1] || index == initial[2] || index == initial[3]) {
+                continue;
+            }
+            assign(index, faces);
+        }
+
+        // Faces with points outside them, until there are none
+        std::vector<int> pending(faces.rbegin(), faces.rend());
+        while (!pending.empty()) {
+            const int fi = pending.back();
+            pending.pop_back();
+            if (m_faces[fi].alive && m_faces[fi].farthest >= 0) {
+                addPoint(fi, pending);
+            }
+        }
+    }
+
+    void collect(std::vector<Point>& vertices, std::vector<ConvexHull::Face>& faces) const {
+        std::unordered_map<int, int> remap;
+        for (const HullFace& f : m_faces) {
+            if (!f.alive) continue;
+            ConvexHull::Face face;
+            for (int k = 0; k < 3; ++k) {
+                auto it = remap.find(f.v[k]);
+                if (it == remap.end()) {
+                    it = remap.emplace(f.v[k], static_cast<int>(vertices.size())).first;
+                    vertices.push_back(point(f.v[k]));
+                }
+                face[k] = it->second;
+            }
+            faces.push_back(face);
+        }
+    }
+
+private:
+    const float* m_xyz;
+    std::size_t m_count;
+    double m_eps;
+    std::vector<HullFace> m_faces;
+    std::unordered_map<std::uint64_t, int> m_edges;  // directed edge -> face
+    unsigned m_iteration = 0;
+
+    int push(HullFace& f, const Point& n) {
+        const double len = length(n);
+        f.normal = len > 0.0 ? Point{ n[0] / len, n[1] / len, n[2] / len } : Point{ 0, 0, 0 };
+        f.offset = dot(f.normal, point(f.v[0]));
+        const int index = static_cast<int>(m_faces.size());
+        m_faces.push_back(std::move(f));
+        for (int k = 0; k < 3; ++k) {
+            const HullFace& g = m_faces.back();
+            m_edges[edgeKey(g.v[k], g.v[(k + 1) % 3])] = index;
+        }
+        return index;
+    }
+
+    // Add the farthest outside point of face start to the hull; faces
+    // created for it are queued on pending
+    void addPoint(int start, std::vector<int>& pending) {
+        const int eye = m_faces[start].farthest;
+        const Point eyePoint = point(eye);
+        ++m_iteration;
+
+        // Faces the eye can see, flood-filled from start; edges between a
+        // visible and a hidden face form the horizon
+        std::vector<int> visible = { start };
+        std::vector<std::pair<int, int>> horizon;
+        m_faces[start].visited = m_iteration;
+        m_faces[start].visible = true;
+        for (std::size_t k = 0; k < visible.size(); ++k) {
+            const int fi = visible[k];
+            for (int e = 0; e < 3; ++e) {
+                const int a = m_faces[fi].v[e];
+                const int b = m_faces[fi].v[(e + 1) % 3];
+                auto it = m_edges.find(edgeKey(b, a));
+                if (it == m_edges.end()) continue;
+                HullFace& nb = m_faces[it->second];
+                if (nb.visited != m_iteration) {
+                    nb.visited = m_iteration;
+                    nb.visible = dot(nb.normal, eyePoint) - nb.offset > m_eps;
+                    if (nb.visible) {
+                        visible.push_back(it->second);
+                    }
+                }
+                if (!nb.visible) {
+                    horizon.emplace_back(a, b);
+                }
+            }
+        }
+
+        std::vector<int> orphans;
+        for (int fi : visible) {
+            HullFace& f = m_faces[fi];
+            f.alive = false;
+            for (int e = 0; e < 3; ++e) {
+                auto it = m_edges.find(edgeKey(f.v[e], f.v[(e + 1) % 3]));
+                if (it != m_edges.end() && it->second == fi) {
+                    m_edges.erase(it);
+                }
+            }
+            for (int i : f.outside) {
+                if (i != eye) orphans.push_back(i);
+            }
+            std::vector<int>().swap(f.outside);
+        }
+
+        std::vector<int> created;
+        created.reserve(horizon.size());
+        for (const auto& edge : horizon) {
+            created.push_back(addOrientedFace(edge.first, edge.second, eye));
+        }
+        for (int i : orphans) {
+            assign(i, created);
+        }
+        pending.insert(pending.end(), created.begin(), created.end());
+    }
+};
+
+} // namespace
+
+ConvexHull ConvexHull::compute(const float* xyz, std::size_t count) {
+    ConvexHull hull;
+    if (!xyz || count == 0) {
+        return hull;
+    }
+    auto point = [xyz](std::size_t i) -> Point {
+        return { xyz[3 * i], xyz[3 * i + 1], xyz[3 * i + 2] };
+    };
+
+    // Extreme points along the axes
+    std::size_t extreme[6] = { 0, 0, 0, 0, 0, 0 };
+    double scale = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        for (int a = 0; a < 3; ++a) {
+            if (xyz[3 * i + a] < xyz[3 * extreme[2 * a] + a]) extreme[2 * a] = i;
+            if (xyz[3 * i + a] > xyz[3 * extreme[2 * a + 1] + a]) extreme[2 * a + 1] = i;
+            scale = std::max(scale, static_cast<double>(std::fabs(xyz[3 * i + a])));
+        }
+    }
+    const double eps = std::max(scale, 1.0) * 1e-9;
+
+    // Initial simplex: the two farthest extremes, the point farthest from
+    // their line and the point farthest from their plane
+    std::size_t p0 = extreme[0], p1 = extreme[1];
+    double farthest = -1.0;
+    for (int i = 0; i < 6; ++i) {
+        for (int j = i + 1; j < 6; ++j) {
+            const double d = length(sub(point(extreme[i]), point(extreme[j])));
+            if (d > farthest) {
+                farthest = d;
+                p0 = extreme[i];
+                p1 = extreme[j];
+            }
+        }
+    }
+    if (farthest <= eps) {
+        hull.m_vertices.push_back(point(p0));
+        return hull;
+    }
+
+    const Point axis = sub(point(p1), point(p0));
+    std::size_t p2 = p0;
+    farthest = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double d = length(cross(axis, sub(point(i), point(p0)))) / length(axis);
+        if (d > farthest) {
+            farthest = d;
+            p2 = i;
+        }
+    }
+    if (farthest <= eps) {
+        hull.m_vertices = { point(p0), point(p1) };
+        return hull;
+    }
+
+    Point normal = cross(axis, sub(point(p2), point(p0)));
+    const double normalLength = length(normal);
+    normal = { normal[0] / normalLength, normal[1] / normalLength, normal[2] / normalLength };
+    std::size_t p3 = p0;
+    farthest = 0.0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const double d = std::fabs(dot(normal, sub(point(i), point(p0))));
+        if (d > farthest) {
+            farthest = d;
+            p3 = i;
+        }
+    }
+
+    if (farthest <= eps) {
+        // Flat: outline in the plane
+        const double axisLength = length(axis);
+        const Point e1 = { axis[0] / axisLength, axis[1] / axisLength, axis[2] / axisLength };
+        const Point e2 = cross(normal, e1);
+        const Point origin = point(p0);
+        std::vector<Point2> flat(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const Point d = sub(point(i), origin);
+            flat[i] = { dot(d, e1), dot(d, e2) };
+        }
+        for (const Point2& q : Footprint::convexHull(std::move(flat))) {
+            hull.m_vertices.push_back({ origin[0] + q.x * e1[0] + q.y * e2[0],
+                                        origin[1] + q.x * e1[1] + q.y * e2[1],
+                                        origin[2] + q.x * e1[2] + q.y * e2[2] });
+        }
+        return hull;
+    }
+
+    QuickHull builder(xyz, count, eps);
+    const int initial[4] = { static_cast<int>(p0), static_cast<int>(p1),
+                             static_cast<int>(p2), static_cast<int>(p3) };
+    builder.build(initial);
+    builder.collect(hull.m_vertices, hull.m_faces);
+    return hull;
+}
+
+void ConvexHull::extent(const double direction[3], double& lowest, double& highest) const {
+    lowest = std::numeric_limits<double>::max();
+    highest = std::numeric_limits<double>::lowest();
+    for (const Point& v : m_vertices) {
+        const double h = v[0] * direction[0] + v[1] * direction[1] + v[2] * direction[2];
+        lowest = std::min(lowest, h);
+        highest = std::max(highest, h);
+    }
+    if (m_vertices.empty()) {
+        lowest = highest = 0.0;
+    }
+}
+
+std::vector<ConvexHull::RestingPose> ConvexHull::restingPoses(const Point& centerOfMass,
+                                                             double angleToleranceRadians) const {
+    std::vector<RestingPose> poses;
+    const std::size_t n = m_faces.size();
+    if (n == 0) {
+        return poses;
+    }
+
+    std::vector<Point> normals(n);
+    std::vector<double> areas(n);
+    std::unordered_map<std::uint64_t, int> edges;  // directed edge -> face
+    for (std::size_t f = 0; f < n; ++f) {
+        const Face& face = m_faces[f];
+        const Point c = cross(sub(m_vertices[face[1]], m_vertices[face[0]]),
+                              sub(m_vertices[face[2]], m_vertices[face[0]]));
+        const double len = length(c);
+        areas[f] = 0.5 * len;
+        normals[f] = len > 0.0 ? Point{ c[0] / len, c[1] / len, c[2] / len } : Point{ 0, 0, 0 };
+        for (int k = 0; k < 3; ++k) {
+            edges[edgeKey(face[k], face[(k + 1) % 3])] = static_cast<int>(f);
+        }
+    }
+
+    // Flood-fill facets from each unassigned face; slivers without a
+    // normal join whichever facet reaches them first
+    const double cosTolerance = std::cos(angleToleranceRadians);
+    std::vector<char> assigned(n, 0);
+    std::vector<int> members;
+    for (std::size_t seed = 0; seed < n; ++seed) {
+        if (assigned[seed] || areas[seed] <= 0.0) continue;
+
+        members.assign(1, static_cast<int>(seed));
+        assigned[seed] = 1;
+        Point normal = { 0, 0, 0 };
+        double area = 0.0;
+        for (std::size_t k = 0; k < members.size(); ++k) {
+            const int f = members[k];
+            for (int j = 0; j < 3; ++j) {
+                normal[j] += areas[f] * normals[f][j];
+            }
+            area += areas[f];
+            for (int e = 0; e < 3; ++e) {
+                auto it = edges.find(edgeKey(m_faces[f][(e + 1) % 3], m_faces[f][e]));
+                if (it == edges.end() || assigned[it->second]) continue;
+                const int g = it->second;
+                if (areas[g] <= 0.0 || dot(normals[g], normals[seed]) >= cosTolerance) {
+                    assigned[g] = 1;
+                    members.push_back(g);
+                }
+            }
+        }
+        const double normalLength = length(normal);
+        if (normalLength <= 0.0) continue;
+        normal = { normal[0] / normalLength, normal[1] / normalLength, normal[2] / normalLength };
+
+        // Stable when the centre of mass projects into one of the facet's
+        // triangles; the edge tests ignore the offset along the normal
+        bool stable = false;
+        for (int f : members) {
+            const Face& face = m_faces[f];
+            bool inside = true;
+            for (int e = 0; e < 3 && inside; ++e) {
+                const Point& a = m_vertices[face[e]];
+                const Point& b = m_vertices[face[(e + 1) % 3]];
+                const Point ab = sub(b, a);
+                const Point ap = sub(centerOfMass, a);
+                inside = dot(cross(ab, ap), normal) >= -1e-9 * length(ab) * length(ap);
+            }
+            if (inside) {
+                stable = true;
+                break;
+            }
+        }
+        if (stable) {
+            poses.push_back({ normal, area });
+        }
+    }
+
+    std::stable_sort(poses.begin(), poses.end(), [](const RestingPose& a, const RestingPose& b) {
+        return a.contactArea > b.contactArea;
+    });
+    return poses;
+}
+
+ConvexHull::Point ConvexHull::centroid() const {
+    Point mean = { 0, 0, 0 };
+    if (m_vertices.empty()) {
+        return mean;
+    }
+    for (const Point& v : m_vertices) {
+        for (int k = 0; k < 3; ++k) mean[k] += v[k] / static_cast<double>(m_vertices.size());
+    }
+
+    // Tetrahedra from an interior point to every face
+    Point weighted = { 0, 0, 0 };
+    double volume = 0.0;
+    for (const Face& f : m_faces) {
+        const Point a = sub(m_vertices[f[0]], mean);
+        const Point b = sub(m_vertices[f[1]], mean);
+        const Point c = sub(m_vertices[f[2]], mean);
+        const double v = dot(a, cross(b, c)) / 6.0;
+        volume += v;
+        for (int k = 0; k < 3; ++k) weighted[k] += v * (a[k] + b[k] + c[k]) / 4.0;
+    }
+    if (volume <= 0.0) {
+        return mean;
+    }
+    return { mean[0] + weighted[0] / volume, mean[1] + weighted[1] / volume, mean[2] + weighted[2] / volume };
+}
+
+} // namespace Domain
+} // namespace MarcSLM
@@ -0,0 +1,79 @@
+#ifndef CONVEXHULL_H
+#define CONVEXHULL_H
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace MarcSLM {
+namespace Domain {
+
+/**
+ * @brief Convex hull of a point cloud (quickhull)
+ *
+ * A part's extent in any direction - its build height for an orientation,
+ * its footprint, whether it fits the build cylinder - only depends on the
+ * hull vertices, usually a few hundred even for multi-million facet meshes.
+ *
+ * Faces are triangles wound counter-clockwise seen from outside. Flat or
+ * collinear input has no faces; vertices() then still holds every point
+ * that is extreme in some direction, so extents remain exact.
+ */
+class ConvexHull {
+public:
+    using Point = std::array<double, 3>;
+    using Face = std::array<int, 3>;
+
+    ConvexHull() = default;
+
+    /// Hull of count points stored as consecutive xyz triples
+    static ConvexHull compute(const float* xyz, std::size_t count);
+    static ConvexHull compute(const std::vector<float>& xyz) { return compute(xyz.data(), xyz.size() / 3); }
+
+    const std::vector<Point>& vertices() const { return m_vertices; }
+    const std::vector<Face>& faces() const { return m_faces; }
+
+    bool empty() const { return m_vertices.empty(); }
+
+    /// True for flat, collinear or single-point input (no faces)
+    bool isDegenerate() const { return m_faces.empty(); }
+
+    /**
+     * @brief Lowest and highest vertex along a direction
+     * @param direction Unit vector
+     */
+    void extent(const double direction[3], double& lowest, double& highest) const;
+
+    /**
+     * @brief A way the part can rest on a flat plate
+     */
+    struct RestingPose {
+        Point down;                // unit outward normal of the contact facet
+        double contactArea = 0.0;  // area of the facet on the plate
+    };
+
+    /**
+     * @brief Stable resting poses on hull facets, largest contact first
+     *
+     * Adjacent faces whose normals are within angleTolerance of a facet's
+     * first face are merged into one facet. A facet is a stable pose when
+     * the centre of mass, projected along its normal, falls inside it.
+     * Degenerate hulls have none.
+     *
+     * @param angleToleranceRadians Coplanarity tolerance for merging faces
+     */
+    std::vector<RestingPose> restingPoses(const Point& centerOfMass,
+                                          double angleToleranceRadians = 0.01) const;
+
+    /// Centroid of the solid hull (vertex mean when degenerate)
+    Point centroid() const;
+
+private:
+    std::vector<Point> m_vertices;
+    std::vector<Face> m_faces;
+};
+
+} // namespace Domain
+} // namespace MarcSLM
+
+#endif // CONVEXHULL_H
@@ -0,0 +1,245 @@
+#include "FaceNormals.h"
+
+#include <algorithm>
+#include <cmath>
+
+// SSE2 is part of every x86-64 target; other platforms use the scalar loop
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MARC_FACENORMALS_SSE2 1
+#else
+#define MARC_FACENORMALS_SSE2 0
+#endif
+
+namespace MarcSLM {
+namespace Domain {
+
+namespace {
+
+// Partial sums are kept in float per block (one SIMD register) and folded
+// into a double, which keeps the total accurate for multi-million face meshes.
+constexpr std::size_t SumBlock = 4096;
+
+// Axis-aligned faces of machined parts often sit exactly on the threshold
+// for round candidate angles (e.g. a vertical wall at 45 degrees). Float
+// rounding would put them on either side at random; the tolerance counts
+// them as self-supporting, which is what exact arithmetic gives.
+constexpr double ThresholdTolerance = 1e-5;
+
+} // namespace
+
+void FaceNormals::reserve(std::size_t faces) {
+    nx.reserve(faces);
+    ny.reserve(faces);
+    nz.reserve(faces);
+    area.reserve(faces);
+    cx.reserve(faces);
+    cy.reserve(faces);
+    cz.reserve(faces);
+}
+
+void FaceNormals::addTriangle(const double a[3], const double b[3], const double c[3]) {
+    const double ux = b[0] - a[0], uy = b[1] - a[1], uz = b[2] - a[2];
+    const double vx = c[0] - a[0], vy = c[1] - a[1], vz = c[2] - a[2];
+    const double wx = uy * vz - uz * vy;
+    const double wy = uz * vx - ux * vz;
+    const double wz = ux * vy - uy * vx;
+    const double len = std::sqrt(wx * wx + wy * wy + wz * wz);
+
+    if (len > 0.0) {
+        nx.push_back(static_cast<float>(wx / len));
+        ny.push_back(static_cast<float>(wy / len));
+        nz.push_back(static_cast<float>(wz / len));
+    } else {
+        nx.push_back(0.0f);
+        ny.push_back(0.0f);
+        nz.push_back(0.0f);
+    }
+    area.push_back(static_cast<float>(0.5 * len));
+    totalArea += 0.5 * len;
+
+    cx.push_back(static_cast<float>((a[0] + b[0] + c[0]) / 3.0 - origin[0]));
+    cy.push_back(static_cast<float>((a[1] + b[1] + c[1]) / 3.0 - origin[1]));
+    cz.push_back(static_cast<float>((a[2] + b[2] + c[2]) / 3.0 - origin[2]));
+}
+
+double FaceNormals::criticalArea() const {
+    double total = 0.0;
+    for (std::size_t i = 0; i < critical.size() && i < area.size(); ++i) {
+        total += static_cast<double>(critical[i]) * area[i];
+    }
+    return total;
+}
+
+FaceNormals FaceNormals::fromMesh(const TriangleMesh& mesh) {
+    FaceNormals faces;
+    const std::size_t count = mesh.triangleCount();
+    faces.reserve(count);
+
+    // Centroids relative to the middle of the bounds
+    if (mesh.vertexCount() > 0) {
+        float lo[3] = { mesh.vertices[0], mesh.vertices[1], mesh.vertices[2] };
+        float hi[3] = { lo[0], lo[1], lo[2] };
+        for (std::size_t v = 0; v < mesh.vertices.size(); v += 3) {
+            for (int k = 0; k < 3; ++k) {
+                lo[k] = std::min(lo[k], mesh.vertices[v + k]);
+                hi[k] = std::max(hi[k], mesh.vertices[v + k]);
+            }
+        }
+        for (int k = 0; k < 3; ++k) {
+            faces.origin[k] = 0.5 * (static_cast<double>(lo[k]) + hi[k]);
+        }
+    }
+
+    for (std::size_t t = 0; t < count; ++t) {
+        double corner[3][3];
+        for (int k = 0; k < 3; ++k) {
+            const float* v = mesh.vertices.data() + 3 * static_cast<std::size_t>(mesh.indices[3 * t + k]);
+            corner[k][0] = v[0];
+            corner[k][1] = v[1];
+            corner[k][2] = v[2];
+        }
+        faces.addTriangle(corner[0], corner[1], corner[2]);
+    }
+    return faces;
+}
+
+double FaceNormals::supportArea(const double up[3], double cosThreshold) const {
+    const float ux = static_cast<float>(up[0]);
+    const float uy = static_cast<float>(up[1]);
+    const float uz = static_cast<float>(up[2]);
+    const float limit = static_cast<float>(cosThreshold - ThresholdTolerance);
+
+    const float* x = nx.data();
+    const float* y = ny.data();
+    const float* z = nz.data();
+    const float* a = area.data();
+    const std::size_t count = size();
+
+    double total = 0.0;
+    std::size_t i = 0;
+
+#if MARC_FACENORMALS_SSE2
+    // Four faces per step: dot product, compare to a lane mask, and keep
+    // the area where the mask is set. No branches, no gathers.
+    const __m128 vx = _mm_set1_ps(ux);
+    const __m128 vy = _mm_set1_ps(uy);
+    const __m128 vz = _mm_set1_ps(uz);
+    const __m128 vlimit = _mm_set1_ps(limit);
+    const std::size_t vectorEnd = count - count % 4;
+    while (i < vectorEnd) {
+        const std::size_t blockEnd = std::min(i + SumBlock, vectorEnd);
+        __m128 sum = _mm_setzero_ps();
+        for (; i < blockEnd; i += 4) {
+            __m128 d = _mm_mul_ps(_mm_loadu_ps(x + i), vx);
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(y + i), vy));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(z + i), vz));
+            const __m128 mask = _mm_cmplt_ps(d, vlimit);
+            sum = _mm_add_ps(sum, _mm_and_ps(mask, _mm_loadu_ps(a + i)));
+        }
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, sum);
+        total += static_cast<double>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const float d = x[i] * ux + y[i] * uy + z[i] * uz;
+        total += (d < limit) ? a[i] : 0.0f;
+    }
+    return total;
+}
+
+namespace {
+
+template <bool WithCritical>
+SupportTerms fusedSupportTerms(const FaceNormals& faces, const double up[3],
+                               double cosThreshold, double plateHeight) {
+    const float ux = static_cast<float>(up[0]);
+    const float uy = static_cast<float>(up[1]);
+    const float uz = static_cast<float>(up[2]);
+    const float limit = static_cast<float>(cosThreshold - ThresholdTolerance);
+    const float plate = static_cast<float>(plateHeight);
+
+    const float* x = faces.nx.data();
+    const float* y = faces.ny.data();
+    const float* z = faces.nz.data();
+    const float* a = faces.area.data();
+    const float* px = faces.cx.data();
+    const float* py = faces.cy.data();
+    const float* pz = faces.cz.data();
+    const float* k = WithCritical ? faces.critical.data() : nullptr;
+    const std::size_t count = faces.size();
+
+    SupportTerms terms;
+    std::size_t i = 0;
+
+#if MARC_FACENORMALS_SSE2
+    const __m128 vx = _mm_set1_ps(ux);
+    const __m128 vy = _mm_set1_ps(uy);
+    const __m128 vz = _mm_set1_ps(uz);
+    const __m128 vlimit = _mm_set1_ps(limit);
+    const __m128 vplate = _mm_set1_ps(plate);
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const std::size_t vectorEnd = count - count % 4;
+    while (i < vectorEnd) {
+        const std::size_t blockEnd = std::min(i + SumBlock, vectorEnd);
+        __m128 areaSum = _mm_setzero_ps();
+        __m128 volumeSum = _mm_setzero_ps();
+        __m128 criticalSum = _mm_setzero_ps();
+        for (; i < blockEnd; i += 4) {
+            __m128 d = _mm_mul_ps(_mm_loadu_ps(x + i), vx);
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(y + i), vy));
+            d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(z + i), vz));
+            const __m128 mask = _mm_cmplt_ps(d, vlimit);
+            const __m128 faceArea = _mm_and_ps(mask, _mm_loadu_ps(a + i));
+            areaSum = _mm_add_ps(areaSum, faceArea);
+
+            __m128 h = _mm_mul_ps(_mm_loadu_ps(px + i), vx);
+            h = _mm_add_ps(h, _mm_mul_ps(_mm_loadu_ps(py + i), vy));
+            h = _mm_add_ps(h, _mm_mul_ps(_mm_loadu_ps(pz + i), vz));
+            h = _mm_sub_ps(h, vplate);
+            const __m128 shadow = _mm_mul_ps(faceArea, _mm_and_ps(d, absMask));
+            volumeSum = _mm_add_ps(volumeSum, _mm_mul_ps(shadow, h));
+
+            if constexpr (WithCritical) {
+                criticalSum = _mm_add_ps(criticalSum, _mm_mul_ps(faceArea, _mm_loadu_ps(k + i)));
+            }
+        }
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, areaSum);
+        terms.supportArea += static_cast<double>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+        _mm_store_ps(lanes, volumeSum);
+        terms.supportVolume += static_cast<double>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+        if constexpr (WithCritical) {
+            _mm_store_ps(lanes, criticalSum);
+            terms.criticalArea += static_cast<double>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const float d = x[i] * ux + y[i] * uy + z[i] * uz;
+        if (!(d < limit)) continue;
+        const float h = px[i] * ux + py[i] * uy + pz[i] * uz - plate;
+        terms.supportArea += a[i];
+        terms.supportVolume += static_cast<double>(a[i]) * std::fabs(d) * h;
+        if constexpr (WithCritical) {
+            terms.criticalArea += static_cast<double>(a[i]) * k[i];
+        }
+    }
+    return terms;
+}
+
+} // namespace
+
+SupportTerms FaceNormals::supportTerms(const double up[3], double cosThreshold, double plateHeight) const {
+    // Two instantiations keep the critical-face load out of the common loop
+    if (!critical.empty() && critical.size() == size()) {
+        return fusedSupportTerms<true>(*this, up, cosThreshold, plateHeight);
+    }
+    return fusedSupportTerms<false>(*this, up, cosThreshold, plateHeight);
+}
+
+} // namespace Domain
+} // namespace MarcSLM
@@ -0,0 +1,93 @@
+#ifndef FACENORMALS_H
+#define FACENORMALS_H
+
+#include "TriangleMesh.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace MarcSLM {
+namespace Domain {
+
+/**
+ * @brief Support terms of one build direction, from one pass over the faces
+ */
+struct SupportTerms {
+    double supportArea = 0.0;    // area of faces that need support
+    double supportVolume = 0.0;  // their area projected on the plate times their height above it
+    double criticalArea = 0.0;   // area of critical faces that need support
+};
+
+/**
+ * @brief Unit normals, areas and centroids of a mesh's triangles
+ *
+ * Everything orientation scoring needs from a mesh, computed once and
+ * stored as structure-of-arrays so that scoring a candidate orientation is
+ * a single streaming pass: a rotation only changes which direction is
+ * "up", so the rotated normal's z component is one dot product with that
+ * direction and the mesh itself is never transformed.
+ *
+ * Normals follow the triangle winding (right-hand rule), as STL expects.
+ * Centroids are stored relative to origin, which keeps them small enough
+ * for float arithmetic wherever the part sits.
+ */
+struct FaceNormals {
+    std::vector<float> nx;
+    std::vector<float> ny;
+    std::vector<float> nz;
+    std::vector<float> area;
+    std::vector<float> cx;
+    std::vector<float> cy;
+    std::vector<float> cz;
+    std::vector<float> critical;  // empty, or per face 1 for faces to keep support-free
+    double origin[3] = { 0.0, 0.0, 0.0 };
+    double totalArea = 0.0;
+
+    std::size_t size() const { return area.size(); }
+    bool empty() const { return area.empty(); }
+
+    void reserve(std::size_t faces);
+
+    /**
+     * @brief Append one triangle given by its corners
+     *
+     * Degenerate triangles get a zero normal and zero area, so they never
+     * contribute to a score. Set origin before adding triangles.
+     */
+    void addTriangle(const double a[3], const double b[3], const double c[3]);
+
+    /// Total area of the critical faces
+    double criticalArea() const;
+
+    static FaceNormals fromMesh(const TriangleMesh& mesh);
+
+    /**
+     * @brief Total area of faces that need support for a build direction
+     *
+     * A face needs support when its normal, measured against the build
+     * direction, satisfies n . up < cosThreshold; faces within 1e-5 of the
+     * threshold count as self-supporting. The loop is branchless SIMD over
+     * contiguous floats (scalar where SSE2 is unavailable).
+     *
+     * @param up Unit build direction (+Z of the build frame) in mesh coordinates
+     * @param cosThreshold Cosine of the overhang threshold angle
+     */
+    double supportArea(const double up[3], double cosThreshold) const;
+
+    /**
+     * @brief Support area, support volume and critical area in one pass
+     *
+     * Same classification as supportArea(). A supported face adds its area
+     * times |n . up| (its shadow on the plate) times the height of its
+     * centroid above the plate to the volume.
+     *
+     * @param plateHeight Height of the plate along up, relative to origin
+     *        (the lowest point of the part)
+     */
+    SupportTerms supportTerms(const double up[3], double cosThreshold, double plateHeight) const;
+};
+
+} // namespace Domain
+} // namespace MarcSLM
+
+#endif // FACENORMALS_H
@@ -0,0 +1,155 @@
+#include "Footprint.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace MarcSLM {
+namespace Domain {
+
+namespace {
+
+constexpr double Pi = 3.14159265358979323846;
+
+double cross(const Point2& o, const Point2& a, const Point2& b) {
+    return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+// Drop points strictly inside the polygon of the extreme points in eight
+// directions (Akl-Toussaint). The hull is unchanged.
+void discardInterior(std::vector<Point2>& points) {
+    // Directions at 0, 45, ..., 315 degrees, i.e. counter-clockwise
+    static const double dirs[8][2] = {
+        { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 }, { -1, -1 }, { 0, -1 }, { 1, -1 },
+    };
+    std::array<Point2, 8> extreme;
+    std::array<double, 8> best;
+    best.fill(-INFINITY);
+    for (const Point2& p : points) {
+        for (int k = 0; k < 8; ++k) {
+            const double d = p.x * dirs[k][0] + p.y * dirs[k][1];
+            if (d > best[k]) {
+                best[k] = d;
+                extreme[k] = p;
+            }
+        }
+    }
+
+    std::vector<Point2> polygon;
+    for (const Point2& p : extreme) {
+        if (polygon.empty() || p.x != polygon.back().x || p.y != polygon.back().y) {
+            polygon.push_back(p);
+        }
+    }
+    while (polygon.size() > 1 && polygon.front().x == polygon.back().x &&
+           polygon.front().y == polygon.back().y) {
+        polygon.pop_back();
+    }
+    if (polygon.size() < 3) {
+        return;
+    }
+
+    auto inside = [&polygon](const Point2& p) {
+        for (std::size_t k = 0; k < polygon.size(); ++k) {
+            const Point2& a = polygon[k];
+            const Point2& b = polygon[(k + 1) % polygon.size()];
+            if (cross(a, b, p) <= 0.0) {
+                return false;
+            }
+        }
+        return true;
+    };
+    points.erase(std::remove_if(points.begin(), points.end(), inside), points.end());
+}
+
+} // namespace
+
+std::vector<Point2> Footprint::convexHull(std::vector<Point2> points) {
+    discardInterior(points);
+
+    std::sort(points.begin(), points.end(), [](const Point2& a, const Point2& b) {
+        return a.x < b.x || (a.x == b.x && a.y < b.y);
+    });
+    points.erase(std::unique(points.begin(), points.end(), [](const Point2& a, const Point2& b) {
+        return a.x == b.x && a.y == b.y;
+    }), points.end());
+    if (points.size() < 3) {
+        return points;
+    }
+
+    // Lower then upper chain; collinear points are dropped
+    std::vector<Point2> hull(2 * points.size());
+    std::size_t k = 0;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.0) --k;
+        hull[k++] = points[i];
+    }
+    for (std::size_t i = points.size() - 1, lower = k + 1; i > 0; --i) {
+        while (k >= lower && cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0.0) --k;
+        hull[k++] = points[i - 1];
+    }
+    hull.resize(k - 1);
+    return hull;
+}
+
+FootprintRectangle Footprint::minimumAreaRectangle(const std::vector<Point2>& hull) {
+    FootprintRectangle best;
+    const std::size_t n = hull.size();
+    if (n < 2) {
+        return best;
+    }
+    if (n == 2) {
+        best.angle = std::atan2(hull[1].y - hull[0].y, hull[1].x - hull[0].x);
+        best.width = std::hypot(hull[1].x - hull[0].x, hull[1].y - hull[0].y);
+    } else {
+        auto along = [&hull](std::size_t i, double ex, double ey) {
+            return hull[i % hull.size()].x * ex + hull[i % hull.size()].y * ey;
+        };
+
+        // Calipers: farthest point ahead along the edge, farthest across it
+        // (the hull lies to the left of each edge) and farthest behind.
+        // All three only move forward as the edge turns.
+        std::size_t ahead = 1, across = 1, behind = 1;
+        double bestArea = INFINITY;
+        for (std::size_t i = 0; i < n; ++i) {
+            const Point2& a = hull[i];
+            const Point2& b = hull[(i + 1) % n];
+            const double len = std::hypot(b.x - a.x, b.y - a.y);
+            const double ex = (b.x - a.x) / len, ey = (b.y - a.y) / len;
+            const double nx = -ey, ny = ex;
+
+            if (i == 0) {
+                ahead = across = 1;
+            }
+            for (std::size_t s = 0; s < n && along(ahead + 1, ex, ey) > along(ahead, ex, ey); ++s) ++ahead;
+            if (across < ahead) across = ahead;
+            for (std::size_t s = 0; s < n && along(across + 1, nx, ny) > along(across, nx, ny); ++s) ++across;
+            if (i == 0) behind = across;
+            if (behind < across) behind = across;
+            for (std::size_t s = 0; s < n && along(behind + 1, ex, ey) < along(behind, ex, ey); ++s) ++behind;
+
+            const double width = along(ahead, ex, ey) - along(behind, ex, ey);
+            const double depth = along(across, nx, ny) - (a.x * nx + a.y * ny);
+            if (width * depth < bestArea) {
+                bestArea = width * depth;
+                best.angle = std::atan2(ey, ex);
+                best.width = width;
+                best.depth = depth;
+            }
+        }
+    }
+
+    // A rectangle looks the same every quarter turn; report the smallest turn
+    while (best.angle > Pi / 4) {
+        best.angle -= Pi / 2;
+        std::swap(best.width, best.depth);
+    }
+    while (best.angle < -Pi / 4) {
+        best.angle += Pi / 2;
+        std::swap(best.width, best.depth);
+    }
+    return best;
+}
+
+} // namespace Domain
+} // namespace MarcSLM
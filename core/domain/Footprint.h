@@ -0,0 +1,59 @@
+#ifndef FOOTPRINT_H
+#define FOOTPRINT_H
+
+#include <vector>
+
+namespace MarcSLM {
+namespace Domain {
+
+/**
+ * @brief A point in the build plate plane, in millimeters
+ */
+struct Point2 {
+    double x = 0.0;
+    double y = 0.0;
+};
+
+/**
+ * @brief Smallest-area rectangle enclosing a part's outline on the plate
+ *
+ * The rectangle's first side points along angle (radians, counter-clockwise
+ * from +X, in [-pi/4, pi/4]); width is measured along that side and depth
+ * across it. Rotating the part by -angle about Z aligns the rectangle with
+ * the plate axes.
+ */
+struct FootprintRectangle {
+    double angle = 0.0;
+    double width = 0.0;
+    double depth = 0.0;
+
+    double area() const { return width * depth; }
+};
+
+/**
+ * @brief Outline of a part projected onto the build plate
+ */
+class Footprint {
+public:
+    /**
+     * @brief Convex hull, counter-clockwise, without collinear points
+     *
+     * Monotone chain after discarding the points inside the octagon of
+     * extreme points, which for dense meshes removes nearly all of them
+     * before sorting.
+     */
+    static std::vector<Point2> convexHull(std::vector<Point2> points);
+
+    /**
+     * @brief Smallest-area enclosing rectangle of a convex hull
+     *
+     * Rotating calipers: one side of the optimal rectangle lies on a hull
+     * edge, so each edge is tried once, in O(hull size) overall.
+     */
+    static FootprintRectangle minimumAreaRectangle(const std::vector<Point2>& hull);
+};
+
+} // namespace Domain
+} // namespace MarcSLM
+
+#endif // FOOTPRINT_H
@@ -0,0 +1,156 @@
+#include "HullVertices.h"
+#include "ConvexHull.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+
+// SSE2 is part of every x86-64 target; other platforms use the scalar loop
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MARC_HULLVERTICES_SSE2 1
+#else
+#define MARC_HULLVERTICES_SSE2 0
+#endif
+
+namespace MarcSLM {
+namespace Domain {
+
+HullVertices HullVertices::fromMesh(const TriangleMesh& mesh) {
+    HullVertices hull;
+    const ConvexHull convex = ConvexHull::compute(mesh.vertices);
+    hull.x.reserve(convex.vertices().size());
+    hull.y.reserve(convex.vertices().size());
+    hull.z.reserve(convex.vertices().size());
+
+    // Hull vertices are input points, so the floats come back unchanged
+    for (const ConvexHull::Point& p : convex.vertices()) {
+        hull.x.push_back(static_cast<float>(p[0]));
+        hull.y.push_back(static_cast<float>(p[1]));
+        hull.z.push_back(static_cast<float>(p[2]));
+    }
+    return hull;
+}
+
+std::shared_ptr<const HullVertices> HullVertices::build(const std::shared_ptr<const TriangleMesh>& mesh) {
+    if (!mesh || mesh->vertexCount() == 0) {
+        return nullptr;
+    }
+    auto hull = std::make_shared<const HullVertices>(fromMesh(*mesh));
+    return hull->empty() ? nullptr : hull;
+}
+
+BoundingBox HullVertices::worldBounds(const Transform& transform) const {
+    const std::array<double, 12> m = transform.matrix();
+    if (empty()) {
+        return BoundingBox(m[3], m[3], m[7], m[7], m[11], m[11]);
+    }
+
+    // Rotated coordinates along each world axis; the translation is added
+    // in double afterwards
+    float lo[3], hi[3];
+    for (int row = 0; row < 3; ++row) {
+        lo[row] = std::numeric_limits<float>::max();
+        hi[row] = std::numeric_limits<float>::lowest();
+    }
+
+    const float* px = x.data();
+    const float* py = y.data();
+    const float* pz = z.data();
+    const std::size_t count = size();
+    std::size_t i = 0;
+
+#if MARC_HULLVERTICES_SSE2
+    // Four vertices per step, three rows each, folded into running
+    // minima and maxima per lane
+    const std::size_t vectorEnd = count - count % 4;
+    if (vectorEnd > 0) {
+        __m128 vlo[3], vhi[3];
+        for (int row = 0; row < 3; ++row) {
+            vlo[row] = _mm_set1_ps(lo[row]);
+            vhi[row] = _mm_set1_ps(hi[row]);
+        }
+        for (; i < vectorEnd; i += 4) {
+            const __m128 vx = _mm_loadu_ps(px + i);
+            const __m128 vy = _mm_loadu_ps(py + i);
+            const __m128 vz = _mm_loadu_ps(pz + i);
+            for (int row = 0; row < 3; ++row) {
+                __m128 d = _mm_mul_ps(vx, _mm_set1_ps(static_cast<float>(m[4 * row])));
+                d = _mm_add_ps(d, _mm_mul_ps(vy, _mm_set1_ps(static_cast<float>(m[4 * row + 1]))));
+                d = _mm_add_ps(d, _mm_mul_ps(vz, _mm_set1_ps(static_cast<float>(m[4 * row + 2]))));
+                vlo[row] = _mm_min_ps(vlo[row], d);
+                vhi[row] = _mm_max_ps(vhi[row], d);
+            }
+        }
+        for (int row = 0; row < 3; ++row) {
+            alignas(16) float lanes[4];
+            _mm_store_ps(lanes, vlo[row]);
+            lo[row] = std::min({ lanes[0], lanes[1], lanes[2], lanes[3] });
+            _mm_store_ps(lanes, vhi[row]);
+            hi[row] = std::max({ lanes[0], lanes[1], lanes[2], lanes[3] });
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        for (int row = 0; row < 3; ++row) {
+            const float d = px[i] * static_cast<float>(m[4 * row]) +
+                            py[i] * static_cast<float>(m[4 * row + 1]) +
+                            pz[i] * static_cast<float>(m[4 * row + 2]);
+            lo[row] = std::min(lo[row], d);
+            hi[row] = std::max(hi[row], d);
+        }
+    }
+
+    return BoundingBox(lo[0] + m[3], hi[0] + m[3],
+                       lo[1] + m[7], hi[1] + m[7],
+                       lo[2] + m[11], hi[2] + m[11]);
+}
+
+double HullVertices::maxRadius(const Transform& transform) const {
+    const std::array<double, 12> m = transform.matrix();
+    const float r00 = static_cast<float>(m[0]), r01 = static_cast<float>(m[1]), r02 = static_cast<float>(m[2]);
+    const float r10 = static_cast<float>(m[4]), r11 = static_cast<float>(m[5]), r12 = static_cast<float>(m[6]);
+    const float tx = static_cast<float>(m[3]);
+    const float ty = static_cast<float>(m[7]);
+
+    const float* px = x.data();
+    const float* py = y.data();
+    const float* pz = z.data();
+    const std::size_t count = size();
+    std::size_t i = 0;
+    float best = 0.0f;
+
+#if MARC_HULLVERTICES_SSE2
+    const std::size_t vectorEnd = count - count % 4;
+    if (vectorEnd > 0) {
+        __m128 vbest = _mm_setzero_ps();
+        for (; i < vectorEnd; i += 4) {
+            const __m128 vx = _mm_loadu_ps(px + i);
+            const __m128 vy = _mm_loadu_ps(py + i);
+            const __m128 vz = _mm_loadu_ps(pz + i);
+            __m128 wx = _mm_add_ps(_mm_mul_ps(vx, _mm_set1_ps(r00)), _mm_set1_ps(tx));
+            wx = _mm_add_ps(wx, _mm_mul_ps(vy, _mm_set1_ps(r01)));
+            wx = _mm_add_ps(wx, _mm_mul_ps(vz, _mm_set1_ps(r02)));
+            __m128 wy = _mm_add_ps(_mm_mul_ps(vx, _mm_set1_ps(r10)), _mm_set1_ps(ty));
+            wy = _mm_add_ps(wy, _mm_mul_ps(vy, _mm_set1_ps(r11)));
+            wy = _mm_add_ps(wy, _mm_mul_ps(vz, _mm_set1_ps(r12)));
+            vbest = _mm_max_ps(vbest, _mm_add_ps(_mm_mul_ps(wx, wx), _mm_mul_ps(wy, wy)));
+        }
+        alignas(16) float lanes[4];
+        _mm_store_ps(lanes, vbest);
+        best = std::max({ lanes[0], lanes[1], lanes[2], lanes[3] });
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const float wx = px[i] * r00 + tx + py[i] * r01 + pz[i] * r02;
+        const float wy = px[i] * r10 + ty + py[i] * r11 + pz[i] * r12;
+        best = std::max(best, wx * wx + wy * wy);
+    }
+    return std::sqrt(static_cast<double>(best));
+}
+
+} // namespace Domain
+} // namespace MarcSLM
@@ -0,0 +1,54 @@
+#ifndef HULLVERTICES_H
+#define HULLVERTICES_H
+
+#include "BoundingBox.h"
+#include "Transform.h"
+#include "TriangleMesh.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace MarcSLM {
+namespace Domain {
+
+/**
+ * @brief Convex hull vertices of a part, for placement queries
+ *
+ * How far a rigidly moved part reaches in any direction only depends on
+ * its hull vertices, usually a few hundred, so exact world bounds and the
+ * build cylinder test cost one short pass per transform instead of a pass
+ * over the mesh. Vertices are kept in model coordinates as one float array
+ * per axis, so the passes are SIMD (SSE2 where available, scalar otherwise).
+ */
+struct HullVertices {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+
+    std::size_t size() const { return x.size(); }
+    bool empty() const { return x.empty(); }
+
+    static HullVertices fromMesh(const TriangleMesh& mesh);
+
+    /**
+     * @brief Hull of a mesh for sharing between models
+     * @return nullptr if mesh is null or has no vertices
+     */
+    static std::shared_ptr<const HullVertices> build(const std::shared_ptr<const TriangleMesh>& mesh);
+
+    /**
+     * @brief Smallest axis-aligned box around the part once transformed
+     */
+    BoundingBox worldBounds(const Transform& transform) const;
+
+    /**
+     * @brief Largest distance of the transformed part from the world Z axis
+     */
+    double maxRadius(const Transform& transform) const;
+};
+
+} // namespace Domain
+} // namespace MarcSLM
+
+#endif // HULLVERTICES_H
@@ -0,0 +1,672 @@
+#include "MeshBvh.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+
+namespace MarcSLM {
+namespace Domain {
+
+namespace {
+
+using Vec = std::array<double, 3>;
+
+constexpr std::uint32_t LeafSize = 4;
+
+// Queries where the smaller mesh has fewer triangles than this stay on the
+// calling thread; starting threads would cost more than the search
+constexpr std::size_t ParallelMinTriangles = 20000;
+
+// Node pairs handed out per thread, so that uneven subtrees still balance
+constexpr std::size_t TasksPerWorker = 8;
+
+// Directions for inside tests, away from the axes and from each other.
+// A ray that passes too close to an edge or vertex to count reliably is
+// cast again along the next one.
+const Vec RayDirections[] = {
+    { 0.2672612419124244, 0.5345224838248488, 0.8017837257372732 },    // (1, 2, 3)
+    { -0.7427813527082074, 0.5570860145311556, 0.3713906763541037 },   // (-4, 3, 2)
+    { 0.4767312946227962, -0.1589104315409321, -0.8645128524562003 },  // (3, -1, -5.44)
+    { -0.3015113445777636, -0.9045340337332909, 0.3015113445777636 },  // (-1, -3, 1)
+};
+
+// Barycentric margin inside which a hit counts as on an edge or vertex
+constexpr double EdgeTolerance = 1e-9;
+
+enum class RayHit { Miss, Hit, OnEdge };
+
+Vec sub(const Vec& a, const Vec& b) {
+    return { a[0] - b[0], a[1] - b[1], a[2] - b[2] };
+}
+
+Vec cross(const Vec& a, const Vec& b) {
+    return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+}
+
+double dot(const Vec& a, const Vec& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Vec along(const Vec& p, const Vec& d, double s) {
+    return { p[0] + d[0] * s, p[1] + d[1] * s, p[2] + d[2] * s };
+}
+
+double distanceSq(const Vec& a, const Vec& b) {
+    const Vec d = sub(a, b);
+    return dot(d, d);
+}
+
+// Closest point on triangle abc to p (Ericson, Real-Time Collision Detection 5.1.5)
+double pointTriangleDistanceSq(const Vec& p, const Vec& a, const Vec& b, const Vec& c) {
+    const Vec ab = sub(b, a), ac = sub(c, a), ap = sub(p, a);
+    const double d1 = dot(ab, ap), d2 = dot(ac, ap);
+    if (d1 <= 0.0 && d2 <= 0.0) return distanceSq(p, a);
+
+    const Vec bp = sub(p, b);
+    const double d3 = dot(ab, bp), d4 = dot(ac, bp);
+    if (d3 >= 0.0 && d4 <= d3) return distanceSq(p, b);
+
+    const double vc = d1 * d4 - d3 * d2;
+    if (vc <= 0.0 && d1 >= 0.0 && d3 <= 0.0) {
+        return distanceSq(p, along(a, ab, d1 / (d1 - d3)));
+    }
+
+    const Vec cp = sub(p, c);
+    const double d5 = dot(ab, cp), d6 = dot(ac, cp);
+    if (d6 >= 0.0 && d5 <= d6) return distanceSq(p, c);
+
+    const double vb = d5 * d2 - d1 * d6;
+    if (vb <= 0.0 && d2 >= 0.0 && d6 <= 0.0) {
+        return distanceSq(p, along(a, ac, d2 / (d2 - d6)));
+    }
+
+    const double va = d3 * d6 - d5 * d4;
+    if (va <= 0.0 && (d4 - d3) >= 0.0 && (d5 - d6) >= 0.0) {
+        return distanceSq(p, along(b, sub(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+    }
+
+    const double sum = va + vb + vc;
+    if (sum <= 0.0) {
+        // Degenerate triangle: the edges above already covered it
+        return std::min({ distanceSq(p, a), distanceSq(p, b), distanceSq(p, c) });
+    }
+    const double v = vb / sum, w = vc / sum;
+    return distanceSq(p, along(along(a, ab, v), ac, w));
+}
+
+// Closest points of segments p1q1 and p2q2 (Ericson 5.1.9)
+double segmentSegmentDistanceSq(const Vec& p1, const Vec& q1, const Vec& p2, const Vec& q2) {
+    constexpr double eps = 1e-20;
+    const Vec d1 = sub(q1, p1), d2 = sub(q2, p2), r = sub(p1, p2);
+    const double a = dot(d1, d1), e = dot(d2, d2), f = dot(d2, r);
+
+    double s = 0.0, t = 0.0;
+    if (a <= eps && e <= eps) {
+        return dot(r, r);
+    }
+    if (a <= eps) {
+        t = std::clamp(f / e, 0.0, 1.0);
+    } else {
+        const double c = dot(d1, r);
+        if (e <= eps) {
+            s = std::clamp(-c / a, 0.0, 1.0);
+        } else {
+            const double b = dot(d1, d2);
+            const double denom = a * e - b * b;
+            s = denom > 0.0 ? std::clamp((b * f - c * e) / denom, 0.0, 1.0) : 0.0;
+            t = (b * s + f) / e;
+            if (t < 0.0) {
+                t = 0.0;
+                s = std::clamp(-c / a, 0.0, 1.0);
+            } else if (t > 1.0) {
+                t = 1.0;
+                s = std::clamp((b - c) / a, 0.0, 1.0);
+            }
+        }
+    }
+    return distanceSq(along(p1, d1, s), along(p2, d2, t));
+}
+
+// Whether segment pq passes through triangle abc; coplanar segments are
+// left to the distance tests
+bool segmentCrossesTriangle(const Vec& p, const Vec& q, const Vec& a, const Vec& b, const Vec& c) {
+    const Vec n = cross(sub(b, a), sub(c, a));
+    const double dp = dot(n, sub(p, a));
+    const double dq = dot(n, sub(q, a));
+    if ((dp > 0.0 && dq > 0.0) || (dp < 0.0 && dq < 0.0) || dp == dq) {
+        return false;
+    }
+
+    const Vec x = along(p, sub(q, p), dp / (dp - dq));
+    return dot(n, cross(sub(b, a), sub(x, a))) >= 0.0 &&
+           dot(n, cross(sub(c, b), sub(x, b))) >= 0.0 &&
+           dot(n, cross(sub(a, c), sub(x, c))) >= 0.0;
+}
+
+// Squared distance between triangles, 0 if they intersect. Apart from
+// crossings, the closest points are always on an edge pair or a vertex and
+// the other triangle.
+double triangleDistanceSq(const Vec* t, const Vec* u) {
+    for (int i = 0; i < 3; ++i) {
+        const int j = (i + 1) % 3;
+        if (segmentCrossesTriangle(t[i], t[j], u[0], u[1], u[2]) ||
+            segmentCrossesTriangle(u[i], u[j], t[0], t[1], t[2])) {
+            return 0.0;
+        }
+    }
+
+    double best = std::numeric_limits<double>::max();
+    for (int i = 0; i < 3; ++i) {
+        const int ni = (i + 1) % 3;
+        for (int j = 0; j < 3; ++j) {
+            const int nj = (j + 1) % 3;
+            best = std::min(best, segmentSegmentDistanceSq(t[i], t[ni], u[j], u[nj]));
+        }
+        best = std::min(best, pointTriangleDistanceSq(t[i], u[0], u[1], u[2]));
+        best = std::min(best, pointTriangleDistanceSq(u[i], t[0], t[1], t[2]));
+    }
+    return best;
+}
+
+// Möller-Trumbore, hits at positive distance only. Hits within
+// EdgeTolerance of an edge are reported as such rather than counted: the
+// triangles sharing that edge would each count them, or neither would.
+RayHit rayHitsTriangle(const Vec& origin, const Vec& dir, const Vec& a, const Vec& b, const Vec& c) {
+    const Vec e1 = sub(b, a), e2 = sub(c, a);
+    const Vec h = cross(dir, e2);
+    const double det = dot(e1, h);
+    if (det == 0.0) {
+        return RayHit::Miss;
+    }
+    const double inv = 1.0 / det;
+    const Vec s = sub(origin, a);
+    const double u = dot(s, h) * inv;
+    if (u < -EdgeTolerance || u > 1.0 + EdgeTolerance) {
+        return RayHit::Miss;
+    }
+    const Vec q = cross(s, e1);
+    const double v = dot(dir, q) * inv;
+    if (v < -EdgeTolerance || u + v > 1.0 + EdgeTolerance) {
+        return RayHit::Miss;
+    }
+    if (dot(e2, q) * inv <= 0.0) {
+        return RayHit::Miss;
+    }
+    if (u < EdgeTolerance || v < EdgeTolerance || u + v > 1.0 - EdgeTolerance) {
+        return RayHit::OnEdge;
+    }
+    return RayHit::Hit;
+}
+
+} // namespace
+
+/**
+ * @brief Rigid map from the second mesh's frame into the first's
+ */
+struct MeshBvh::Pose {
+    double r[9];
+    double t[3];
+
+    // Frame of tb expressed in the frame of ta: Ma^-1 * Mb
+    static Pose relative(const Transform& ta, const Transform& tb) {
+        const std::array<double, 12> ma = ta.matrix();
+        const std::array<double, 12> mb = tb.matrix();
+        Pose pose;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                pose.r[3 * i + j] = ma[i] * mb[j] + ma[4 + i] * mb[4 + j] + ma[8 + i] * mb[8 + j];
+            }
+            pose.t[i] = ma[i] * (mb[3] - ma[3]) + ma[4 + i] * (mb[7] - ma[7]) + ma[8 + i] * (mb[11] - ma[11]);
+        }
+        return pose;
+    }
+
+    Pose inverse() const {
+        Pose inv;
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                inv.r[3 * i + j] = r[3 * j + i];
+            }
+        }
+        for (int i = 0; i < 3; ++i) {
+            inv.t[i] = -(inv.r[3 * i] * t[0] + inv.r[3 * i + 1] * t[1] + inv.r[3 * i + 2] * t[2]);
+        }
+        return inv;
+    }
+
+    Vec apply(const float* p) const {
+        return { r[0] * p[0] + r[1] * p[1] + r[2] * p[2] + t[0],
+                 r[3] * p[0] + r[4] * p[1] + r[5] * p[2] + t[1],
+                 r[6] * p[0] + r[7] * p[1] + r[8] * p[2] + t[2] };
+    }
+
+    // Squared distance between node a and node b carried into a's frame,
+    // b's box enlarged to the axis-aligned box around its rotated corners
+    double nodeDistanceSq(const Node& a, const Node& b) const {
+        double sum = 0.0;
+        for (int i = 0; i < 3; ++i) {
+            double center = t[i];
+            double half = 0.0;
+            for (int j = 0; j < 3; ++j) {
+                const double c = 0.5 * (static_cast<double>(b.lo[j]) + b.hi[j]);
+                const double h = 0.5 * (static_cast<double>(b.hi[j]) - b.lo[j]);
+                center += r[3 * i + j] * c;
+                half += std::abs(r[3 * i + j]) * h;
+            }
+            const double gap = std::max(a.lo[i] - (center + half), (center - half) - a.hi[i]);
+            if (gap > 0.0) {
+                sum += gap * gap;
+            }
+        }
+        return sum;
+    }
+};
+
+/**
+ * @brief Best distance shared by the threads of one query
+ */
+struct MeshBvh::Search {
+    std::atomic<double> bestSq;
+    double stopBelowSq = 0.0;
+
+    explicit Search(double maxDistanceSq) : bestSq(maxDistanceSq) {}
+
+    void offer(double distanceSq) {
+        double current = bestSq.load(std::memory_order_relaxed);
+        while (distanceSq < current &&
+               !bestSq.compare_exchange_weak(current, distanceSq, std::memory_order_relaxed)) {
+        }
+    }
+
+    bool finished() const {
+        return bestSq.load(std::memory_order_relaxed) < stopBelowSq;
+    }
+};
+
+namespace {
+
+double diagonalSq(const float* lo, const float* hi) {
+    double sum = 0.0;
+    for (int i = 0; i < 3; ++i) {
+        const double d = static_cast<double>(hi[i]) - lo[i];
+        sum += d * d;
+    }
+    return sum;
+}
+
+} // namespace
+
+MeshBvh::MeshBvh(const TriangleMesh& mesh) {
+    const std::size_t vertexCount = mesh.vertexCount();
+    const float* xyz = mesh.vertices.data();
+
+    // Triangles with indices in range, and their centroids
+    std::vector<std::uint32_t> order;
+    std::vector<float> centroids;
+    order.reserve(mesh.triangleCount());
+    centroids.reserve(3 * mesh.triangleCount());
+    for (std::size_t f = 0; f < mesh.triangleCount(); ++f) {
+        const std::uint32_t* v = &mesh.indices[3 * f];
+        if (v[0] >= vertexCount || v[1] >= vertexCount || v[2] >= vertexCount) {
+            continue;
+        }
+        order.push_back(static_cast<std::uint32_t>(f));
+        for (int i = 0; i < 3; ++i) {
+            centroids.push_back((xyz[3 * v[0] + i] + xyz[3 * v[1] + i] + xyz[3 * v[2] + i]) / 3.0f);
+        }
+    }
+    if (order.empty()) {
+        return;
+    }
+
+    // Centroids are indexed by position in the filtered list
+    std::vector<std::uint32_t> slot(order.size());
+    for (std::uint32_t i = 0; i < slot.size(); ++i) {
+        slot[i] = i;
+    }
+
+    struct Task {
+        std::size_t first;
+        std::size_t last;
+        std::size_t parent;   // node whose right child this is, or npos
+    };
+    constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    m_nodes.reserve(2 * (slot.size() / LeafSize + 1));
+    std::vector<Task> tasks{ Task{ 0, slot.size(), npos } };
+
+    // Depth first with the left child popped next, so it always directly
+    // follows its parent
+    while (!tasks.empty()) {
+        const Task task = tasks.back();
+        tasks.pop_back();
+
+        const std::size_t index = m_nodes.size();
+        if (task.parent != npos) {
+            m_nodes[task.parent].first = static_cast<std::uint32_t>(index);
+        }
+
+        Node node;
+        float clo[3], chi[3];
+        for (int i = 0; i < 3; ++i) {
+            node.lo[i] = clo[i] = std::numeric_limits<float>::max();
+            node.hi[i] = chi[i] = std::numeric_limits<float>::lowest();
+        }
+        for (std::size_t k = task.first; k < task.last; ++k) {
+            const std::uint32_t* v = &mesh.indices[3 * static_cast<std::size_t>(order[slot[k]])];
+            const float* c = &centroids[3 * static_cast<std::size_t>(slot[k])];
+            for (int i = 0; i < 3; ++i) {
+                for (int corner = 0; corner < 3; ++corner) {
+                    const float value = xyz[3 * static_cast<std::size_t>(v[corner]) + i];
+                    node.lo[i] = std::min(node.lo[i], value);
+                    node.hi[i] = std::max(node.hi[i], value);
+                }
+                clo[i] = std::min(clo[i], c[i]);
+                chi[i] = std::max(chi[i], c[i]);
+            }
+        }
+
+        const std::size_t count = task.last - task.first;
+        if (count <= LeafSize) {
+            node.first = static_cast<std::uint32_t>(task.first);
+            node.count = static_cast<std::uint32_t>(count);
+            m_nodes.push_back(node);
+            continue;
+        }
+        node.first = 0;
+        node.count = 0;
+        m_nodes.push_back(node);
+
+        int axis = 0;
+        for (int i = 1; i < 3; ++i) {
+            if (chi[i] - clo[i] > chi[axis] - clo[axis]) {
+                axis = i;
+            }
+        }
+        const std::size_t mid = task.first + count / 2;
+        std::nth_element(slot.begin() + task.first, slot.begin() + mid, slot.begin() + task.last,
+                         [&](std::uint32_t a, std::uint32_t b) {
+                             return centroids[3 * static_cast<std::size_t>(a) + axis] <
+                                    centroids[3 * static_cast<std::size_t>(b) + axis];
+                         });
+
+        tasks.push_back(Task{ mid, task.last, index });
+        tasks.push_back(Task{ task.first, mid, npos });
+    }
+
+    m_triangles.reserve(9 * slot.size());
+    for (std::uint32_t s : slot) {
+        const std::uint32_t* v = &mesh.indices[3 * static_cast<std::size_t>(order[s])];
+        for (int corner = 0; corner < 3; ++corner) {
+            const float* p = xyz + 3 * static_cast<std::size_t>(v[corner]);
+            m_triangles.insert(m_triangles.end(), p, p + 3);
+        }
+    }
+}
+
+std::shared_ptr<const MeshBvh> MeshBvh::build(const std::shared_ptr<const TriangleMesh>& mesh) {
+    if (!mesh || mesh->empty()) {
+        return nullptr;
+    }
+    auto bvh = std::make_shared<const MeshBvh>(*mesh);
+    return bvh->empty() ? nullptr : bvh;
+}
+
+BoundingBox MeshBvh::bounds() const {
+    if (m_nodes.empty()) {
+        return BoundingBox();
+    }
+    const Node& root = m_nodes.front();
+    return BoundingBox(root.lo[0], root.hi[0], root.lo[1], root.hi[1], root.lo[2], root.hi[2]);
+}
+
+bool MeshBvh::contains(double x, double y, double z) const {
+    if (m_nodes.empty() || !bounds().contains(x, y, z)) {
+        return false;
+    }
+
+    const Vec origin = { x, y, z };
+
+    // Node boxes are grown a little so that rounding in the slab test
+    // never drops a triangle the ray grazes
+    const Node& root = m_nodes.front();
+    const double pad = 1e-7 * std::sqrt(diagonalSq(root.lo, root.hi)) + 1e-9;
+
+    // Crossings of a ray from the point; odd means inside. Casts that pass
+    // through an edge or vertex are repeated along another direction.
+    std::size_t votes[2] = { 0, 0 };
+    std::vector<std::uint32_t> stack;
+    for (const Vec& dir : RayDirections) {
+        const Vec inv = { 1.0 / dir[0], 1.0 / dir[1], 1.0 / dir[2] };
+        std::size_t crossings = 0;
+        bool onEdge = false;
+        stack.assign(1, 0);
+        while (!stack.empty() && !onEdge) {
+            const std::uint32_t index = stack.back();
+            const Node& node = m_nodes[index];
+            stack.pop_back();
+
+            double tmin = 0.0;
+            double tmax = std::numeric_limits<double>::max();
+            for (int i = 0; i < 3; ++i) {
+                double t0 = (node.lo[i] - pad - origin[i]) * inv[i];
+                double t1 = (node.hi[i] + pad - origin[i]) * inv[i];
+                if (t0 > t1) std::swap(t0, t1);
+                tmin = std::max(tmin, t0);
+                tmax = std::min(tmax, t1);
+            }
+            if (tmin > tmax) {
+                continue;
+            }
+
+            if (node.count == 0) {
+                stack.push_back(index + 1);
+                stack.push_back(node.first);
+                continue;
+            }
+            for (std::uint32_t k = node.first; k < node.first + node.count && !onEdge; ++k) {
+                const float* p = &m_triangles[9 * static_cast<std::size_t>(k)];
+                const Vec a = { p[0], p[1], p[2] };
+                const Vec b = { p[3], p[4], p[5] };
+                const Vec c = { p[6], p[7], p[8] };
+                const RayHit hit = rayHitsTriangle(origin, dir, a, b, c);
+                crossings += hit == RayHit::Hit ? 1 : 0;
+                onEdge = hit == RayHit::OnEdge;
+            }
+        }
+        if (!onEdge) {
+            return crossings % 2 == 1;
+        }
+        // Keep the count anyway in case every direction grazes an edge
+        ++votes[crossings % 2];
+    }
+    return votes[1] > votes[0];
+}
+
+void MeshBvh::searchPairs(const MeshBvh& a, const MeshBvh& b, const Pose& pose,
+                          std::vector<std::pair<std::uint32_t, std::uint32_t>> stack,
+                          Search& search) {
+    Vec ta[LeafSize][3];
+    Vec tb[LeafSize][3];
+
+    while (!stack.empty() && !search.finished()) {
+        const std::uint32_t ia = stack.back().first;
+        const std::uint32_t ib = stack.back().second;
+        stack.pop_back();
+
+        const Node& na = a.m_nodes[ia];
+        const Node& nb = b.m_nodes[ib];
+        if (pose.nodeDistanceSq(na, nb) >= search.bestSq.load(std::memory_order_relaxed)) {
+            continue;
+        }
+
+        if (na.count != 0 && nb.count != 0) {
+            for (std::uint32_t i = 0; i < na.count; ++i) {
+                const float* p = &a.m_triangles[9 * static_cast<std::size_t>(na.first + i)];
+                for (int corner = 0; corner < 3; ++corner) {
+                    ta[i][corner] = { p[3 * corner], p[3 * corner + 1], p[3 * corner + 2] };
+                }
+            }
+            for (std::uint32_t j = 0; j < nb.count; ++j) {
+                const float* p = &b.m_triangles[9 * static_cast<std::size_t>(nb.first + j)];
+                for (int corner = 0; corner < 3; ++corner) {
+                    tb[j][corner] = pose.apply(p + 3 * corner);
+                }
+            }
+            for (std::uint32_t i = 0; i < na.count; ++i) {
+                for (std::uint32_t j = 0; j < nb.count; ++j) {
+                    search.offer(triangleDistanceSq(ta[i], tb[j]));
+                }
+            }
+            continue;
+        }
+
+        // Descend into the larger node, nearer child pair popped first
+        const bool splitA = nb.count != 0 ||
+            (na.count == 0 && diagonalSq(na.lo, na.hi) >= diagonalSq(nb.lo, nb.hi));
+        std::pair<std::uint32_t, std::uint32_t> first, second;
+        double firstSq, secondSq;
+        if (splitA) {
+            first = { ia + 1, ib };
+            second = { na.first, ib };
+            firstSq = pose.nodeDistanceSq(a.m_nodes[ia + 1], nb);
+            secondSq = pose.nodeDistanceSq(a.m_nodes[na.first], nb);
+        } else {
+            first = { ia, ib + 1 };
+            second = { ia, nb.first };
+            firstSq = pose.nodeDistanceSq(na, b.m_nodes[ib + 1]);
+            secondSq = pose.nodeDistanceSq(na, b.m_nodes[nb.first]);
+        }
+        if (firstSq > secondSq) {
+            std::swap(first, second);
+        }
+        stack.push_back(second);
+        stack.push_back(first);
+    }
+}
+
+double MeshBvh::surfaceDistance(const MeshBvh& a, const MeshBvh& b, const Pose& pose,
+                                double maxDistance, double stopBelow) {
+    Search search(maxDistance * maxDistance);
+    search.stopBelowSq = stopBelow * stopBelow;
+
+    using NodePair = std::pair<std::uint32_t, std::uint32_t>;
+    std::vector<NodePair> front{ NodePair{ 0, 0 } };
+
+    unsigned workers = 1;
+    if (std::min(a.triangleCount(), b.triangleCount()) >= ParallelMinTriangles) {
+        // One pair of meshes this large is worth every thread allowed here
+        workers = parallelWorkerCount(std::numeric_limits<std::size_t>::max(), 1);
+    }
+    if (workers <= 1) {
+        searchPairs(a, b, pose, std::move(front), search);
+        return std::sqrt(search.bestSq.load());
+    }
+
+    // Open up the first levels of pairs breadth first, dropping pairs that
+    // are already out of range, until there is enough work to share
+    const double rangeSq = search.bestSq.load();
+    while (front.size() < workers * TasksPerWorker) {
+        std::vector<NodePair> next;
+        next.reserve(2 * front.size());
+        bool split = false;
+        for (const NodePair& pair : front) {
+            const Node& na = a.m_nodes[pair.first];
+            const Node& nb = b.m_nodes[pair.second];
+            if (pose.nodeDistanceSq(na, nb) >= rangeSq) {
+                continue;
+            }
+            if (na.count == 0 && (nb.count != 0 || diagonalSq(na.lo, na.hi) >= diagonalSq(nb.lo, nb.hi))) {
+                next.push_back({ pair.first + 1, pair.second });
+                next.push_back({ na.first, pair.second });
+                split = true;
+            } else if (nb.count == 0) {
+                next.push_back({ pair.first, pair.second + 1 });
+                next.push_back({ pair.first, nb.first });
+                split = true;
+            } else {
+                next.push_back(pair);
+            }
+        }
+        front.swap(next);
+        if (!split) {
+            break;
+        }
+    }
+
+    // Nearest pairs first, so the shared bound tightens early
+    std::vector<double> pairDistance(front.size());
+    for (std::size_t i = 0; i < front.size(); ++i) {
+        pairDistance[i] = pose.nodeDistanceSq(a.m_nodes[front[i].first], b.m_nodes[front[i].second]);
+    }
+    std::vector<std::size_t> byDistance(front.size());
+    for (std::size_t i = 0; i < byDistance.size(); ++i) {
+        byDistance[i] = i;
+    }
+    std::sort(byDistance.begin(), byDistance.end(),
+              [&](std::size_t x, std::size_t y) { return pairDistance[x] < pairDistance[y]; });
+
+    std::atomic<std::size_t> nextTask{ 0 };
+    auto work = [&]() {
+        for (std::size_t n = nextTask.fetch_add(1); n < byDistance.size(); n = nextTask.fetch_add(1)) {
+            searchPairs(a, b, pose, { front[byDistance[n]] }, search);
+        }
+    };
+
+    parallelForChunks(std::min<std::size_t>(workers, front.size()), 1,
+                      [&](unsigned, std::size_t, std::size_t) { work(); });
+    return std::sqrt(search.bestSq.load());
+}
+
+bool MeshBvh::containsOther(const MeshBvh& outer, const MeshBvh& inner, const Pose& innerToOuter) {
+    if (outer.empty() || inner.empty()) {
+        return false;
+    }
+    // Surfaces do not meet, so any point of inner decides for all of it;
+    // three far apart vertices vote, in case one lies where the inside
+    // test cannot tell (an open or self-touching patch of outer)
+    const std::size_t last = inner.triangleCount() - 1;
+    const std::size_t samples[3] = { 0, last / 2, last };
+    int inside = 0;
+    for (std::size_t k : samples) {
+        const Vec p = innerToOuter.apply(&inner.m_triangles[9 * k]);
+        inside += outer.contains(p[0], p[1], p[2]) ? 1 : 0;
+    }
+    return inside >= 2;
+}
+
+bool MeshBvh::interferes(const MeshBvh& a, const Transform& ta,
+                         const MeshBvh& b, const Transform& tb) {
+    if (a.empty() || b.empty()) {
+        return false;
+    }
+    const Pose pose = Pose::relative(ta, tb);
+    if (surfaceDistance(a, b, pose, ContactTolerance, ContactTolerance) < ContactTolerance) {
+        return true;
+    }
+    return containsOther(a, b, pose) || containsOther(b, a, pose.inverse());
+}
+
+double MeshBvh::clearance(const MeshBvh& a, const Transform& ta,
+                          const MeshBvh& b, const Transform& tb,
+                          double maxDistance) {
+    if (a.empty() || b.empty()) {
+        return maxDistance;
+    }
+    const Pose pose = Pose::relative(ta, tb);
+    const double distance = surfaceDistance(a, b, pose, std::max(maxDistance, ContactTolerance),
+                                            ContactTolerance);
+    if (distance < ContactTolerance) {
+        return 0.0;
+    }
+    if (containsOther(a, b, pose) || containsOther(b, a, pose.inverse())) {
+        return 0.0;
+    }
+    return std::min(distance, maxDistance);
+}
+
+} // namespace Domain
+} // namespace MarcSLM
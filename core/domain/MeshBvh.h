@@ -0,0 +1,104 @@
+#ifndef MESHBVH_H
+#define MESHBVH_H
+
+#include "BoundingBox.h"
+#include "Transform.h"
+#include "TriangleMesh.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace MarcSLM {
+namespace Domain {
+
+/**
+ * @brief Bounding volume hierarchy over the triangles of one mesh
+ *
+ * Built once per model in model coordinates and shared between copies of
+ * the model, so moving a part never rebuilds it: queries between two parts
+ * take both transforms and carry the second part's boxes into the first
+ * part's frame on the fly.
+ *
+ * Nodes are axis-aligned boxes split at the median centroid of their
+ * longest axis down to a few triangles per leaf. Triangles are copied in
+ * leaf order, so the mesh itself is not needed after the build.
+ */
+class MeshBvh {
+public:
+    /// Surfaces closer than this (mm) are taken to touch
+    static constexpr double ContactTolerance = 1e-6;
+
+    explicit MeshBvh(const TriangleMesh& mesh);
+
+    /**
+     * @brief Build a BVH for sharing between models
+     * @return nullptr if mesh is null or has no triangles
+     */
+    static std::shared_ptr<const MeshBvh> build(const std::shared_ptr<const TriangleMesh>& mesh);
+
+    bool empty() const { return m_nodes.empty(); }
+    std::size_t triangleCount() const { return m_triangles.size() / 9; }
+
+    /// Bounds of the mesh in model coordinates
+    BoundingBox bounds() const;
+
+    /**
+     * @brief Whether a point in model coordinates lies inside the mesh
+     *
+     * Counts crossings of a ray from the point, so it is only meaningful
+     * for closed meshes. A ray that meets an edge or vertex of the mesh is
+     * cast again in another direction rather than counted once or twice.
+     */
+    bool contains(double x, double y, double z) const;
+
+    /**
+     * @brief Whether two placed meshes interfere
+     *
+     * True when their surfaces touch or cross, or when one closed mesh
+     * lies entirely inside the other.
+     */
+    static bool interferes(const MeshBvh& a, const Transform& ta,
+                           const MeshBvh& b, const Transform& tb);
+
+    /**
+     * @brief Smallest distance between two placed meshes
+     *
+     * Branch and bound over pairs of nodes: pairs whose boxes are already
+     * further apart than the best distance found are skipped. Large
+     * meshes split the first levels of pairs across threads that share
+     * the bound.
+     * @param maxDistance Distance beyond which the exact value is not needed
+     * @return 0 if the meshes interfere, otherwise the distance between the
+     *         surfaces, or maxDistance if they are at least that far apart
+     */
+    static double clearance(const MeshBvh& a, const Transform& ta,
+                            const MeshBvh& b, const Transform& tb,
+                            double maxDistance);
+
+private:
+    struct Node {
+        float lo[3];
+        float hi[3];
+        std::uint32_t first;   // leaf: first triangle; inner: right child (left child follows the node)
+        std::uint32_t count;   // triangles in a leaf, 0 for inner nodes
+    };
+
+    std::vector<Node> m_nodes;          // depth first, root at 0
+    std::vector<float> m_triangles;     // nine coordinates per triangle, in leaf order
+
+    struct Pose;
+    struct Search;
+
+    static double surfaceDistance(const MeshBvh& a, const MeshBvh& b, const Pose& pose,
+                                  double maxDistance, double stopBelow);
+    static void searchPairs(const MeshBvh& a, const MeshBvh& b, const Pose& pose,
+                            std::vector<std::pair<std::uint32_t, std::uint32_t>> stack,
+                            Search& search);
+    static bool containsOther(const MeshBvh& outer, const MeshBvh& inner, const Pose& innerToOuter);
+};
+
+} // namespace Domain
+} // namespace MarcSLM
+
+#endif // MESHBVH_H
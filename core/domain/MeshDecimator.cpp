@@ -0,0 +1,457 @@
+#include "MeshDecimator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace MarcSLM {
+namespace Domain {
+
+namespace {
+
+// Passes are cheap sweeps; meshes that stop shrinking end well before this
+constexpr int MaxPasses = 64;
+
+// Share of the remaining triangles whose cheapest edge is tried per pass,
+// to start with
+constexpr double PassFraction = 0.25;
+
+// A collapse may turn a neighbouring triangle's normal by at most
+// acos(0.2), about 78 degrees, and may not leave it a sliver
+constexpr double MinNormalDot = 0.2;
+constexpr double MaxEdgeDot = 0.999;
+
+/**
+ * @brief Sum of squared distances to a set of planes, as a symmetric 4x4
+ */
+struct Quadric {
+    // a00 a01 a02 a03 a11 a12 a13 a22 a23 a33
+    double m[10] = { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+    void addPlane(double a, double b, double c, double d) {
+        m[0] += a * a; m[1] += a * b; m[2] += a * c; m[3] += a * d;
+        m[4] += b * b; m[5] += b * c; m[6] += b * d;
+        m[7] += c * c; m[8] += c * d;
+        m[9] += d * d;
+    }
+
+    Quadric& operator+=(const Quadric& other) {
+        for (int i = 0; i < 10; ++i) m[i] += other.m[i];
+        return *this;
+    }
+
+    double error(const double p[3]) const {
+        const double x = p[0], y = p[1], z = p[2];
+        return m[0] * x * x + 2.0 * m[1] * x * y + 2.0 * m[2] * x * z + 2.0 * m[3] * x +
+               m[4] * y * y + 2.0 * m[5] * y * z + 2.0 * m[6] * y +
+               m[7] * z * z + 2.0 * m[8] * z + m[9];
+    }
+
+    // Point of least error; false when the planes do not pin one down
+    bool minimum(double p[3]) const {
+        const double det = m[0] * (m[4] * m[7] - m[5] * m[5]) -
+                           m[1] * (m[1] * m[7] - m[5] * m[2]) +
+                           m[2] * (m[1] * m[5] - m[4] * m[2]);
+        const double trace = m[0] + m[4] + m[7];
+        if (!(std::fabs(det) > 1e-9 * trace * trace * trace)) {
+            return false;
+        }
+        const double bx = -m[3], by = -m[6], bz = -m[8];
+        p[0] = (bx * (m[4] * m[7] - m[5] * m[5]) - m[1] * (by * m[7] - m[5] * bz) +
+                m[2] * (by * m[5] - m[4] * bz)) / det;
+        p[1] = (m[0] * (by * m[7] - bz * m[5]) - bx * (m[1] * m[7] - m[5] * m[2]) +
+                m[2] * (m[1] * bz - by * m[2])) / det;
+        p[2] = (m[0] * (m[4] * bz - m[5] * by) - m[1] * (m[1] * bz - by * m[2]) +
+                bx * (m[1] * m[5] - m[4] * m[2])) / det;
+        return true;
+    }
+};
+
+struct Vertex {
+    double p[3];
+    Quadric q;
+    std::uint32_t refStart = 0;
+    std::uint32_t refCount = 0;
+    bool fixed = false;  // on an open border or a kept triangle
+};
+
+struct Triangle {
+    std::uint32_t v[3];
+    std::uint32_t source;
+    double n[3];
+    double cost;  // of the cheapest edge that may collapse, infinite if none
+    bool deleted;
+    bool dirty;   // changed in this pass
+};
+
+// A triangle seen from one of its corners
+struct Ref {
+    std::uint32_t triangle;
+    std::uint32_t corner;
+};
+
+bool unitNormal(const double a[3], const double b[3], const double c[3], double n[3]) {
+    const double u[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+    const double v[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+    n[0] = u[1] * v[2] - u[2] * v[1];
+    n[1] = u[2] * v[0] - u[0] * v[2];
+    n[2] = u[0] * v[1] - u[1] * v[0];
+    const double len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if (!(len > 0.0)) {
+        n[0] = n[1] = n[2] = 0.0;
+        return false;
+    }
+    n[0] /= len;
+    n[1] /= len;
+    n[2] /= len;
+    return true;
+}
+
+// Whether the corner between edges d1 and d2 is (nearly) flat or has a
+// zero-length edge
+bool sliver(const double d1[3], const double d2[3]) {
+    const double l1 = std::sqrt(d1[0] * d1[0] + d1[1] * d1[1] + d1[2] * d1[2]);
+    const double l2 = std::sqrt(d2[0] * d2[0] + d2[1] * d2[1] + d2[2] * d2[2]);
+    return !(l1 > 0.0) || !(l2 > 0.0) ||
+           std::fabs(d1[0] * d2[0] + d1[1] * d2[1] + d1[2] * d2[2]) > MaxEdgeDot * l1 * l2;
+}
+
+// The same for the corner at c of the triangle a, b, c
+bool sliver(const double a[3], const double b[3], const double c[3]) {
+    const double d1[3] = { a[0] - c[0], a[1] - c[1], a[2] - c[2] };
+    const double d2[3] = { b[0] - c[0], b[1] - c[1], b[2] - c[2] };
+    return sliver(d1, d2);
+}
+
+class Decimation {
+public:
+    Decimation(const std::vector<float>& xyz, const std::vector<std::uint32_t>& indices,
+               const std::vector<float>& keepTriangles);
+
+    void run(std::size_t targetTriangles);
+    DecimatedMesh result();
+
+private:
+    std::vector<Vertex> m_vertices;
+    std::vector<Triangle> m_triangles;
+    std::vector<Ref> m_refs;
+    std::vector<char> m_collapsing[2];
+    std::size_t m_alive = 0;
+    double m_maxError = 0.0;
+
+    void compact();
+    double edgeCost(std::uint32_t a, std::uint32_t b, double p[3]) const;
+    double triangleCost(const Triangle& t) const;
+    bool flips(std::uint32_t i0, std::uint32_t i1, const double p[3], std::vector<char>& collapsing) const;
+    void relink(std::uint32_t from, std::uint32_t to, const std::vector<char>& collapsing);
+};
+
+Decimation::Decimation(const std::vector<float>& xyz, const std::vector<std::uint32_t>& indices,
+                       const std::vector<float>& keepTriangles) {
+    const std::size_t pointCount = xyz.size() / 3;
+    m_vertices.resize(pointCount);
+    for (std::size_t i = 0; i < pointCount; ++i) {
+        for (int k = 0; k < 3; ++k) m_vertices[i].p[k] = xyz[3 * i + k];
+    }
+
+    const std::size_t triangleCount = indices.size() / 3;
+    m_triangles.reserve(triangleCount);
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        Triangle tri;
+        tri.v[0] = indices[3 * t];
+        tri.v[1] = indices[3 * t + 1];
+        tri.v[2] = indices[3 * t + 2];
+        tri.source = static_cast<std::uint32_t>(t);
+        tri.cost = 0.0;
+        tri.deleted = tri.v[0] == tri.v[1] || tri.v[1] == tri.v[2] || tri.v[2] == tri.v[0] ||
+                      tri.v[0] >= pointCount || tri.v[1] >= pointCount || tri.v[2] >= pointCount;
+        tri.dirty = false;
+        if (!tri.deleted) {
+            const double* a = m_vertices[tri.v[0]].p;
+            if (unitNormal(a, m_vertices[tri.v[1]].p, m_vertices[tri.v[2]].p, tri.n)) {
+                const double d = -(tri.n[0] * a[0] + tri.n[1] * a[1] + tri.n[2] * a[2]);
+                for (std::uint32_t v : tri.v) m_vertices[v].q.addPlane(tri.n[0], tri.n[1], tri.n[2], d);
+            }
+            if (t < keepTriangles.size() && keepTriangles[t] != 0.0f) {
+                for (std::uint32_t v : tri.v) m_vertices[v].fixed = true;
+            }
+        }
+        m_triangles.push_back(tri);
+    }
+    compact();
+
+    // An edge used by one triangle only lies on an open border: its far
+    // end shows up once among a vertex's neighbours
+    std::vector<std::uint32_t> neighbours;
+    for (std::uint32_t i = 0; i < m_vertices.size(); ++i) {
+        const Vertex& v = m_vertices[i];
+        neighbours.clear();
+        for (std::uint32_t k = 0; k < v.refCount; ++k) {
+            const Ref& ref = m_refs[v.refStart + k];
+            const Triangle& t = m_triangles[ref.triangle];
+            neighbours.push_back(t.v[(ref.corner + 1) % 3]);
+            neighbours.push_back(t.v[(ref.corner + 2) % 3]);
+        }
+        std::sort(neighbours.begin(), neighbours.end());
+        for (std::size_t k = 0; k < neighbours.size();) {
+            std::size_t run = k + 1;
+            while (run < neighbours.size() && neighbours[run] == neighbours[k]) ++run;
+            if (run - k == 1) {
+                m_vertices[i].fixed = true;
+                m_vertices[neighbours[k]].fixed = true;
+            }
+            k = run;
+        }
+    }
+
+    for (Triangle& t : m_triangles) {
+        t.cost = triangleCost(t);
+    }
+}
+
+// Drop deleted triangles and index the rest by vertex
+void Decimation::compact() {
+    m_triangles.erase(std::remove_if(m_triangles.begin(), m_triangles.end(),
+                                     [](const Triangle& t) { return t.deleted; }),
+                      m_triangles.end());
+    m_alive = m_triangles.size();
+
+    for (Vertex& v : m_vertices) v.refCount = 0;
+    for (const Triangle& t : m_triangles) {
+        for (std::uint32_t v : t.v) ++m_vertices[v].refCount;
+    }
+    std::uint32_t start = 0;
+    for (Vertex& v : m_vertices) {
+        v.refStart = start;
+        start += v.refCount;
+        v.refCount = 0;
+    }
+    m_refs.resize(start);
+    for (std::uint32_t i = 0; i < m_triangles.size(); ++i) {
+        for (std::uint32_t c = 0; c < 3; ++c) {
+            Vertex& v = m_vertices[m_triangles[i].v[c]];
+            m_refs[v.refStart + v.refCount++] = { i, c };
+        }
+    }
+}
+
+double Decimation::edgeCost(std::uint32_t a, std::uint32_t b, double p[3]) const {
+    const Vertex& va = m_vertices[a];
+    const Vertex& vb = m_vertices[b];
+    Quadric q = va.q;
+    q += vb.q;
+
+    // The optimum of nearly coplanar planes can lie far away; then the
+    // best of the endpoints and the midpoint is used instead
+    const double mid[3] = { 0.5 * (va.p[0] + vb.p[0]), 0.5 * (va.p[1] + vb.p[1]), 0.5 * (va.p[2] + vb.p[2]) };
+    double lengthSquared = 0.0;
+    for (int k = 0; k < 3; ++k) lengthSquared += (va.p[k] - vb.p[k]) * (va.p[k] - vb.p[k]);
+    if (q.minimum(p)) {
+        double offsetSquared = 0.0;
+        for (int k = 0; k < 3; ++k) offsetSquared += (p[k] - mid[k]) * (p[k] - mid[k]);
+        if (offsetSquared <= lengthSquared) {
+            return std::max(0.0, q.error(p));
+        }
+    }
+
+    double best = std::numeric_limits<double>::infinity();
+    for (const double* candidate : { va.p, vb.p, mid }) {
+        const double e = q.error(candidate);
+        if (e < best) {
+            best = e;
+            std::copy(candidate, candidate + 3, p);
+        }
+    }
+    return std::max(0.0, best);
+}
+
+double Decimation::triangleCost(const Triangle& t) const {
+    double cost = std::numeric_limits<double>::infinity();
+    for (int j = 0; j < 3; ++j) {
+        const std::uint32_t a = t.v[j], b = t.v[(j + 1) % 3];
+        if (m_vertices[a].fixed || m_vertices[b].fixed) continue;
+        double p[3];
+        cost = std::min(cost, edgeCost(a, b, p));
+    }
+    return cost;
+}
+
+// Whether moving i0 to p (merging i1 into it) folds or squashes one of
+// i0's triangles; flags the triangles that the collapse removes
+bool Decimation::flips(std::uint32_t i0, std::uint32_t i1, const double p[3],
+                       std::vector<char>& collapsing) const {
+    const Vertex& v = m_vertices[i0];
+    collapsing.assign(v.refCount, 0);
+    for (std::uint32_t k = 0; k < v.refCount; ++k) {
+        const Ref& ref = m_refs[v.refStart + k];
+        const Triangle& t = m_triangles[ref.triangle];
+        if (t.deleted) continue;
+
+        const std::uint32_t a = t.v[(ref.corner + 1) % 3];
+        const std::uint32_t b = t.v[(ref.corner + 2) % 3];
+        if (a == i1 || b == i1) {
+            collapsing[k] = 1;
+            continue;
+        }
+
+        double d1[3], d2[3];
+        for (int c = 0; c < 3; ++c) {
+            d1[c] = m_vertices[a].p[c] - p[c];
+            d2[c] = m_vertices[b].p[c] - p[c];
+        }
+        // Triangles that already are slivers may stay so; their normals are
+        // too noisy to test for folding
+        if (sliver(m_vertices[a].p, m_vertices[b].p, v.p)) continue;
+        if (sliver(d1, d2)) {
+            return true;
+        }
+        const double origin[3] = { 0.0, 0.0, 0.0 };
+        double n[3];
+        if (unitNormal(origin, d1, d2, n) && n[0] * t.n[0] + n[1] * t.n[1] + n[2] * t.n[2] < MinNormalDot) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Re-point from's triangles at to, dropping the ones the collapse removes;
+// their refs are appended for to
+void Decimation::relink(std::uint32_t from, std::uint32_t to, const std::vector<char>& collapsing) {
+    const std::uint32_t start = m_vertices[from].refStart;
+    const std::uint32_t count = m_vertices[from].refCount;
+    for (std::uint32_t k = 0; k < count; ++k) {
+        const Ref ref = m_refs[start + k];
+        Triangle& t = m_triangles[ref.triangle];
+        if (t.deleted) continue;
+        if (collapsing[k]) {
+            t.deleted = true;
+            --m_alive;
+            continue;
+        }
+        t.v[ref.corner] = to;
+        double n[3];
+        if (unitNormal(m_vertices[t.v[0]].p, m_vertices[t.v[1]].p, m_vertices[t.v[2]].p, n)) {
+            std::copy(n, n + 3, t.n);
+        }
+        t.dirty = true;
+        m_refs.push_back(ref);
+    }
+}
+
+void Decimation::run(std::size_t targetTriangles) {
+    double fraction = PassFraction;
+    std::vector<std::uint32_t> candidates;
+    for (int pass = 0; pass < MaxPasses && m_alive > targetTriangles; ++pass) {
+        // Deleted triangles and stale refs are dropped once they make up a
+        // good part of the arrays
+        if (5 * m_alive < 4 * m_triangles.size() || m_refs.size() > 6 * m_triangles.size()) {
+            compact();
+        }
+
+        // Neighbours of a collapse changed; their costs are fresh next pass
+        candidates.clear();
+        for (std::uint32_t i = 0; i < m_triangles.size(); ++i) {
+            Triangle& t = m_triangles[i];
+            if (t.deleted) continue;
+            if (t.dirty) {
+                t.cost = triangleCost(t);
+                t.dirty = false;
+            }
+            if (std::isfinite(t.cost)) candidates.push_back(i);
+        }
+        if (candidates.empty()) break;
+
+        // The cheapest share of the triangles, cheapest first
+        const std::size_t wanted =
+            std::clamp<std::size_t>(static_cast<std::size_t>(fraction * candidates.size()), 1, candidates.size());
+        auto cheaper = [this](std::uint32_t a, std::uint32_t b) {
+            return m_triangles[a].cost < m_triangles[b].cost;
+        };
+        std::nth_element(candidates.begin(), candidates.begin() + (wanted - 1), candidates.end(), cheaper);
+        candidates.resize(wanted);
+        std::sort(candidates.begin(), candidates.end(), cheaper);
+        const double threshold = m_triangles[candidates.back()].cost;
+
+        std::size_t collapsed = 0;
+        for (std::uint32_t i : candidates) {
+            if (m_alive <= targetTriangles) break;
+            if (m_triangles[i].deleted || m_triangles[i].dirty) continue;
+
+            for (int j = 0; j < 3; ++j) {
+                const std::uint32_t i0 = m_triangles[i].v[j];
+                const std::uint32_t i1 = m_triangles[i].v[(j + 1) % 3];
+                if (m_vertices[i0].fixed || m_vertices[i1].fixed) continue;
+
+                double p[3];
+                const double cost = edgeCost(i0, i1, p);
+                if (cost > threshold) continue;
+                if (flips(i0, i1, p, m_collapsing[0]) || flips(i1, i0, p, m_collapsing[1])) continue;
+
+                Vertex& target = m_vertices[i0];
+                std::copy(p, p + 3, target.p);
+                target.q += m_vertices[i1].q;
+                m_maxError = std::max(m_maxError, cost);
+
+                const std::uint32_t start = static_cast<std::uint32_t>(m_refs.size());
+                relink(i0, i0, m_collapsing[0]);
+                relink(i1, i0, m_collapsing[1]);
+                m_vertices[i0].refStart = start;
+                m_vertices[i0].refCount = static_cast<std::uint32_t>(m_refs.size()) - start;
+                m_vertices[i1].refCount = 0;
+                ++collapsed;
+                break;
+            }
+        }
+
+        // Cheap edges that cannot collapse stay under the threshold; when they
+        // crowd out the rest, more edges are let in
+        if (4 * 2 * collapsed < wanted) {
+            if (collapsed == 0 && fraction >= 1.0) break;
+            fraction = std::min(1.0, 2.0 * fraction);
+        }
+    }
+    compact();
+}
+
+DecimatedMesh Decimation::result() {
+    DecimatedMesh mesh;
+    mesh.maxError = m_maxError;
+
+    // Vertices keep their order; merged-away ones are dropped
+    constexpr std::uint32_t Unused = std::numeric_limits<std::uint32_t>::max();
+    std::vector<std::uint32_t> remap(m_vertices.size(), Unused);
+    for (const Triangle& t : m_triangles) {
+        for (std::uint32_t v : t.v) remap[v] = 0;
+    }
+    std::uint32_t used = 0;
+    for (std::uint32_t& index : remap) {
+        if (index != Unused) index = used++;
+    }
+
+    mesh.points.resize(3 * static_cast<std::size_t>(used));
+    mesh.indices.reserve(3 * m_triangles.size());
+    mesh.sourceFaces.reserve(m_triangles.size());
+    for (std::size_t i = 0; i < m_vertices.size(); ++i) {
+        if (remap[i] == Unused) continue;
+        for (int k = 0; k < 3; ++k) {
+            mesh.points[3 * static_cast<std::size_t>(remap[i]) + k] = static_cast<float>(m_vertices[i].p[k]);
+        }
+    }
+    for (const Triangle& t : m_triangles) {
+        for (std::uint32_t v : t.v) mesh.indices.push_back(remap[v]);
+        mesh.sourceFaces.push_back(t.source);
+    }
+    return mesh;
+}
+
+} // namespace
+
+DecimatedMesh MeshDecimator::decimate(const std::vector<float>& xyz, const std::vector<std::uint32_t>& indices,
+                                      std::size_t targetTriangles, const std::vector<float>& keepTriangles) {
+    Decimation decimation(xyz, indices, keepTriangles);
+    decimation.run(targetTriangles);
+    return decimation.result();
+}
+
+} // namespace Domain
+} // namespace MarcSLM
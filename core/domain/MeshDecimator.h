@@ -0,0 +1,61 @@
+#ifndef MESHDECIMATOR_H
+#define MESHDECIMATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MarcSLM {
+namespace Domain {
+
+/**
+ * @brief Simplified copy of an indexed triangle mesh
+ */
+struct DecimatedMesh {
+    std::vector<float> points;                // xyz of the vertices still in use
+    std::vector<std::uint32_t> indices;       // three points per triangle
+    std::vector<std::uint32_t> sourceFaces;   // per triangle, the input triangle it descends from
+
+    /**
+     * @brief Largest quadric error accepted for a collapse
+     *
+     * Sum of squared distances from a merged vertex to the planes of the
+     * input triangles around it, so its square root bounds how far any
+     * vertex moved off those planes (in mesh units).
+     */
+    double maxError = 0.0;
+};
+
+/**
+ * @brief Quadric error mesh simplification (Garland-Heckbert)
+ *
+ * Edges are collapsed cheapest first until the target triangle count is
+ * reached, each to the point that minimises the summed squared distance to
+ * the planes of the triangles it replaces. Collapses run in passes rather
+ * than through a global priority queue: every pass takes the edges below a
+ * cost quantile and collapses those whose triangles were not touched yet
+ * in the pass, which keeps multi-million facet meshes to a few linear
+ * sweeps.
+ *
+ * Open borders are kept in place, and collapses that would fold a
+ * triangle over are skipped, so the target may not be reached on meshes
+ * with many borders.
+ */
+class MeshDecimator {
+public:
+    /**
+     * @param xyz Points as consecutive xyz triples
+     * @param indices Three point indices per triangle
+     * @param targetTriangles Triangle count to stop at
+     * @param keepTriangles Empty, or per triangle nonzero for triangles that
+     *        must come through unchanged (their vertices are never moved)
+     */
+    static DecimatedMesh decimate(const std::vector<float>& xyz, const std::vector<std::uint32_t>& indices,
+                                  std::size_t targetTriangles,
+                                  const std::vector<float>& keepTriangles = {});
+};
+
+} // namespace Domain
+} // namespace MarcSLM
+
+#endif // MESHDECIMATOR_H
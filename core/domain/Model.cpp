@@ -1,4 +1,6 @@
 #include "Model.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
 
 namespace MarcSLM {
@@ -15,17 +17,28 @@ Model::Model(const std::string& filePath, int id)
 }
 
 BoundingBox Model::worldBounds() const {
-    // For now, return a simple translation of local bounds
-    // TODO: Implement proper rotation-aware AABB computation
-    // when orientation optimization is integrated
+    if (m_hull && !m_hull->empty()) {
+        return m_hull->worldBounds(m_transform);
+    }
     
-    BoundingBox world = m_bounds;
-    world.minX += m_transform.x;
-    world.maxX += m_transform.x;
-    world.minY += m_transform.y;
-    world.maxY += m_transform.y;
-    world.minZ += m_transform.z;
-    world.maxZ += m_transform.z;
+    const std::array<double, 12> m = m_transform.matrix();
+    
+    // Each world axis takes its extreme from the corner picked by the
+    // signs of that row of the rotation
+    BoundingBox world;
+    double* lo[3] = { &world.minX, &world.minY, &world.minZ };
+    double* hi[3] = { &world.maxX, &world.maxY, &world.maxZ };
+    const double localMin[3] = { m_bounds.minX, m_bounds.minY, m_bounds.minZ };
+    const double localMax[3] = { m_bounds.maxX, m_bounds.maxY, m_bounds.maxZ };
+    for (int i = 0; i < 3; ++i) {
+        *lo[i] = *hi[i] = m[4 * i + 3];
+        for (int j = 0; j < 3; ++j) {
+            const double a = m[4 * i + j] * localMin[j];
+            const double b = m[4 * i + j] * localMax[j];
+            *lo[i] += std::min(a, b);
+            *hi[i] += std::max(a, b);
+        }
+    }
     
     return world;
 }
@@ -34,7 +47,33 @@ bool Model::collidesWith(const Model& other) const {
     BoundingBox myWorld = worldBounds();
     BoundingBox otherWorld = other.worldBounds();
     
-    return myWorld.intersects(otherWorld);
+    if (!myWorld.intersects(otherWorld)) {
+        return false;
+    }
+    if (!m_collisionMesh || !other.m_collisionMesh) {
+        return true;
+    }
+    return MeshBvh::interferes(*m_collisionMesh, m_transform,
+                               *other.m_collisionMesh, other.m_transform);
+}
+
+double Model::clearanceTo(const Model& other, double maxDistance) const {
+    BoundingBox myWorld = worldBounds();
+    BoundingBox otherWorld = other.worldBounds();
+    
+    const double gaps[3] = {
+        std::max({ 0.0, otherWorld.minX - myWorld.maxX, myWorld.minX - otherWorld.maxX }),
+        std::max({ 0.0, otherWorld.minY - myWorld.maxY, myWorld.minY - otherWorld.maxY }),
+        std::max({ 0.0, otherWorld.minZ - myWorld.maxZ, myWorld.minZ - otherWorld.maxZ })
+    };
+    const double boxDistance = std::sqrt(gaps[0] * gaps[0] + gaps[1] * gaps[1] + gaps[2] * gaps[2]);
+    
+    // The surfaces are never closer than the boxes
+    if (boxDistance >= maxDistance || !m_collisionMesh || !other.m_collisionMesh) {
+        return std::min(boxDistance, maxDistance);
+    }
+    return MeshBvh::clearance(*m_collisionMesh, m_transform,
+                              *other.m_collisionMesh, other.m_transform, maxDistance);
 }
 
 } // namespace Domain
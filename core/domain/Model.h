@@ -3,6 +3,8 @@
 
 #include "Transform.h"
 #include "BoundingBox.h"
+#include "HullVertices.h"
+#include "MeshBvh.h"
 #include <string>
 #include <memory>
 
@@ -42,6 +44,8 @@ public:
     BoundingBox bounds() const { return m_bounds; }
     int triangleCount() const { return m_triangleCount; }
     double volume() const { return m_volume; }
+    std::shared_ptr<const MeshBvh> collisionMesh() const { return m_collisionMesh; }
+    std::shared_ptr<const HullVertices> hull() const { return m_hull; }
     
     // Setters
     void setTransform(const Transform& t) { m_transform = t; }
@@ -49,22 +53,59 @@ public:
     void setTriangleCount(int count) { m_triangleCount = count; }
     void setVolume(double vol) { m_volume = vol; }
     
+    /**
+     * @brief Attach the triangle BVH used for exact collision tests
+     * 
+     * Shared, not copied: copies of the model and the build plate all
+     * point at the same hierarchy.
+     */
+    void setCollisionMesh(std::shared_ptr<const MeshBvh> bvh) { m_collisionMesh = std::move(bvh); }
+    
+    /**
+     * @brief Attach the convex hull vertices, computed once at load
+     * 
+     * Shared like the collision mesh. With a hull, worldBounds() and the
+     * build volume test are exact for any rotation.
+     */
+    void setHull(std::shared_ptr<const HullVertices> hull) { m_hull = std::move(hull); }
+    
     /**
      * @brief Get axis-aligned bounding box in world coordinates
      * 
      * Applies the model's transform to the local bounds to compute
      * the world-space AABB. This is used for collision detection
      * and build volume validation.
+     * 
+     * With a hull the box is exact: the extremes of the transformed hull
+     * vertices. Without one, rotated models get the box around the eight
+     * transformed corners of the local box, which may be larger than the
+     * part needs but never smaller.
      */
     BoundingBox worldBounds() const;
     
     /**
      * @brief Check if this model collides with another
+     * 
+     * World bounding boxes first; when both models have a collision mesh,
+     * boxes that meet are then checked triangle against triangle, so
+     * parts that only share box space (nested in a cavity, or next to
+     * each other when rotated) do not collide.
      * @param other Another model to test against
-     * @return true if bounding boxes intersect
+     * @return true if the parts interfere, or if their bounding boxes
+     *         intersect when either has no collision mesh
      */
     bool collidesWith(const Model& other) const;
     
+    /**
+     * @brief Distance between this model and another
+     * 
+     * Exact between the surfaces when both models have a collision mesh,
+     * between the world bounding boxes otherwise.
+     * @param maxDistance Distance beyond which the exact value is not needed
+     * @return 0 if they interfere, otherwise the distance, capped at maxDistance
+     */
+    double clearanceTo(const Model& other, double maxDistance) const;
+    
 private:
     int m_id;
     std::string m_filePath;
@@ -72,6 +113,8 @@ private:
     BoundingBox m_bounds;       // Local bounds (untransformed)
     int m_triangleCount = 0;
     double m_volume = 0.0;      // Volume in mm
+    std::shared_ptr<const MeshBvh> m_collisionMesh;  // Null until a mesh is attached
+    std::shared_ptr<const HullVertices> m_hull;      // Null until a mesh is attached
 };
 
 } // namespace Domain
@@ -0,0 +1,259 @@
+#include "NormalHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+namespace MarcSLM {
+namespace Domain {
+
+namespace {
+
+using Direction = NormalHistogram::Direction;
+using Triangle = std::array<Direction, 3>;
+
+Direction normalized(const Direction& v) {
+    const double len = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    return { v[0] / len, v[1] / len, v[2] / len };
+}
+
+Direction midpoint(const Direction& a, const Direction& b) {
+    return normalized({ a[0] + b[0], a[1] + b[1], a[2] + b[2] });
+}
+
+double dot(const Direction& a, const double b[3]) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+// Unit icosahedron, faces wound outwards
+void icosahedron(std::vector<Direction>& vertices, std::vector<std::array<int, 3>>& faces) {
+    const double t = (1.0 + std::sqrt(5.0)) / 2.0;
+    vertices = {
+        { -1, t, 0 }, { 1, t, 0 }, { -1, -t, 0 }, { 1, -t, 0 },
+        { 0, -1, t }, { 0, 1, t }, { 0, -1, -t }, { 0, 1, -t },
+        { t, 0, -1 }, { t, 0, 1 }, { -t, 0, -1 }, { -t, 0, 1 },
+    };
+    for (auto& v : vertices) {
+        v = normalized(v);
+    }
+    faces = {
+        { 0, 11, 5 }, { 0, 5, 1 }, { 0, 1, 7 }, { 0, 7, 10 }, { 0, 10, 11 },
+        { 1, 5, 9 }, { 5, 11, 4 }, { 11, 10, 2 }, { 10, 7, 6 }, { 7, 1, 8 },
+        { 3, 9, 4 }, { 3, 4, 2 }, { 3, 2, 6 }, { 3, 6, 8 }, { 3, 8, 9 },
+        { 4, 9, 5 }, { 2, 4, 11 }, { 6, 2, 10 }, { 8, 6, 7 }, { 9, 8, 1 },
+    };
+}
+
+// The four children of a spherical triangle; child k of triangle i is 4 * i + k
+void subdivide(const Triangle& t, std::vector<Triangle>& out) {
+    const Direction ab = midpoint(t[0], t[1]);
+    const Direction bc = midpoint(t[1], t[2]);
+    const Direction ca = midpoint(t[2], t[0]);
+    out.push_back({ t[0], ab, ca });
+    out.push_back({ ab, t[1], bc });
+    out.push_back({ ca, bc, t[2] });
+    out.push_back({ ab, bc, ca });
+}
+
+Direction center(const Triangle& t) {
+    return normalized({ t[0][0] + t[1][0] + t[2][0],
+                        t[0][1] + t[1][1] + t[2][1],
+                        t[0][2] + t[1][2] + t[2][2] });
+}
+
+} // namespace
+
+NormalHistogram::NormalHistogram(int subdivisions)
+    : m_subdivisions(std::max(0, subdivisions))
+{
+    std::vector<Direction> vertices;
+    std::vector<std::array<int, 3>> faces;
+    icosahedron(vertices, faces);
+
+    std::vector<Triangle> level;
+    for (const auto& f : faces) {
+        level.push_back({ vertices[f[0]], vertices[f[1]], vertices[f[2]] });
+    }
+
+    m_centers.resize(m_subdivisions + 1);
+    for (int l = 0; l <= m_subdivisions; ++l) {
+        m_centers[l].reserve(level.size());
+        for (const auto& t : level) {
+            m_centers[l].push_back(center(t));
+        }
+        if (l == m_subdivisions) {
+            break;
+        }
+        std::vector<Triangle> next;
+        next.reserve(level.size() * 4);
+        for (const auto& t : level) {
+            subdivide(t, next);
+        }
+        level.swap(next);
+    }
+
+    const std::size_t bins = m_centers.back().size();
+    m_sumX.assign(bins, 0.0);
+    m_sumY.assign(bins, 0.0);
+    m_sumZ.assign(bins, 0.0);
+    m_centroidX.assign(bins, 0.0);
+    m_centroidY.assign(bins, 0.0);
+    m_centroidZ.assign(bins, 0.0);
+    m_critical.assign(bins, 0.0);
+    m_weight.assign(bins, 0.0);
+}
+
+std::size_t NormalHistogram::binOf(const double n[3]) const {
+    // Nearest icosahedron face, then the nearest child on every level down.
+    // Exact nearest-centre search is not needed: the descent is a fixed
+    // partition of the sphere into compact cells, which is all binning needs.
+    std::size_t bin = 0;
+    double best = -2.0;
+    for (std::size_t i = 0; i < m_centers[0].size(); ++i) {
+        const double d = dot(m_centers[0][i], n);
+        if (d > best) {
+            best = d;
+            bin = i;
+        }
+    }
+    for (int l = 1; l <= m_subdivisions; ++l) {
+        const std::size_t first = bin * 4;
+        best = -2.0;
+        for (std::size_t k = 0; k < 4; ++k) {
+            const double d = dot(m_centers[l][first + k], n);
+            if (d > best) {
+                best = d;
+                bin = first + k;
+            }
+        }
+    }
+    return bin;
+}
+
+void NormalHistogram::add(const FaceNormals& faces, std::size_t begin, std::size_t end) {
+    end = std::min(end, faces.size());
+    for (int k = 0; k < 3; ++k) {
+        m_origin[k] = faces.origin[k];
+    }
+    const bool critical = !faces.critical.empty() && faces.critical.size() == faces.size();
+    m_hasCritical = m_hasCritical || critical;
+
+    for (std::size_t i = begin; i < end; ++i) {
+        const double a = faces.area[i];
+        if (a <= 0.0) continue;
+
+        const double n[3] = { faces.nx[i], faces.ny[i], faces.nz[i] };
+        const std::size_t bin = binOf(n);
+        m_sumX[bin] += a * n[0];
+        m_sumY[bin] += a * n[1];
+        m_sumZ[bin] += a * n[2];
+        m_centroidX[bin] += a * faces.cx[i];
+        m_centroidY[bin] += a * faces.cy[i];
+        m_centroidZ[bin] += a * faces.cz[i];
+        if (critical) {
+            m_critical[bin] += a * faces.critical[i];
+        }
+        m_weight[bin] += a;
+    }
+}
+
+void NormalHistogram::merge(const NormalHistogram& other) {
+    if (other.binCount() != binCount()) return;
+
+    for (std::size_t b = 0; b < binCount(); ++b) {
+        m_sumX[b] += other.m_sumX[b];
+        m_sumY[b] += other.m_sumY[b];
+        m_sumZ[b] += other.m_sumZ[b];
+        m_centroidX[b] += other.m_centroidX[b];
+        m_centroidY[b] += other.m_centroidY[b];
+        m_centroidZ[b] += other.m_centroidZ[b];
+        m_critical[b] += other.m_critical[b];
+        m_weight[b] += other.m_weight[b];
+    }
+    m_hasCritical = m_hasCritical || other.m_hasCritical;
+
+    // Centroid sums are relative to the origin of the faces they came from
+    if (std::any_of(other.m_weight.begin(), other.m_weight.end(), [](double w) { return w > 0.0; })) {
+        for (int k = 0; k < 3; ++k) {
+            m_origin[k] = other.m_origin[k];
+        }
+    }
+}
+
+FaceNormals NormalHistogram::bins() const {
+    FaceNormals out;
+    const std::size_t used = static_cast<std::size_t>(
+        std::count_if(m_weight.begin(), m_weight.end(), [](double w) { return w > 0.0; }));
+    out.reserve(used);
+    for (int k = 0; k < 3; ++k) {
+        out.origin[k] = m_origin[k];
+    }
+    if (m_hasCritical) {
+        out.critical.reserve(used);
+    }
+
+    for (std::size_t b = 0; b < binCount(); ++b) {
+        if (m_weight[b] <= 0.0) continue;
+
+        // Normals in one bin are at most a few degrees apart, so their mean
+        // cannot cancel out; the centre is only a guard against rounding.
+        const double len = std::sqrt(m_sumX[b] * m_sumX[b] + m_sumY[b] * m_sumY[b] +
+                                     m_sumZ[b] * m_sumZ[b]);
+        const Direction n = len > 0.0
+            ? Direction{ m_sumX[b] / len, m_sumY[b] / len, m_sumZ[b] / len }
+            : m_centers.back()[b];
+
+        out.nx.push_back(static_cast<float>(n[0]));
+        out.ny.push_back(static_cast<float>(n[1]));
+        out.nz.push_back(static_cast<float>(n[2]));
+        out.area.push_back(static_cast<float>(m_weight[b]));
+        out.cx.push_back(static_cast<float>(m_centroidX[b] / m_weight[b]));
+        out.cy.push_back(static_cast<float>(m_centroidY[b] / m_weight[b]));
+        out.cz.push_back(static_cast<float>(m_centroidZ[b] / m_weight[b]));
+        if (m_hasCritical) {
+            out.critical.push_back(static_cast<float>(m_critical[b] / m_weight[b]));
+        }
+        out.totalArea += m_weight[b];
+    }
+    return out;
+}
+
+std::vector<NormalHistogram::Direction> NormalHistogram::sphereDirections(int subdivisions) {
+    std::vector<Direction> vertices;
+    std::vector<std::array<int, 3>> faces;
+    icosahedron(vertices, faces);
+
+    // Shared edges are split once; the cache maps an edge to its midpoint
+    for (int l = 0; l < subdivisions; ++l) {
+        std::map<std::pair<int, int>, int> midpoints;
+        auto split = [&](int a, int b) {
+            const auto key = std::make_pair(std::min(a, b), std::max(a, b));
+            auto it = midpoints.find(key);
+            if (it != midpoints.end()) {
+                return it->second;
+            }
+            vertices.push_back(midpoint(vertices[a], vertices[b]));
+            const int index = static_cast<int>(vertices.size()) - 1;
+            midpoints.emplace(key, index);
+            return index;
+        };
+
+        std::vector<std::array<int, 3>> next;
+        next.reserve(faces.size() * 4);
+        for (const auto& f : faces) {
+            const int ab = split(f[0], f[1]);
+            const int bc = split(f[1], f[2]);
+            const int ca = split(f[2], f[0]);
+            next.push_back({ f[0], ab, ca });
+            next.push_back({ ab, f[1], bc });
+            next.push_back({ ca, bc, f[2] });
+            next.push_back({ ab, bc, ca });
+        }
+        faces.swap(next);
+    }
+    return vertices;
+}
+
+} // namespace Domain
+} // namespace MarcSLM
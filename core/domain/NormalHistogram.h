@@ -0,0 +1,81 @@
+#ifndef NORMALHISTOGRAM_H
+#define NORMALHISTOGRAM_H
+
+#include "FaceNormals.h"
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace MarcSLM {
+namespace Domain {
+
+/**
+ * @brief Area-weighted histogram of face normals on a geodesic sphere
+ *
+ * The sphere is an icosahedron subdivided `subdivisions` times; each of its
+ * 20 * 4^subdivisions triangles is one bin. A bin accumulates the area of
+ * the faces whose normal falls into it, their area-weighted mean normal and
+ * centroid, and how much of that area is critical.
+ *
+ * Overhang scoring only depends on normals and areas, so the non-empty bins
+ * (see bins()) can be scored exactly like a mesh of a few thousand faces,
+ * whatever the size of the original mesh. Faces whose normal lies within a
+ * bin's width of the threshold cone may be classified on the wrong side;
+ * callers that need exact scores rescore their best candidates on the mesh.
+ */
+class NormalHistogram {
+public:
+    using Direction = std::array<double, 3>;
+
+    /// 4 subdivisions give 5120 bins about 3 degrees wide
+    explicit NormalHistogram(int subdivisions = 4);
+
+    int subdivisions() const { return m_subdivisions; }
+    std::size_t binCount() const { return m_weight.size(); }
+
+    /// Bin faces [begin, end) of faces; zero-area faces are ignored
+    void add(const FaceNormals& faces, std::size_t begin, std::size_t end);
+    void add(const FaceNormals& faces) { add(faces, 0, faces.size()); }
+
+    /// Add another histogram with the same subdivisions, bin by bin
+    void merge(const NormalHistogram& other);
+
+    /// Bin that a unit direction falls into
+    std::size_t binOf(const double n[3]) const;
+
+    /**
+     * @brief Non-empty bins as faces: mean normal, centroid and total area per bin
+     *
+     * supportArea() and supportTerms() on the result approximate the same
+     * calls on the mesh.
+     */
+    FaceNormals bins() const;
+
+    /**
+     * @brief Vertices of the icosahedron subdivided `subdivisions` times
+     *
+     * 10 * 4^subdivisions + 2 unit vectors spread evenly over the sphere;
+     * 6 subdivisions space them about 1 degree apart.
+     */
+    static std::vector<Direction> sphereDirections(int subdivisions);
+
+private:
+    int m_subdivisions;
+    std::vector<std::vector<Direction>> m_centers;  // bin centres, per level
+    std::vector<double> m_sumX;                     // area-weighted normal sums
+    std::vector<double> m_sumY;
+    std::vector<double> m_sumZ;
+    std::vector<double> m_centroidX;                // area-weighted centroid sums
+    std::vector<double> m_centroidY;
+    std::vector<double> m_centroidZ;
+    std::vector<double> m_critical;                 // critical face area per bin
+    std::vector<double> m_weight;                   // face area per bin
+    double m_origin[3] = { 0.0, 0.0, 0.0 };        // of the binned faces' centroids
+    bool m_hasCritical = false;
+};
+
+} // namespace Domain
+} // namespace MarcSLM
+
+#endif // NORMALHISTOGRAM_H
@@ -0,0 +1,164 @@
+#ifndef DOMAIN_PARALLELFOR_H
+#define DOMAIN_PARALLELFOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace MarcSLM {
+namespace Domain {
+
+/**
+ * @brief Threads shared by a set of concurrent tasks
+ *
+ * Each task's parallel loops get an equal part of the threads among the
+ * tasks not yet finished, taken afresh at every loop: as tasks finish,
+ * the ones still running widen their loops onto the freed cores.
+ */
+class ParallelWorkerShare {
+public:
+    ParallelWorkerShare(unsigned threads, unsigned tasks)
+        : m_threads(std::max(1u, threads)), m_remaining(tasks) {}
+
+    ParallelWorkerShare(const ParallelWorkerShare&) = delete;
+    ParallelWorkerShare& operator=(const ParallelWorkerShare&) = delete;
+
+    void taskFinished() { m_remaining.fetch_sub(1, std::memory_order_relaxed); }
+
+    /// Threads one task's loop may use now
+    unsigned perTask() const {
+        const unsigned remaining = m_remaining.load(std::memory_order_relaxed);
+        return std::max(1u, m_threads / std::max(1u, remaining));
+    }
+
+private:
+    unsigned m_threads;
+    std::atomic<unsigned> m_remaining;
+};
+
+namespace detail {
+
+// Limit of parallel loops started on this thread: fixed, or a share
+struct ParallelWorkerLimitState {
+    unsigned fixed = 0;                          // 0 for none
+    const ParallelWorkerShare* share = nullptr;
+};
+
+inline ParallelWorkerLimitState& parallelWorkerLimitState() {
+    thread_local ParallelWorkerLimitState state;
+    return state;
+}
+
+} // namespace detail
+
+/// Most workers a parallel loop started on this thread may use now; 0 for no limit
+inline unsigned parallelWorkerLimit() {
+    const detail::ParallelWorkerLimitState& state = detail::parallelWorkerLimitState();
+    if (state.fixed > 0) {
+        return state.fixed;
+    }
+    return state.share ? state.share->perTask() : 0;
+}
+
+/**
+ * @brief Limits parallel loops started on this thread while in scope
+ *
+ * For work that already runs as one of several tasks on a thread pool:
+ * without it, every task would split its loops across all cores again.
+ * Either a fixed number of workers or a ParallelWorkerShare, which must
+ * outlive the scope.
+ */
+class ScopedParallelWorkerLimit {
+public:
+    explicit ScopedParallelWorkerLimit(unsigned maxWorkers)
+        : m_previous(detail::parallelWorkerLimitState()) {
+        detail::parallelWorkerLimitState() = { maxWorkers, nullptr };
+    }
+    explicit ScopedParallelWorkerLimit(const ParallelWorkerShare& share)
+        : m_previous(detail::parallelWorkerLimitState()) {
+        detail::parallelWorkerLimitState() = { 0, &share };
+    }
+    ~ScopedParallelWorkerLimit() { detail::parallelWorkerLimitState() = m_previous; }
+
+    ScopedParallelWorkerLimit(const ScopedParallelWorkerLimit&) = delete;
+    ScopedParallelWorkerLimit& operator=(const ScopedParallelWorkerLimit&) = delete;
+
+private:
+    detail::ParallelWorkerLimitState m_previous;
+};
+
+/**
+ * @brief Number of worker threads to use for a range of work items
+ *
+ * Never spawns more workers than there are chunks of at least
+ * minItemsPerWorker items, so small inputs stay single-threaded, nor more
+ * than the calling thread's parallelWorkerLimit().
+ */
+inline unsigned parallelWorkerCount(std::size_t itemCount, std::size_t minItemsPerWorker) {
+    unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+    const unsigned limit = parallelWorkerLimit();
+    if (limit > 0) {
+        hw = std::min(hw, limit);
+    }
+    std::size_t byWork = itemCount / std::max<std::size_t>(1, minItemsPerWorker);
+    return static_cast<unsigned>(std::max<std::size_t>(1, std::min<std::size_t>(hw, byWork)));
+}
+
+/**
+ * @brief Split [0, itemCount) into contiguous chunks and run them in parallel
+ *
+ * The split depends only on itemCount and the worker count, so callers that
+ * reduce per-chunk results in chunk order get deterministic output.
+ * The calling thread processes the last chunk itself. Loops started
+ * inside a chunk share the threads the loop could have used, so nesting
+ * never multiplies the thread count.
+ *
+ * @param itemCount Number of items
+ * @param minItemsPerWorker Minimum chunk size worth a thread
+ * @param fn Callable fn(chunkIndex, begin, end)
+ * @return Number of chunks used
+ */
+template <typename Fn>
+unsigned parallelForChunks(std::size_t itemCount, std::size_t minItemsPerWorker, Fn&& fn) {
+    const unsigned workers = parallelWorkerCount(itemCount, minItemsPerWorker);
+    if (workers <= 1) {
+        fn(0u, std::size_t(0), itemCount);
+        return 1;
+    }
+
+    // Threads left over for loops nested in each chunk
+    const unsigned available = parallelWorkerLimit() > 0
+        ? parallelWorkerLimit() : std::max(1u, std::thread::hardware_concurrency());
+    const unsigned nested = std::max(1u, available / workers);
+
+    const std::size_t chunk = (itemCount + workers - 1) / workers;
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+
+    for (unsigned w = 0; w + 1 < workers; ++w) {
+        std::size_t begin = std::min(itemCount, w * chunk);
+        std::size_t end = std::min(itemCount, begin + chunk);
+        threads.emplace_back([&fn, w, begin, end, nested]() {
+            ScopedParallelWorkerLimit limit(nested);
+            fn(w, begin, end);
+        });
+    }
+
+    {
+        ScopedParallelWorkerLimit limit(nested);
+        std::size_t lastBegin = std::min(itemCount, (workers - 1) * chunk);
+        fn(workers - 1, lastBegin, itemCount);
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+    return workers;
+}
+
+} // namespace Domain
+} // namespace MarcSLM
+
+#endif // DOMAIN_PARALLELFOR_H
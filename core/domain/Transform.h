@@ -1,6 +1,7 @@
 #ifndef TRANSFORM_H
 #define TRANSFORM_H
 
+#include <array>
 #include <cmath>
 
 namespace MarcSLM {
@@ -48,6 +49,24 @@ struct Transform {
     bool operator!=(const Transform& other) const {
         return !(*this == other);
     }
+    
+    /**
+     * @brief Model-to-world matrix as a row-major 3x4 [R | t]
+     * 
+     * R = Rz(yaw) * Ry(pitch) * Rx(roll), then the translation: the order
+     * VtkModelRenderer applies the transform to the actors.
+     */
+    std::array<double, 12> matrix() const {
+        constexpr double degToRad = 3.14159265358979323846 / 180.0;
+        const double cr = std::cos(roll * degToRad), sr = std::sin(roll * degToRad);
+        const double cp = std::cos(pitch * degToRad), sp = std::sin(pitch * degToRad);
+        const double cy = std::cos(yaw * degToRad), sy = std::sin(yaw * degToRad);
+        return {
+            cy * cp, cy * sp * sr - sy * cr, cy * sp * cr + sy * sr, x,
+            sy * cp, sy * sp * sr + cy * cr, sy * sp * cr - cy * sr, y,
+            -sp,     cp * sr,                cp * cr,                z
+        };
+    }
 };
 
 } // namespace Domain
@@ -0,0 +1,29 @@
+#ifndef TRIANGLEMESH_H
+#define TRIANGLEMESH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MarcSLM {
+namespace Domain {
+
+/**
+ * @brief Indexed triangle mesh in model coordinates
+ *
+ * Plain buffers that loaders fill once and renderers, collision and
+ * orientation code read without copying. All coordinates are in millimeters.
+ */
+struct TriangleMesh {
+    std::vector<float> vertices;          // interleaved x, y, z
+    std::vector<std::uint32_t> indices;   // three vertex indices per triangle
+
+    std::size_t vertexCount() const { return vertices.size() / 3; }
+    std::size_t triangleCount() const { return indices.size() / 3; }
+    bool empty() const { return indices.empty(); }
+};
+
+} // namespace Domain
+} // namespace MarcSLM
+
+#endif // TRIANGLEMESH_H
@@ -9,7 +9,7 @@
 #include "presentation/MainWindowViewModel.h"
 #include "presentation/ModelListWidget.h"
 #include "presentation/PropertiesPanel.h"
-#include "infrastructure/VtkStlFileLoader.h"
+#include "infrastructure/NativeStlFileLoader.h"
 #include "infrastructure/VtkModelRenderer.h"
 #include "infrastructure/MarcDllAdapter.h"
 #include "core/domain/BuildPlate.h"
@@ -45,7 +45,7 @@ void setupDomainLayer(QMainWindow* mainWindow) {
  */
 void setupInfrastructure(QMainWindow* mainWindow, vtkRenderer* renderer) {
     // Create STL file loader (replaces inline vtkSTLReader code)
-    auto* stlLoader = new Infrastructure::VtkStlFileLoader();
+    auto* stlLoader = new Infrastructure::NativeStlFileLoader();
     
     // Create model renderer (replaces manual VTK actor management)
     auto* modelRenderer = new Infrastructure::VtkModelRenderer(renderer);
@@ -186,7 +186,7 @@ public:
         m_buildPlate = new Domain::BuildPlate(100.0, 200.0);
         
         // 3. Create infrastructure
-        m_stlLoader = new Infrastructure::VtkStlFileLoader();
+        m_stlLoader = new Infrastructure::NativeStlFileLoader();
         m_modelRenderer = new Infrastructure::VtkModelRenderer(renderer);
         m_dllAdapter = new Infrastructure::MarcDllAdapter();
         
@@ -227,7 +227,7 @@ private:
     Domain::BuildPlate* m_buildPlate;
     
     // Infrastructure
-    Infrastructure::VtkStlFileLoader* m_stlLoader;
+    Infrastructure::NativeStlFileLoader* m_stlLoader;
     Infrastructure::VtkModelRenderer* m_modelRenderer;
     Infrastructure::MarcDllAdapter* m_dllAdapter;
     
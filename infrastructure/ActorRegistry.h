@@ -0,0 +1,43 @@
+#ifndef ACTORREGISTRY_H
+#define ACTORREGISTRY_H
+
+#include <vtkSmartPointer.h>
+#include <vtkActor.h>
+#include <cstddef>
+#include <unordered_map>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief Model actors by actor id
+ *
+ * VtkModelRenderer fills it as it adds and removes model actors; other
+ * scene code (CollisionVisualizer) reads it to reach a model's actor
+ * directly instead of walking the renderer's actor collection, which
+ * also holds the plate, grid and other props.
+ */
+class ActorRegistry {
+public:
+    void add(int actorId, vtkSmartPointer<vtkActor> actor) { m_actors[actorId] = std::move(actor); }
+    void remove(int actorId) { m_actors.erase(actorId); }
+    void clear() { m_actors.clear(); }
+
+    /**
+     * @return The actor, or nullptr if no model actor has this id
+     */
+    vtkActor* find(int actorId) const {
+        auto it = m_actors.find(actorId);
+        return it != m_actors.end() ? it->second.GetPointer() : nullptr;
+    }
+
+    std::size_t size() const { return m_actors.size(); }
+
+private:
+    std::unordered_map<int, vtkSmartPointer<vtkActor>> m_actors;
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // ACTORREGISTRY_H
@@ -0,0 +1,159 @@
+#include "CacheDirectory.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+CacheEntryPrefix CacheEntryPrefix::make(const char (&magic)[8], std::uint32_t version,
+                                        std::uint64_t key, std::uint32_t value) {
+    CacheEntryPrefix prefix;
+    std::memcpy(prefix.magic, magic, sizeof(prefix.magic));
+    prefix.version = version;
+    prefix.value = value;
+    prefix.key = key;
+    return prefix;
+}
+
+bool CacheEntryPrefix::matches(const char (&expected)[8], std::uint32_t expectedVersion,
+                               std::uint64_t expectedKey) const {
+    return std::memcmp(magic, expected, sizeof(magic)) == 0 &&
+           version == expectedVersion && key == expectedKey;
+}
+
+CacheDirectory::CacheDirectory(std::string directory, std::string extension,
+                               std::uint64_t maxBytes, std::size_t maxEntries)
+    : m_directory(std::move(directory))
+    , m_extension(std::move(extension))
+    , m_maxBytes(maxBytes)
+    , m_maxEntries(maxEntries)
+{
+}
+
+std::string CacheDirectory::entryPath(std::uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(key));
+    return (fs::u8path(m_directory) / (std::string(name) + m_extension)).u8string();
+}
+
+bool CacheDirectory::write(std::uint64_t key, std::initializer_list<Span> contents) {
+    std::error_code ec;
+    fs::create_directories(fs::u8path(m_directory), ec);
+    if (ec) {
+        return false;
+    }
+
+    // Unique temporary name so concurrent writers never share a file
+    const std::string finalPath = entryPath(key);
+    const std::string tempPath = finalPath + ".tmp" +
+        std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+
+    std::uint64_t size = 0;
+    {
+        std::ofstream out(fs::u8path(tempPath), std::ios::binary | std::ios::trunc);
+        if (!out) {
+            return false;
+        }
+        for (const Span& span : contents) {
+            out.write(static_cast<const char*>(span.data), static_cast<std::streamsize>(span.size));
+            size += span.size;
+        }
+        if (!out) {
+            out.close();
+            fs::remove(fs::u8path(tempPath), ec);
+            return false;
+        }
+    }
+
+    fs::rename(fs::u8path(tempPath), fs::u8path(finalPath), ec);
+    if (ec) {
+        fs::remove(fs::u8path(tempPath), ec);
+        return false;
+    }
+
+    // A replaced entry is counted twice; that only brings the scan forward
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ++m_entries;
+    m_bytes += size;
+    if (overLimit()) {
+        scanAndEvict();
+    }
+    return true;
+}
+
+void CacheDirectory::touch(std::uint64_t key) const {
+    std::error_code ec;
+    fs::last_write_time(fs::u8path(entryPath(key)), fs::file_time_type::clock::now(), ec);
+}
+
+void CacheDirectory::evict() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    scanAndEvict();
+}
+
+bool CacheDirectory::overLimit() const {
+    // Until the first scan the tally only covers this session's stores
+    const unsigned divisor = m_scanned ? 1 : 16;
+    return (m_maxEntries > 0 && m_entries > m_maxEntries / divisor) ||
+           (m_maxBytes > 0 && m_bytes > m_maxBytes / divisor);
+}
+
+void CacheDirectory::scanAndEvict() {
+    struct Entry {
+        fs::path path;
+        std::uint64_t size;
+        fs::file_time_type lastUse;
+    };
+
+    std::error_code ec;
+    std::vector<Entry> entries;
+    std::uint64_t total = 0;
+    for (fs::directory_iterator it(fs::u8path(m_directory), ec), end; !ec && it != end; it.increment(ec)) {
+        if (it->path().extension() != m_extension) {
+            continue;
+        }
+        std::error_code entryEc;
+        Entry entry{it->path(), it->file_size(entryEc), it->last_write_time(entryEc)};
+        if (!entryEc) {
+            total += entry.size;
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    m_scanned = true;
+    m_entries = entries.size();
+    m_bytes = total;
+    if (!overLimit()) {
+        return;
+    }
+
+    // Trim below the limits so that the next scan is some stores away
+    const std::size_t keepEntries = m_maxEntries > 0 ? m_maxEntries - m_maxEntries / 16 : entries.size();
+    const std::uint64_t keepBytes = m_maxBytes > 0 ? m_maxBytes - m_maxBytes / 16 : total;
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.lastUse < b.lastUse;
+    });
+    for (const Entry& entry : entries) {
+        if (m_entries <= keepEntries && m_bytes <= keepBytes) {
+            break;
+        }
+        if (fs::remove(entry.path, ec)) {
+            --m_entries;
+            m_bytes -= entry.size;
+        }
+    }
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
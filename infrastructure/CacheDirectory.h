@@ -0,0 +1,109 @@
+#ifndef CACHEDIRECTORY_H
+#define CACHEDIRECTORY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief Leading fields of every cache entry file
+ *
+ * Fixed-size, padding-free layout; entries are only read back by the
+ * machine that wrote them, so native byte order is fine.
+ */
+struct CacheEntryPrefix {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t value;    // for the cache's own use (e.g. a count), 0 otherwise
+    std::uint64_t key;
+
+    static CacheEntryPrefix make(const char (&magic)[8], std::uint32_t version,
+                                 std::uint64_t key, std::uint32_t value = 0);
+
+    /// Whether an entry read back is of this kind and version, and for key
+    bool matches(const char (&magic)[8], std::uint32_t version, std::uint64_t key) const;
+};
+static_assert(sizeof(CacheEntryPrefix) == 24, "CacheEntryPrefix must not contain padding");
+
+/**
+ * @brief Directory of cache entry files keyed by 64-bit hashes
+ *
+ * The file handling MeshCache and OrientationCache share: entry paths,
+ * writes to a temporary file renamed into place (readers never see partial
+ * data), recency marks and least-recently-used eviction against an entry
+ * count and a byte budget.
+ *
+ * Stores keep a running tally instead of scanning the directory each
+ * time. The directory is only scanned once the tally passes a limit; the
+ * first time, that is after a sixteenth of a limit has been stored, as
+ * earlier sessions may have filled it. Eviction then trims to fifteen
+ * sixteenths of the limit, so the next scan is that many stores away.
+ * Safe to use from several threads.
+ */
+class CacheDirectory {
+public:
+    /// A piece of an entry's contents; pieces are written in order
+    struct Span {
+        const void* data;
+        std::size_t size;
+    };
+
+    /**
+     * @param directory Cache directory (UTF-8); created on first write
+     * @param extension Entry file extension including the dot, e.g. ".mesh"
+     * @param maxBytes Budget for all entries together; 0 for none
+     * @param maxEntries Most entries kept; 0 for no limit
+     */
+    CacheDirectory(std::string directory, std::string extension,
+                   std::uint64_t maxBytes, std::size_t maxEntries);
+
+    CacheDirectory(const CacheDirectory&) = delete;
+    CacheDirectory& operator=(const CacheDirectory&) = delete;
+
+    const std::string& directory() const { return m_directory; }
+    std::uint64_t maxBytes() const { return m_maxBytes; }
+    std::size_t maxEntries() const { return m_maxEntries; }
+
+    std::string entryPath(std::uint64_t key) const;
+
+    /**
+     * @brief Write an entry, replacing any previous one for key
+     *
+     * Evicts if the store takes the tally past a limit.
+     * @return false if the entry could not be written
+     */
+    bool write(std::uint64_t key, std::initializer_list<Span> contents);
+
+    /// Mark an entry as recently used for eviction
+    void touch(std::uint64_t key) const;
+
+    /**
+     * @brief Scan the directory and drop least recently used entries if
+     *        over a limit
+     */
+    void evict();
+
+private:
+    std::string m_directory;
+    std::string m_extension;
+    std::uint64_t m_maxBytes;
+    std::size_t m_maxEntries;
+
+    std::mutex m_mutex;         // guards the tally and serialises scans
+    bool m_scanned = false;     // tally covers the whole directory
+    std::uint64_t m_bytes = 0;
+    std::size_t m_entries = 0;
+
+    bool overLimit() const;
+    void scanAndEvict();
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // CACHEDIRECTORY_H
@@ -0,0 +1,136 @@
+#include "CachingStlFileLoader.h"
+#include "ContentHash.h"
+#include "MappedFile.h"
+#include "VtkMeshAdapter.h"
+
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+namespace {
+
+// Bump when the loader's output for the same file changes (welding rules,
+// metric definitions), so stale entries are never matched.
+constexpr std::uint64_t LoaderRevision = 1;
+
+constexpr char StampMagic[8] = {'M', 'A', 'R', 'C', 'S', 'T', 'M', 'P'};
+constexpr std::uint32_t StampVersion = 1;
+constexpr std::size_t MaxStamps = 4096;
+
+} // namespace
+
+CachingStlFileLoader::CachingStlFileLoader(std::shared_ptr<Application::IStlFileLoader> loader,
+                                           std::string cacheDirectory,
+                                           std::uint64_t maxBytes)
+    : m_loader(std::move(loader))
+    , m_cache(cacheDirectory, maxBytes)
+    , m_stamps(std::move(cacheDirectory), ".stamp", 0, MaxStamps)
+{
+}
+
+bool CachingStlFileLoader::contentKey(const std::string& filePath, Application::LoadProgress& progress,
+                                      std::uint64_t& key) {
+    MappedFile file;
+    if (!file.open(filePath) || file.size() == 0) {
+        return false;
+    }
+
+    progress.setPhase(Application::LoadProgress::Phase::Hashing);
+    progress.setTotalBytes(file.size());
+    progress.setBytesDone(0);
+    const std::uint64_t hash = ContentHash::of(file.data(), file.size(), progress);
+    progress.setPhase(Application::LoadProgress::Phase::Loading);
+    progress.setBytesDone(0);
+    if (progress.isCancelled()) {
+        return false;
+    }
+    key = ContentHash::combine(hash, LoaderRevision);
+    return true;
+}
+
+bool CachingStlFileLoader::stampKey(const std::string& filePath, std::uint64_t& stamp) {
+    std::error_code ec;
+    const std::filesystem::path path = std::filesystem::u8path(filePath);
+    const std::uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    const auto modified = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return false;
+    }
+    const std::string absolute = std::filesystem::absolute(path, ec).u8string();
+    if (ec) {
+        return false;
+    }
+
+    stamp = ContentHash::of(absolute.data(), absolute.size());
+    stamp = ContentHash::combine(stamp, static_cast<std::uint64_t>(size));
+    stamp = ContentHash::combine(stamp, static_cast<std::uint64_t>(modified.time_since_epoch().count()));
+    stamp = ContentHash::combine(stamp, LoaderRevision);
+    return true;
+}
+
+bool CachingStlFileLoader::findStamp(std::uint64_t stamp, std::uint64_t& key) const {
+    std::ifstream in(std::filesystem::u8path(m_stamps.entryPath(stamp)), std::ios::binary);
+    CacheEntryPrefix prefix;
+    std::uint64_t contents = 0;
+    if (!in.read(reinterpret_cast<char*>(&prefix), sizeof(prefix)) ||
+        !in.read(reinterpret_cast<char*>(&contents), sizeof(contents)) ||
+        !prefix.matches(StampMagic, StampVersion, stamp)) {
+        return false;
+    }
+    m_stamps.touch(stamp);
+    key = contents;
+    return true;
+}
+
+std::unique_ptr<Application::MeshData> CachingStlFileLoader::load(const std::string& filePath) {
+    Application::LoadProgress progress;
+    return loadWithProgress(filePath, progress);
+}
+
+std::unique_ptr<Application::MeshData> CachingStlFileLoader::loadWithProgress(
+    const std::string& filePath, Application::LoadProgress& progress) {
+    if (!m_loader || progress.isCancelled()) {
+        return nullptr;
+    }
+
+    // An unchanged file is known by its stamp; anything else is hashed
+    std::uint64_t stamp = 0;
+    const bool stamped = stampKey(filePath, stamp);
+    std::uint64_t key = 0;
+    const bool known = stamped && findStamp(stamp, key);
+    if (!known && !contentKey(filePath, progress, key)) {
+        if (progress.isCancelled()) {
+            return nullptr;
+        }
+        return m_loader->loadWithProgress(filePath, progress);
+    }
+
+    const auto rememberStamp = [&]() {
+        if (stamped && !known) {
+            const CacheEntryPrefix prefix = CacheEntryPrefix::make(StampMagic, StampVersion, stamp);
+            m_stamps.write(stamp, { { &prefix, sizeof(prefix) }, { &key, sizeof(key) } });
+        }
+    };
+
+    if (auto cached = m_cache.find(key)) {
+        rememberStamp();
+        cached->nativeData = VtkMeshAdapter::wrapNative(cached->mesh);
+        progress.setBytesDone(progress.totalBytes());
+        return cached;
+    }
+
+    auto meshData = m_loader->loadWithProgress(filePath, progress);
+    if (meshData && meshData->mesh && m_cache.store(key, *meshData)) {
+        rememberStamp();
+    }
+    return meshData;
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
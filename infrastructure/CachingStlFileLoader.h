@@ -0,0 +1,57 @@
+#ifndef CACHINGSTLFILELOADER_H
+#define CACHINGSTLFILELOADER_H
+
+#include "../core/application/interfaces/IStlFileLoader.h"
+#include "MeshCache.h"
+
+#include <memory>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief IStlFileLoader decorator that serves repeated files from a MeshCache
+ *
+ * The file is mapped and hashed; on a hit the cached mesh and metrics are
+ * returned without parsing or welding, on a miss the wrapped loader runs
+ * and its result is stored. Renamed or moved copies of a file share one
+ * entry because the key depends only on the contents.
+ *
+ * Hashing is reported as the LoadProgress::Phase::Hashing phase and stops
+ * early when the load is cancelled. Once a file's contents key is known,
+ * it is remembered under a cheap stamp of path, size and modification
+ * time, so reopening an unchanged file skips the hash. A file rewritten
+ * within the file system's timestamp resolution to the same size keeps
+ * its old stamp; such edits are served from the cache until touched.
+ *
+ * Only results that carry an indexed mesh (MeshData::mesh) are cached.
+ */
+class CachingStlFileLoader : public Application::IStlFileLoader {
+public:
+    /// Default budget for the cache directory
+    static constexpr std::uint64_t DefaultMaxBytes = 1ull << 30;
+
+    CachingStlFileLoader(std::shared_ptr<Application::IStlFileLoader> loader,
+                         std::string cacheDirectory,
+                         std::uint64_t maxBytes = DefaultMaxBytes);
+    ~CachingStlFileLoader() override = default;
+
+    std::unique_ptr<Application::MeshData> load(const std::string& filePath) override;
+    std::unique_ptr<Application::MeshData> loadWithProgress(const std::string& filePath,
+                                                            Application::LoadProgress& progress) override;
+
+private:
+    std::shared_ptr<Application::IStlFileLoader> m_loader;
+    MeshCache m_cache;
+    CacheDirectory m_stamps;    // stamp key -> contents key
+
+    static bool contentKey(const std::string& filePath, Application::LoadProgress& progress,
+                           std::uint64_t& key);
+    static bool stampKey(const std::string& filePath, std::uint64_t& stamp);
+    bool findStamp(std::uint64_t stamp, std::uint64_t& key) const;
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // CACHINGSTLFILELOADER_H
@@ -1,15 +1,16 @@
 #include "CollisionVisualizer.h"
 #include "../core/domain/BuildPlate.h"
 #include <vtkProperty.h>
-#include <vtkActorCollection.h>
 #include <vtkRenderWindow.h>
 #include <set>
 
 namespace MarcSLM {
 namespace Infrastructure {
 
-CollisionVisualizer::CollisionVisualizer(vtkSmartPointer<vtkRenderer> renderer)
+CollisionVisualizer::CollisionVisualizer(vtkSmartPointer<vtkRenderer> renderer,
+                                         std::shared_ptr<const ActorRegistry> actors)
     : m_renderer(renderer)
+    , m_actors(std::move(actors))
 {
 }
 
@@ -20,35 +21,38 @@ void CollisionVisualizer::update(const Domain::BuildPlate* buildPlate,
         return;
     }
     
-    // Clear previous highlights
-    clearHighlights();
-    
-    // Detect collisions
     auto collisions = buildPlate->detectCollisions();
     m_collisionCount = static_cast<int>(collisions.size());
     
-    if (collisions.empty()) {
-        return;
-    }
-    
-    // Collect all colliding model IDs
-    std::set<int> collidingModelIds;
+    // Actors that should be red now
+    std::set<int> collidingActors;
     for (const auto& collision : collisions) {
-        collidingModelIds.insert(collision.first);
-        collidingModelIds.insert(collision.second);
+        for (int modelId : {collision.first, collision.second}) {
+            auto it = modelToActorMap.find(modelId);
+            if (it != modelToActorMap.end()) {
+                collidingActors.insert(it->second);
+            }
+        }
     }
     
-    // Highlight colliding actors in red
-    for (int modelId : collidingModelIds) {
-        auto it = modelToActorMap.find(modelId);
-        if (it != modelToActorMap.end()) {
-            highlightActor(it->second, 1.0, 0.0, 0.0);  // Red
-            m_highlightedActors.push_back(it->second);
+    // Recolour only the actors whose state changed since the last update
+    bool changed = false;
+    for (int actorId : m_highlightedActors) {
+        if (!collidingActors.count(actorId)) {
+            restoreActorColor(actorId);
+            changed = true;
         }
     }
+    for (int actorId : collidingActors) {
+        if (!m_highlightedActors.count(actorId)) {
+            highlightActor(actorId, 1.0, 0.0, 0.0);  // Red
+            changed = true;
+        }
+    }
+    m_highlightedActors = std::move(collidingActors);
     
     // Request render
-    if (m_renderer->GetRenderWindow()) {
+    if (changed && m_renderer->GetRenderWindow()) {
         m_renderer->GetRenderWindow()->Render();
     }
 }
@@ -82,26 +86,7 @@ void CollisionVisualizer::setEnabled(bool enabled)
 
 void CollisionVisualizer::highlightActor(int actorId, double r, double g, double b)
 {
-    if (!m_renderer) {
-        return;
-    }
-    
-    // Find actor in renderer
-    vtkActorCollection* actors = m_renderer->GetActors();
-    actors->InitTraversal();
-    
-    vtkActor* targetActor = nullptr;
-    int currentId = 0;
-    
-    for (vtkIdType i = 0; i < actors->GetNumberOfItems(); ++i) {
-        vtkActor* actor = actors->GetNextActor();
-        if (currentId == actorId) {
-            targetActor = actor;
-            break;
-        }
-        currentId++;
-    }
-    
+    vtkActor* targetActor = m_actors ? m_actors->find(actorId) : nullptr;
     if (!targetActor) {
         return;
     }
@@ -119,38 +104,21 @@ void CollisionVisualizer::highlightActor(int actorId, double r, double g, double
 void CollisionVisualizer::restoreActorColor(int actorId)
 {
     auto it = m_originalColors.find(actorId);
-    if (it == m_originalColors.end() || !m_renderer) {
+    if (it == m_originalColors.end()) {
         return;
     }
     
-    // Find actor in renderer
-    vtkActorCollection* actors = m_renderer->GetActors();
-    actors->InitTraversal();
-    
-    vtkActor* targetActor = nullptr;
-    int currentId = 0;
-    
-    for (vtkIdType i = 0; i < actors->GetNumberOfItems(); ++i) {
-        vtkActor* actor = actors->GetNextActor();
-        if (currentId == actorId) {
-            targetActor = actor;
-            break;
-        }
-        currentId++;
-    }
-    
-    if (!targetActor) {
-        return;
+    // An actor removed meanwhile has nothing left to restore
+    vtkActor* targetActor = m_actors ? m_actors->find(actorId) : nullptr;
+    if (targetActor) {
+        const auto& color = it->second;
+        targetActor->GetProperty()->SetColor(
+            std::get<0>(color),
+            std::get<1>(color),
+            std::get<2>(color)
+        );
     }
     
-    // Restore original color
-    const auto& color = it->second;
-    targetActor->GetProperty()->SetColor(
-        std::get<0>(color),
-        std::get<1>(color),
-        std::get<2>(color)
-    );
-    
     m_originalColors.erase(it);
 }
 
@@ -4,7 +4,10 @@
 #include <vtkSmartPointer.h>
 #include <vtkRenderer.h>
 #include <vtkActor.h>
+#include "ActorRegistry.h"
 #include <map>
+#include <memory>
+#include <set>
 #include <vector>
 
 namespace MarcSLM {
@@ -22,14 +25,27 @@ namespace Infrastructure {
  * - Highlights colliding models in red
  * - Shows collision count
  * - Updates dynamically as models move
+ * 
+ * update() only recolours actors whose collision state changed, so it
+ * can run on every drag step.
  */
 class CollisionVisualizer {
 public:
-    explicit CollisionVisualizer(vtkSmartPointer<vtkRenderer> renderer);
+    /**
+     * @param renderer Renderer whose window is redrawn after changes
+     * @param actors Model actors by actor id, usually
+     *        VtkModelRenderer::actorRegistry(); without it nothing is
+     *        highlighted
+     */
+    explicit CollisionVisualizer(vtkSmartPointer<vtkRenderer> renderer,
+                                 std::shared_ptr<const ActorRegistry> actors = nullptr);
     ~CollisionVisualizer() = default;
     
     /**
      * @brief Update collision visualization based on build plate state
+     * 
+     * Restores actors that stopped colliding, highlights the ones that
+     * started, and renders only if either happened.
      * @param buildPlate Domain object containing models
      * @param modelToActorMap Mapping from model ID to VTK actor ID
      */
@@ -54,6 +70,7 @@ public:
     
 private:
     vtkSmartPointer<vtkRenderer> m_renderer;  // Now owned/shared via smart pointer
+    std::shared_ptr<const ActorRegistry> m_actors;
     bool m_enabled = true;
     int m_collisionCount = 0;
     
@@ -61,7 +78,7 @@ private:
     std::map<int, std::tuple<double, double, double>> m_originalColors;
     
     // Currently highlighted actors
-    std::vector<int> m_highlightedActors;
+    std::set<int> m_highlightedActors;
     
     void highlightActor(int actorId, double r, double g, double b);
     void restoreActorColor(int actorId);
@@ -0,0 +1,116 @@
+#include "ContentHash.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+namespace {
+
+constexpr std::size_t BlockSize = 1 << 20;
+
+// Hashing runs at memory bandwidth; a few MiB per thread amortize start-up
+constexpr std::size_t MinBlocksPerWorker = 8;
+
+constexpr std::uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+constexpr std::uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr std::uint64_t Prime3 = 0x165667B19E3779F9ull;
+constexpr std::uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+
+inline std::uint64_t rotl(std::uint64_t v, int r) {
+    return (v << r) | (v >> (64 - r));
+}
+
+inline std::uint64_t load64(const char* p) {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint64_t mixRound(std::uint64_t acc, std::uint64_t input) {
+    acc += input * Prime2;
+    acc = rotl(acc, 31);
+    return acc * Prime1;
+}
+
+inline std::uint64_t avalanche(std::uint64_t h) {
+    h ^= h >> 33;
+    h *= Prime2;
+    h ^= h >> 29;
+    h *= Prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+std::uint64_t hashBlock(const char* p, std::size_t len) {
+    std::uint64_t lane[4] = {Prime1 + Prime2, Prime2, 0, 0 - Prime1};
+    const char* end = p + len;
+
+    while (end - p >= 32) {
+        lane[0] = mixRound(lane[0], load64(p));
+        lane[1] = mixRound(lane[1], load64(p + 8));
+        lane[2] = mixRound(lane[2], load64(p + 16));
+        lane[3] = mixRound(lane[3], load64(p + 24));
+        p += 32;
+    }
+
+    std::uint64_t h = rotl(lane[0], 1) + rotl(lane[1], 7) + rotl(lane[2], 12) + rotl(lane[3], 18);
+    h += static_cast<std::uint64_t>(len);
+
+    while (end - p >= 8) {
+        h ^= mixRound(0, load64(p));
+        h = rotl(h, 27) * Prime1 + Prime4;
+        p += 8;
+    }
+    while (p < end) {
+        h ^= static_cast<std::uint64_t>(static_cast<unsigned char>(*p)) * Prime3;
+        h = rotl(h, 11) * Prime1;
+        ++p;
+    }
+    return avalanche(h);
+}
+
+std::uint64_t hashBlocks(const char* data, std::size_t size, Application::LoadProgress* progress) {
+    const std::size_t blocks = (size + BlockSize - 1) / BlockSize;
+    std::vector<std::uint64_t> blockHashes(blocks);
+
+    parallelForChunks(blocks, MinBlocksPerWorker, [&](unsigned, std::size_t begin, std::size_t end) {
+        for (std::size_t b = begin; b < end; ++b) {
+            if (progress && progress->isCancelled()) {
+                return;
+            }
+            std::size_t offset = b * BlockSize;
+            std::size_t len = std::min(BlockSize, size - offset);
+            blockHashes[b] = hashBlock(data + offset, len);
+            if (progress) {
+                progress->addBytes(len);
+            }
+        }
+    });
+
+    std::uint64_t h = ContentHash::combine(Prime3, static_cast<std::uint64_t>(size));
+    for (std::uint64_t bh : blockHashes) {
+        h = ContentHash::combine(h, bh);
+    }
+    return h;
+}
+
+} // namespace
+
+std::uint64_t ContentHash::combine(std::uint64_t hash, std::uint64_t value) {
+    return avalanche(rotl(hash, 27) * Prime1 + value * Prime4);
+}
+
+std::uint64_t ContentHash::of(const char* data, std::size_t size) {
+    return hashBlocks(data, size, nullptr);
+}
+
+std::uint64_t ContentHash::of(const char* data, std::size_t size, Application::LoadProgress& progress) {
+    return hashBlocks(data, size, &progress);
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
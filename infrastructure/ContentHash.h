@@ -0,0 +1,40 @@
+#ifndef CONTENTHASH_H
+#define CONTENTHASH_H
+
+#include "../core/application/LoadProgress.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief Fast non-cryptographic 64-bit hash of file contents
+ *
+ * The data is cut into fixed 1 MiB blocks that are hashed on all cores
+ * (four independent multiply-rotate lanes per block) and the block hashes
+ * are folded in order. Because the block size is fixed the value does not
+ * depend on the number of threads. Good enough to tell files apart for
+ * caching; not meant to resist deliberate collisions.
+ */
+class ContentHash {
+public:
+    static std::uint64_t of(const char* data, std::size_t size);
+
+    /**
+     * @brief Same hash, adding each block to progress as it is done
+     *
+     * Stops between blocks once progress is cancelled; the value returned
+     * then is meaningless.
+     */
+    static std::uint64_t of(const char* data, std::size_t size, Application::LoadProgress& progress);
+
+    /// Fold another 64-bit value into a hash (e.g. a format version)
+    static std::uint64_t combine(std::uint64_t hash, std::uint64_t value);
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // CONTENTHASH_H
@@ -0,0 +1,256 @@
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <filesystem>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+MappedFile::MappedFile(const std::string& filePath) {
+    open(filePath);
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+    moveFrom(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        moveFrom(other);
+    }
+    return *this;
+}
+
+void MappedFile::moveFrom(MappedFile& other) noexcept {
+    m_data = other.m_data;
+    m_size = other.m_size;
+    m_open = other.m_open;
+    m_fileSize = other.m_fileSize;
+    m_rangeOffset = other.m_rangeOffset;
+    m_viewBase = other.m_viewBase;
+    m_viewSize = other.m_viewSize;
+#ifdef _WIN32
+    m_fileHandle = other.m_fileHandle;
+    m_mappingHandle = other.m_mappingHandle;
+    other.m_fileHandle = nullptr;
+    other.m_mappingHandle = nullptr;
+#else
+    m_fd = other.m_fd;
+    other.m_fd = -1;
+#endif
+    other.m_data = nullptr;
+    other.m_size = 0;
+    other.m_open = false;
+    other.m_fileSize = 0;
+    other.m_rangeOffset = 0;
+    other.m_viewBase = nullptr;
+    other.m_viewSize = 0;
+}
+
+bool MappedFile::open(const std::string& filePath) {
+    close();
+    if (!openHandle(filePath)) {
+        return false;
+    }
+
+    // Zero-length files cannot be mapped; treat them as empty mappings
+    if (m_fileSize == 0) {
+        return true;
+    }
+    if (!mapRange(0, static_cast<std::size_t>(m_fileSize))) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool MappedFile::openRanges(const std::string& filePath) {
+    close();
+    return openHandle(filePath);
+}
+
+bool MappedFile::mapRange(std::uint64_t offset, std::size_t length) {
+    if (!m_open) {
+        return false;
+    }
+    unmapView();
+
+    offset = std::min(offset, m_fileSize);
+    length = static_cast<std::size_t>(std::min<std::uint64_t>(length, m_fileSize - offset));
+    m_rangeOffset = offset;
+    if (length == 0) {
+        return true;
+    }
+
+    // Views must start on the platform's allocation boundary
+    const std::uint64_t viewOffset = offset - offset % viewAlignment();
+    const std::size_t viewSize = static_cast<std::size_t>(offset - viewOffset) + length;
+    const char* view = mapView(viewOffset, viewSize);
+    if (!view) {
+        return false;
+    }
+
+    m_viewBase = view;
+    m_viewSize = viewSize;
+    m_data = view + (offset - viewOffset);
+    m_size = length;
+    return true;
+}
+
+#ifdef _WIN32
+
+std::uint64_t MappedFile::viewAlignment() {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwAllocationGranularity;
+}
+
+bool MappedFile::openHandle(const std::string& filePath) {
+    // Paths arrive as UTF-8 (QString::toStdString); convert for the wide API
+    const std::wstring widePath = std::filesystem::u8path(filePath).wstring();
+
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                              nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    m_fileHandle = file;
+    m_fileSize = static_cast<std::uint64_t>(fileSize.QuadPart);
+    m_open = true;
+
+    // CreateFileMapping rejects zero-length files
+    if (m_fileSize == 0) {
+        return true;
+    }
+
+    // The mapping object commits no memory; views are mapped on demand
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        close();
+        return false;
+    }
+    m_mappingHandle = mapping;
+    return true;
+}
+
+const char* MappedFile::mapView(std::uint64_t offset, std::size_t size) {
+    return static_cast<const char*>(MapViewOfFile(static_cast<HANDLE>(m_mappingHandle), FILE_MAP_READ,
+                                                  static_cast<DWORD>(offset >> 32),
+                                                  static_cast<DWORD>(offset & 0xFFFFFFFFu),
+                                                  size));
+}
+
+void MappedFile::unmapView() {
+    if (m_viewBase) {
+        UnmapViewOfFile(m_viewBase);
+    }
+    m_viewBase = nullptr;
+    m_viewSize = 0;
+    m_data = nullptr;
+    m_size = 0;
+}
+
+void MappedFile::close() {
+    unmapView();
+    if (m_mappingHandle) {
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+    }
+    if (m_fileHandle) {
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    }
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+    m_fileSize = 0;
+    m_rangeOffset = 0;
+    m_open = false;
+}
+
+#else
+
+std::uint64_t MappedFile::viewAlignment() {
+    return static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+}
+
+bool MappedFile::openHandle(const std::string& filePath) {
+    int fd = ::open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    m_fd = fd;
+    m_fileSize = static_cast<std::uint64_t>(st.st_size);
+    m_open = true;
+    return true;
+}
+
+const char* MappedFile::mapView(std::uint64_t offset, std::size_t size) {
+    void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, m_fd, static_cast<off_t>(offset));
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+
+    // Parsers stream through the file front to back
+    ::madvise(addr, size, MADV_SEQUENTIAL);
+    return static_cast<const char*>(addr);
+}
+
+void MappedFile::unmapView() {
+    if (m_viewBase) {
+        ::munmap(const_cast<char*>(m_viewBase), m_viewSize);
+    }
+    m_viewBase = nullptr;
+    m_viewSize = 0;
+    m_data = nullptr;
+    m_size = 0;
+}
+
+void MappedFile::close() {
+    unmapView();
+    if (m_fd >= 0) {
+        ::close(m_fd);
+    }
+    m_fd = -1;
+    m_fileSize = 0;
+    m_rangeOffset = 0;
+    m_open = false;
+}
+
+#endif
+
+} // namespace Infrastructure
+} // namespace MarcSLM
@@ -0,0 +1,100 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief Read-only memory mapping of a file
+ *
+ * Maps a file into the address space so parsers can read records in
+ * place instead of copying them through std::ifstream. The OS page cache
+ * backs the mapping, so a file that was opened recently is served
+ * without touching the disk.
+ *
+ * Files larger than the memory one is willing to commit can instead be
+ * opened with openRanges() and walked window by window with mapRange();
+ * only the current window is mapped, so the resident set stays bounded no
+ * matter how large the file is.
+ *
+ * The mapping is released when the object is destroyed or close() is called.
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    explicit MappedFile(const std::string& filePath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Map a file read-only
+     * @param filePath Path to the file (UTF-8)
+     * @return true on success; an empty file maps successfully with size() == 0
+     */
+    bool open(const std::string& filePath);
+
+    /**
+     * @brief Open a file without mapping it; map windows with mapRange()
+     * @param filePath Path to the file (UTF-8)
+     */
+    bool openRanges(const std::string& filePath);
+
+    /**
+     * @brief Map [offset, offset + length) of a file opened with openRanges()
+     *
+     * Replaces the previously mapped window. The range is clamped to the
+     * end of the file; data() then points at the byte at offset.
+     * @return false if the file is not open for ranges or mapping failed
+     */
+    bool mapRange(std::uint64_t offset, std::size_t length);
+
+    /**
+     * @brief Release the mapping and the underlying file handle
+     */
+    void close();
+
+    bool isOpen() const { return m_open; }
+    const char* data() const { return m_data; }
+    std::size_t size() const { return m_size; }
+
+    /// Size of the whole file; equals size() unless opened with openRanges()
+    std::uint64_t fileSize() const { return m_fileSize; }
+
+    /// File offset of data(); 0 unless opened with openRanges()
+    std::uint64_t rangeOffset() const { return m_rangeOffset; }
+
+private:
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_open = false;
+    std::uint64_t m_fileSize = 0;
+    std::uint64_t m_rangeOffset = 0;
+    const char* m_viewBase = nullptr;  // mapped view, aligned down from m_data
+    std::size_t m_viewSize = 0;
+
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#else
+    int m_fd = -1;
+#endif
+
+    void moveFrom(MappedFile& other) noexcept;
+    bool openHandle(const std::string& filePath);
+    const char* mapView(std::uint64_t offset, std::size_t size);
+    void unmapView();
+    static std::uint64_t viewAlignment();
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // MAPPEDFILE_H
@@ -0,0 +1,107 @@
+#include "MeshCache.h"
+#include "MappedFile.h"
+
+#include <cstring>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+namespace {
+
+constexpr char Magic[8] = {'M', 'A', 'R', 'C', 'M', 'E', 'S', 'H'};
+constexpr std::uint32_t FormatVersion = 1;
+constexpr const char* EntryExtension = ".mesh";
+
+// Fixed-size, padding-free layout in native byte order (see CacheEntryPrefix)
+struct EntryHeader {
+    CacheEntryPrefix prefix;
+    std::uint64_t vertexCount;
+    std::uint64_t indexCount;
+    std::int64_t triangleCount;
+    double bounds[6];
+    double volume;
+    double surfaceArea;
+};
+static_assert(sizeof(EntryHeader) == 112, "EntryHeader must not contain padding");
+
+} // namespace
+
+MeshCache::MeshCache(std::string directory, std::uint64_t maxBytes)
+    : m_entries(std::move(directory), EntryExtension, maxBytes, 0)
+{
+}
+
+std::unique_ptr<Application::MeshData> MeshCache::find(std::uint64_t key) const {
+    MappedFile file;
+    if (!file.open(m_entries.entryPath(key)) || file.size() < sizeof(EntryHeader)) {
+        return nullptr;
+    }
+
+    EntryHeader header;
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (!header.prefix.matches(Magic, FormatVersion, key)) {
+        return nullptr;
+    }
+
+    const std::uint64_t vertexBytes = header.vertexCount * 3 * sizeof(float);
+    const std::uint64_t indexBytes = header.indexCount * sizeof(std::uint32_t);
+    if (file.size() != sizeof(EntryHeader) + vertexBytes + indexBytes ||
+        header.indexCount % 3 != 0) {
+        return nullptr;
+    }
+
+    auto mesh = std::make_shared<Domain::TriangleMesh>();
+    mesh->vertices.resize(header.vertexCount * 3);
+    mesh->indices.resize(header.indexCount);
+    const char* payload = file.data() + sizeof(EntryHeader);
+    std::memcpy(mesh->vertices.data(), payload, vertexBytes);
+    std::memcpy(mesh->indices.data(), payload + vertexBytes, indexBytes);
+    file.close();
+
+    // Reject corrupt entries rather than handing VTK out-of-range indices
+    for (std::uint32_t index : mesh->indices) {
+        if (index >= header.vertexCount) {
+            return nullptr;
+        }
+    }
+
+    m_entries.touch(key);
+
+    auto meshData = std::make_unique<Application::MeshData>();
+    meshData->bounds = Domain::BoundingBox(header.bounds[0], header.bounds[1],
+                                           header.bounds[2], header.bounds[3],
+                                           header.bounds[4], header.bounds[5]);
+    meshData->triangleCount = static_cast<int>(header.triangleCount);
+    meshData->volume = header.volume;
+    meshData->surfaceArea = header.surfaceArea;
+    meshData->mesh = std::move(mesh);
+    return meshData;
+}
+
+bool MeshCache::store(std::uint64_t key, const Application::MeshData& meshData) {
+    const Domain::TriangleMesh* mesh = meshData.mesh.get();
+    if (!mesh || mesh->empty()) {
+        return false;
+    }
+
+    EntryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    header.prefix = CacheEntryPrefix::make(Magic, FormatVersion, key);
+    header.vertexCount = mesh->vertexCount();
+    header.indexCount = mesh->indices.size();
+    header.triangleCount = meshData.triangleCount;
+    const Domain::BoundingBox& b = meshData.bounds;
+    const double bounds[6] = {b.minX, b.maxX, b.minY, b.maxY, b.minZ, b.maxZ};
+    std::memcpy(header.bounds, bounds, sizeof(bounds));
+    header.volume = meshData.volume;
+    header.surfaceArea = meshData.surfaceArea;
+
+    return m_entries.write(key, {
+        { &header, sizeof(header) },
+        { mesh->vertices.data(), mesh->vertices.size() * sizeof(float) },
+        { mesh->indices.data(), mesh->indices.size() * sizeof(std::uint32_t) },
+    });
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
@@ -0,0 +1,61 @@
+#ifndef MESHCACHE_H
+#define MESHCACHE_H
+
+#include "CacheDirectory.h"
+#include "../core/application/interfaces/IStlFileLoader.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief On-disk cache of indexed meshes and their MeshData metrics
+ *
+ * Each entry is one binary file named after its 64-bit key: a fixed header
+ * with the metrics followed by the raw vertex and index buffers, so a hit
+ * is a single mapping plus two bulk copies. Files are handled by
+ * CacheDirectory: written to a temporary file and renamed into place, so
+ * readers never see partial data, and kept below a byte budget by
+ * evicting the least recently used entries; a hit refreshes the entry.
+ *
+ * Entries do not carry nativeData; callers attach their own view.
+ */
+class MeshCache {
+public:
+    /**
+     * @param directory Cache directory (UTF-8); created on first store
+     * @param maxBytes Size budget for all entries together
+     */
+    MeshCache(std::string directory, std::uint64_t maxBytes);
+
+    /**
+     * @brief Look up an entry
+     * @return Metrics and mesh, or nullptr if absent or unreadable
+     */
+    std::unique_ptr<Application::MeshData> find(std::uint64_t key) const;
+
+    /**
+     * @brief Store an entry, evicting old ones once the budget is passed
+     * @return false if the mesh is missing or the entry could not be written
+     */
+    bool store(std::uint64_t key, const Application::MeshData& meshData);
+
+    /**
+     * @brief Remove least recently used entries until within budget
+     */
+    void evict() { m_entries.evict(); }
+
+    const std::string& directory() const { return m_entries.directory(); }
+    std::uint64_t maxBytes() const { return m_entries.maxBytes(); }
+
+private:
+    CacheDirectory m_entries;
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // MESHCACHE_H
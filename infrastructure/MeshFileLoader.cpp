@@ -0,0 +1,59 @@
+#include "MeshFileLoader.h"
+#include "NativeStlFileLoader.h"
+#include "ThreeMfFileLoader.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+std::shared_ptr<MeshFileLoader> MeshFileLoader::createDefault() {
+    auto loader = std::make_shared<MeshFileLoader>();
+    loader->setLoader(".stl", std::make_shared<NativeStlFileLoader>());
+    loader->setLoader(".3mf", std::make_shared<ThreeMfFileLoader>());
+    return loader;
+}
+
+std::string MeshFileLoader::extensionOf(const std::string& filePath) {
+    const std::size_t dot = filePath.find_last_of('.');
+    const std::size_t slash = filePath.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)) {
+        return std::string();
+    }
+    std::string ext = filePath.substr(dot);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return ext;
+}
+
+void MeshFileLoader::setLoader(const std::string& extension,
+                               std::shared_ptr<Application::IStlFileLoader> loader) {
+    m_loaders[extensionOf(extension)] = std::move(loader);
+}
+
+bool MeshFileLoader::supports(const std::string& filePath) const {
+    auto it = m_loaders.find(extensionOf(filePath));
+    return it != m_loaders.end() && it->second;
+}
+
+std::unique_ptr<Application::MeshData> MeshFileLoader::load(const std::string& filePath) {
+    auto it = m_loaders.find(extensionOf(filePath));
+    if (it == m_loaders.end() || !it->second) {
+        return nullptr;
+    }
+    return it->second->load(filePath);
+}
+
+std::unique_ptr<Application::MeshData> MeshFileLoader::loadWithProgress(
+    const std::string& filePath, Application::LoadProgress& progress) {
+    auto it = m_loaders.find(extensionOf(filePath));
+    if (it == m_loaders.end() || !it->second) {
+        return nullptr;
+    }
+    return it->second->loadWithProgress(filePath, progress);
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
@@ -0,0 +1,49 @@
+#ifndef MESHFILELOADER_H
+#define MESHFILELOADER_H
+
+#include "../core/application/interfaces/IStlFileLoader.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief IStlFileLoader that picks a format-specific loader by file extension
+ *
+ * Lets the application keep a single loader dependency while supporting
+ * several mesh formats. Extensions are matched case-insensitively.
+ */
+class MeshFileLoader : public Application::IStlFileLoader {
+public:
+    MeshFileLoader() = default;
+    ~MeshFileLoader() override = default;
+
+    /**
+     * @brief Create a loader for STL and 3MF with the native implementations
+     */
+    static std::shared_ptr<MeshFileLoader> createDefault();
+
+    /**
+     * @brief Register the loader for an extension such as ".stl"
+     */
+    void setLoader(const std::string& extension, std::shared_ptr<Application::IStlFileLoader> loader);
+
+    bool supports(const std::string& filePath) const;
+
+    std::unique_ptr<Application::MeshData> load(const std::string& filePath) override;
+    std::unique_ptr<Application::MeshData> loadWithProgress(const std::string& filePath,
+                                                            Application::LoadProgress& progress) override;
+
+private:
+    std::map<std::string, std::shared_ptr<Application::IStlFileLoader>> m_loaders;
+
+    static std::string extensionOf(const std::string& filePath);
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // MESHFILELOADER_H
@@ -0,0 +1,199 @@
+#include "MeshMetrics.h"
+#include "ParallelFor.h"
+#include "StlFacetReader.h"
+#include "StlTriangleStream.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+namespace {
+
+// A facet costs only a few dozen flops; smaller chunks are not worth a thread
+constexpr std::size_t MinFacetsPerWorker = 1 << 16;
+
+// Adds six times the signed tetrahedron volume (a . (b x c)) and twice the
+// triangle area (|(b - a) x (c - a)|); corners are relative to the reference.
+inline void accumulateTriangle(double ax, double ay, double az,
+                               double bx, double by, double bz,
+                               double cx, double cy, double cz,
+                               double& volume6, double& area2) {
+    volume6 += ax * (by * cz - bz * cy)
+             + ay * (bz * cx - bx * cz)
+             + az * (bx * cy - by * cx);
+
+    const double ux = bx - ax, uy = by - ay, uz = bz - az;
+    const double vx = cx - ax, vy = cy - ay, vz = cz - az;
+    const double nx = uy * vz - uz * vy;
+    const double ny = uz * vx - ux * vz;
+    const double nz = ux * vy - uy * vx;
+    area2 += std::sqrt(nx * nx + ny * ny + nz * nz);
+}
+
+} // namespace
+
+MeshMetrics::MeshMetrics(double refX, double refY, double refZ)
+    : m_ref{refX, refY, refZ}
+    , m_min{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::max()}
+    , m_max{std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+            std::numeric_limits<float>::lowest()}
+{
+}
+
+void MeshMetrics::addTriangles(const float* x, const float* y, const float* z,
+                               std::size_t facetCount) {
+    float minX = m_min[0], minY = m_min[1], minZ = m_min[2];
+    float maxX = m_max[0], maxY = m_max[1], maxZ = m_max[2];
+    double volume6 = 0.0;
+    double area2 = 0.0;
+
+    // Corners stay contiguous per axis, so the min/max sweeps and the
+    // per-facet arithmetic below vectorize without gathers.
+    const std::size_t corners = facetCount * 3;
+    for (std::size_t c = 0; c < corners; ++c) {
+        minX = std::min(minX, x[c]);
+        maxX = std::max(maxX, x[c]);
+        minY = std::min(minY, y[c]);
+        maxY = std::max(maxY, y[c]);
+        minZ = std::min(minZ, z[c]);
+        maxZ = std::max(maxZ, z[c]);
+    }
+
+    for (std::size_t i = 0; i < facetCount; ++i) {
+        const std::size_t c = 3 * i;
+        const double ax = x[c] - m_ref[0], ay = y[c] - m_ref[1], az = z[c] - m_ref[2];
+        const double bx = x[c + 1] - m_ref[0], by = y[c + 1] - m_ref[1], bz = z[c + 1] - m_ref[2];
+        const double cx = x[c + 2] - m_ref[0], cy = y[c + 2] - m_ref[1], cz = z[c + 2] - m_ref[2];
+        accumulateTriangle(ax, ay, az, bx, by, bz, cx, cy, cz, volume6, area2);
+    }
+
+    m_min[0] = minX; m_min[1] = minY; m_min[2] = minZ;
+    m_max[0] = maxX; m_max[1] = maxY; m_max[2] = maxZ;
+    m_triangles += facetCount;
+    m_volume6 += volume6;
+    m_area2 += area2;
+}
+
+void MeshMetrics::addIndexedTriangles(const float* vertices, const std::uint32_t* indices,
+                                      std::size_t triangleCount) {
+    double volume6 = 0.0;
+    double area2 = 0.0;
+
+    for (std::size_t t = 0; t < triangleCount; ++t) {
+        double corner[3][3];
+        for (int k = 0; k < 3; ++k) {
+            const float* v = vertices + 3 * static_cast<std::size_t>(indices[3 * t + k]);
+            for (int a = 0; a < 3; ++a) {
+                m_min[a] = std::min(m_min[a], v[a]);
+                m_max[a] = std::max(m_max[a], v[a]);
+                corner[k][a] = v[a] - m_ref[a];
+            }
+        }
+        accumulateTriangle(corner[0][0], corner[0][1], corner[0][2],
+                           corner[1][0], corner[1][1], corner[1][2],
+                           corner[2][0], corner[2][1], corner[2][2],
+                           volume6, area2);
+    }
+
+    m_triangles += triangleCount;
+    m_volume6 += volume6;
+    m_area2 += area2;
+}
+
+void MeshMetrics::merge(const MeshMetrics& other) {
+    for (int a = 0; a < 3; ++a) {
+        m_min[a] = std::min(m_min[a], other.m_min[a]);
+        m_max[a] = std::max(m_max[a], other.m_max[a]);
+    }
+    m_triangles += other.m_triangles;
+    m_volume6 += other.m_volume6;
+    m_area2 += other.m_area2;
+}
+
+void MeshMetrics::addFacets(const StlFacets& facets) {
+    const std::size_t count = facets.facetCount();
+    std::vector<MeshMetrics> partial(parallelWorkerCount(count, MinFacetsPerWorker),
+                                     MeshMetrics(m_ref[0], m_ref[1], m_ref[2]));
+    parallelForChunks(count, MinFacetsPerWorker, [&](unsigned w, std::size_t begin, std::size_t end) {
+        partial[w].addTriangles(facets.x.data() + 3 * begin,
+                                facets.y.data() + 3 * begin,
+                                facets.z.data() + 3 * begin,
+                                end - begin);
+    });
+
+    for (const MeshMetrics& p : partial) {
+        merge(p);
+    }
+}
+
+MeshMetrics MeshMetrics::compute(const StlFacets& facets) {
+    if (facets.facetCount() == 0) {
+        return MeshMetrics();
+    }
+
+    MeshMetrics total(facets.x[0], facets.y[0], facets.z[0]);
+    total.addFacets(facets);
+    return total;
+}
+
+MeshMetrics MeshMetrics::compute(StlTriangleStream& stream, Application::LoadProgress* progress) {
+    stream.rewind();
+    if (progress) {
+        progress->setTotalBytes(stream.fileSize());
+    }
+
+    StlFacets block;
+    MeshMetrics total;
+    bool first = true;
+    while (stream.next(block, progress)) {
+        if (first) {
+            total = MeshMetrics(block.x[0], block.y[0], block.z[0]);
+            first = false;
+        }
+        total.addFacets(block);
+    }
+    return total;
+}
+
+MeshMetrics MeshMetrics::compute(const Domain::TriangleMesh& mesh) {
+    const std::size_t count = mesh.triangleCount();
+    if (count == 0 || mesh.vertices.empty()) {
+        return MeshMetrics();
+    }
+
+    const double rx = mesh.vertices[0], ry = mesh.vertices[1], rz = mesh.vertices[2];
+    std::vector<MeshMetrics> partial(parallelWorkerCount(count, MinFacetsPerWorker),
+                                     MeshMetrics(rx, ry, rz));
+    parallelForChunks(count, MinFacetsPerWorker, [&](unsigned w, std::size_t begin, std::size_t end) {
+        partial[w].addIndexedTriangles(mesh.vertices.data(), mesh.indices.data() + 3 * begin,
+                                       end - begin);
+    });
+
+    MeshMetrics total(rx, ry, rz);
+    for (const MeshMetrics& p : partial) {
+        total.merge(p);
+    }
+    return total;
+}
+
+Domain::BoundingBox MeshMetrics::bounds() const {
+    if (m_triangles == 0) {
+        return Domain::BoundingBox();
+    }
+    return Domain::BoundingBox(m_min[0], m_max[0],
+                               m_min[1], m_max[1],
+                               m_min[2], m_max[2]);
+}
+
+double MeshMetrics::volume() const {
+    // Inverted (inward-facing) meshes integrate to a negative volume
+    return std::fabs(signedVolume());
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
@@ -0,0 +1,100 @@
+#ifndef MESHMETRICS_H
+#define MESHMETRICS_H
+
+#include "../core/application/LoadProgress.h"
+#include "../core/domain/BoundingBox.h"
+#include "../core/domain/TriangleMesh.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+struct StlFacets;
+class StlTriangleStream;
+
+/**
+ * @brief Bounds, triangle count, volume and surface area of a triangle soup
+ *
+ * Accumulates everything MeshData needs in a single traversal of the raw
+ * corner arrays. Volume uses the divergence theorem (sum of signed
+ * tetrahedra against a fixed reference point), which equals what
+ * vtkMassProperties reports for closed, consistently oriented meshes.
+ *
+ * Accumulators can be fed in pieces and merged; as long as every piece uses
+ * the same reference point the sums are identical to one pass over all data.
+ */
+class MeshMetrics {
+public:
+    /**
+     * @param refX, refY, refZ Reference point for the volume integral.
+     *        Choosing a point on the mesh keeps the products small and
+     *        the sum accurate for models far from the origin.
+     */
+    MeshMetrics(double refX = 0.0, double refY = 0.0, double refZ = 0.0);
+
+    /**
+     * @brief Add facetCount triangles; corner k of facet i is at 3 * i + k
+     */
+    void addTriangles(const float* x, const float* y, const float* z, std::size_t facetCount);
+
+    /**
+     * @brief Add triangleCount indexed triangles
+     * @param vertices Interleaved x, y, z
+     * @param indices Three vertex indices per triangle, all in range
+     */
+    void addIndexedTriangles(const float* vertices, const std::uint32_t* indices,
+                             std::size_t triangleCount);
+
+    /**
+     * @brief Add a whole facet block on all cores
+     *
+     * Per-chunk partial sums are merged in chunk order, so the result is
+     * the same on every run.
+     */
+    void addFacets(const StlFacets& facets);
+
+    /// Combine with an accumulator built against the same reference point
+    void merge(const MeshMetrics& other);
+
+    /**
+     * @brief Compute metrics for a whole facet set on all cores
+     *
+     * Per-chunk partial sums are merged in chunk order, so the result is
+     * the same on every run.
+     */
+    static MeshMetrics compute(const StlFacets& facets);
+    static MeshMetrics compute(const Domain::TriangleMesh& mesh);
+
+    /**
+     * @brief Compute metrics in one streaming pass over a file
+     *
+     * Rewinds the stream and consumes it block by block, so memory use is
+     * bounded by the stream's limit rather than the size of the mesh.
+     * If the stream stops early (read error or cancellation) the metrics
+     * cover only the facets read so far; check stream.atEnd().
+     * @param progress Optional; total is set to the file size
+     */
+    static MeshMetrics compute(StlTriangleStream& stream,
+                               Application::LoadProgress* progress = nullptr);
+
+    std::size_t triangleCount() const { return m_triangles; }
+    Domain::BoundingBox bounds() const;
+    double signedVolume() const { return m_volume6 / 6.0; }
+    double volume() const;
+    double surfaceArea() const { return m_area2 / 2.0; }
+
+private:
+    double m_ref[3];
+    float m_min[3];
+    float m_max[3];
+    std::size_t m_triangles = 0;
+    double m_volume6 = 0.0;  // six times the signed volume
+    double m_area2 = 0.0;    // twice the surface area
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // MESHMETRICS_H
@@ -0,0 +1,95 @@
+#include "NativeStlFileLoader.h"
+#include "MappedFile.h"
+#include "MeshMetrics.h"
+#include "StlFacetReader.h"
+#include "StlTriangleStream.h"
+#include "VertexWelder.h"
+#include "VtkMeshAdapter.h"
+
+#include <filesystem>
+#include <system_error>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+std::unique_ptr<Application::MeshData> NativeStlFileLoader::load(const std::string& filePath) {
+    Application::LoadProgress progress;
+    return loadWithProgress(filePath, progress);
+}
+
+std::unique_ptr<Application::MeshData> NativeStlFileLoader::loadWithProgress(
+    const std::string& filePath, Application::LoadProgress& progress) {
+    if (m_streamingThreshold > 0) {
+        std::error_code ec;
+        const std::uintmax_t size = std::filesystem::file_size(std::filesystem::u8path(filePath), ec);
+        if (!ec && size > m_streamingThreshold) {
+            return loadMetricsOnly(filePath, progress);
+        }
+    }
+
+    StlFacets facets;
+    {
+        MappedFile file;
+        if (progress.isCancelled() || !file.open(filePath)) {
+            return nullptr;
+        }
+        progress.setTotalBytes(file.size());
+
+        bool ok = StlFacetReader::isAscii(file.data(), file.size())
+            ? StlFacetReader::readAscii(file.data(), file.size(), facets, &progress)
+            : StlFacetReader::readBinary(file.data(), file.size(), facets, &progress);
+        if (!ok || facets.facetCount() == 0) {
+            return nullptr;
+        }
+    } // unmap before the heavier work below
+
+    if (progress.isCancelled()) {
+        return nullptr;
+    }
+    const MeshMetrics metrics = MeshMetrics::compute(facets);
+
+    auto mesh = std::make_shared<Domain::TriangleMesh>();
+    mesh->indices.resize(facets.x.size());
+    VertexWelder::weldSoup(facets.x.data(), facets.y.data(), facets.z.data(),
+                           facets.x.size(), WeldEpsilon,
+                           mesh->indices.data(), mesh->vertices);
+    if (progress.isCancelled()) {
+        return nullptr;
+    }
+
+    auto meshData = std::make_unique<Application::MeshData>();
+    meshData->bounds = metrics.bounds();
+    meshData->triangleCount = static_cast<int>(metrics.triangleCount());
+    meshData->volume = metrics.volume();
+    meshData->surfaceArea = metrics.surfaceArea();
+    meshData->mesh = mesh;
+    meshData->nativeData = VtkMeshAdapter::wrapNative(mesh);
+
+    progress.setBytesDone(progress.totalBytes());
+    return meshData;
+}
+
+std::unique_ptr<Application::MeshData> NativeStlFileLoader::loadMetricsOnly(
+    const std::string& filePath, Application::LoadProgress& progress) {
+    StlTriangleStream stream;
+    if (progress.isCancelled() || !stream.open(filePath)) {
+        return nullptr;
+    }
+
+    const MeshMetrics metrics = MeshMetrics::compute(stream, &progress);
+    if (!stream.atEnd() || progress.isCancelled() || metrics.triangleCount() == 0) {
+        return nullptr;
+    }
+
+    auto meshData = std::make_unique<Application::MeshData>();
+    meshData->bounds = metrics.bounds();
+    meshData->triangleCount = static_cast<int>(metrics.triangleCount());
+    meshData->volume = metrics.volume();
+    meshData->surfaceArea = metrics.surfaceArea();
+
+    progress.setBytesDone(progress.totalBytes());
+    return meshData;
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
@@ -0,0 +1,54 @@
+#ifndef NATIVESTLFILELOADER_H
+#define NATIVESTLFILELOADER_H
+
+#include "../core/application/interfaces/IStlFileLoader.h"
+
+#include <cstdint>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief STL file loader that does not go through VTK's reader and filters
+ *
+ * Maps the file, decodes the facets in place, computes bounds, triangle
+ * count, volume and surface area in one pass over the raw triangles and
+ * welds the corners into an indexed mesh. The resulting vtkPolyData views
+ * the mesh buffers directly (see VtkMeshAdapter), so no geometry is copied
+ * between loading and rendering.
+ *
+ * Files larger than the streaming threshold (multi-gigabyte lattice
+ * parts) would not fit in memory as facets plus an indexed mesh. They are
+ * read through StlTriangleStream instead, in bounded blocks, and yield
+ * the metrics only: the MeshData has bounds, triangle count, volume and
+ * surface area but no mesh or nativeData. The add-model use cases refuse
+ * such parts when rendering, reporting the file as too large to display.
+ */
+class NativeStlFileLoader : public Application::IStlFileLoader {
+public:
+    NativeStlFileLoader() = default;
+    ~NativeStlFileLoader() override = default;
+
+    std::unique_ptr<Application::MeshData> load(const std::string& filePath) override;
+    std::unique_ptr<Application::MeshData> loadWithProgress(const std::string& filePath,
+                                                            Application::LoadProgress& progress) override;
+
+    static constexpr std::uint64_t DefaultStreamingThreshold = std::uint64_t(2) << 30;
+
+    /// File size in bytes above which only metrics are loaded; 0 never streams
+    void setStreamingThreshold(std::uint64_t bytes) { m_streamingThreshold = bytes; }
+
+private:
+    std::uint64_t m_streamingThreshold = DefaultStreamingThreshold;
+
+    std::unique_ptr<Application::MeshData> loadMetricsOnly(const std::string& filePath,
+                                                           Application::LoadProgress& progress);
+
+    // Same exact-match merging vtkSTLReader applies by default
+    static constexpr float WeldEpsilon = 0.0f;
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // NATIVESTLFILELOADER_H
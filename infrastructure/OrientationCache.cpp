@@ -0,0 +1,75 @@
+#include "OrientationCache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace fs = std::filesystem;
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+namespace {
+
+constexpr char Magic[8] = {'M', 'A', 'R', 'C', 'O', 'R', 'N', 'T'};
+constexpr std::uint32_t FormatVersion = 1;
+constexpr const char* EntryExtension = ".orient";
+constexpr std::uint32_t MaxOrientations = 64;
+
+// The header is the shared prefix alone, its value holding the count
+static_assert(sizeof(CachedOrientation) == 4 * sizeof(double), "CachedOrientation must not contain padding");
+
+} // namespace
+
+OrientationCache::OrientationCache(std::string directory, std::size_t maxEntries)
+    : m_entries(std::move(directory), EntryExtension, 0, std::max<std::size_t>(1, maxEntries))
+{
+}
+
+std::vector<CachedOrientation> OrientationCache::find(std::uint64_t key) const {
+    std::vector<CachedOrientation> orientations;
+
+    std::ifstream in(fs::u8path(m_entries.entryPath(key)), std::ios::binary);
+    if (!in) {
+        return orientations;
+    }
+    const std::vector<char> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    if (bytes.size() < sizeof(CacheEntryPrefix)) {
+        return orientations;
+    }
+
+    CacheEntryPrefix header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (!header.matches(Magic, FormatVersion, key) ||
+        header.value == 0 || header.value > MaxOrientations ||
+        bytes.size() != sizeof(CacheEntryPrefix) + header.value * sizeof(CachedOrientation)) {
+        return orientations;
+    }
+
+    orientations.resize(header.value);
+    std::memcpy(orientations.data(), bytes.data() + sizeof(CacheEntryPrefix),
+                header.value * sizeof(CachedOrientation));
+
+    m_entries.touch(key);
+    return orientations;
+}
+
+bool OrientationCache::store(std::uint64_t key, const std::vector<CachedOrientation>& orientations) {
+    if (orientations.empty()) {
+        return false;
+    }
+
+    const std::uint32_t count = static_cast<std::uint32_t>(
+        std::min<std::size_t>(orientations.size(), MaxOrientations));
+    const CacheEntryPrefix header = CacheEntryPrefix::make(Magic, FormatVersion, key, count);
+    return m_entries.write(key, {
+        { &header, sizeof(header) },
+        { orientations.data(), count * sizeof(CachedOrientation) },
+    });
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
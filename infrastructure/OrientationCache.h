@@ -0,0 +1,73 @@
+#ifndef ORIENTATIONCACHE_H
+#define ORIENTATIONCACHE_H
+
+#include "CacheDirectory.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief One orientation found for a part, angles in degrees
+ */
+struct CachedOrientation {
+    double roll = 0.0;
+    double pitch = 0.0;
+    double yaw = 0.0;
+    double score = 0.0;
+};
+
+/**
+ * @brief On-disk cache of orientation search results
+ *
+ * Each entry is one small binary file named after its 64-bit key, holding
+ * the best orientation followed by the alternatives the search found, best
+ * first. Callers build the key from everything the result depends on
+ * (mesh contents, threshold, weights, search settings). Files are handled
+ * by CacheDirectory, like MeshCache's: at most maxEntries are kept,
+ * dropping the least recently used first, and a hit refreshes the entry.
+ */
+class OrientationCache {
+public:
+    /// Default entry limit; an entry is a few hundred bytes
+    static constexpr std::size_t DefaultMaxEntries = 10000;
+
+    /**
+     * @param directory Cache directory (UTF-8); created on first store
+     */
+    explicit OrientationCache(std::string directory, std::size_t maxEntries = DefaultMaxEntries);
+
+    /**
+     * @brief Look up an entry
+     * @return Orientations, best first; empty if absent or unreadable
+     */
+    std::vector<CachedOrientation> find(std::uint64_t key) const;
+
+    /**
+     * @brief Store an entry
+     *
+     * Scans the directory only once the stores take it past the limit
+     * (see CacheDirectory), so a store is normally a single file write.
+     * @return false if orientations is empty or the entry could not be written
+     */
+    bool store(std::uint64_t key, const std::vector<CachedOrientation>& orientations);
+
+    /**
+     * @brief Remove least recently used entries until within the limit
+     */
+    void evict() { m_entries.evict(); }
+
+    const std::string& directory() const { return m_entries.directory(); }
+
+private:
+    CacheDirectory m_entries;
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // ORIENTATIONCACHE_H
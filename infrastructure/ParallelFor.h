@@ -0,0 +1,19 @@
+#ifndef PARALLELFOR_H
+#define PARALLELFOR_H
+
+#include "../core/domain/ParallelFor.h"
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+// The parallel loop lives in the domain layer so core code can use it too
+using Domain::ParallelWorkerShare;
+using Domain::ScopedParallelWorkerLimit;
+using Domain::parallelWorkerLimit;
+using Domain::parallelWorkerCount;
+using Domain::parallelForChunks;
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // PARALLELFOR_H
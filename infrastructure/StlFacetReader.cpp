@@ -0,0 +1,294 @@
+#include "StlFacetReader.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+namespace {
+
+// Below this many facets the thread start-up cost dominates decoding
+constexpr std::size_t MinFacetsPerWorker = 1 << 16;
+
+// ASCII facets are ~250 bytes; 1 MB per worker keeps chunks worth a thread
+constexpr std::size_t MinAsciiBytesPerWorker = 1 << 20;
+
+// Granularity of progress reports and cancellation checks
+constexpr std::size_t ProgressFacets = 1 << 14;
+constexpr std::size_t ProgressBytes = 1 << 22;
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+}
+
+inline const char* skipSpace(const char* p, const char* end) {
+    while (p < end && isSpace(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+inline const char* tokenEnd(const char* p, const char* end) {
+    while (p < end && !isSpace(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+inline const char* skipLine(const char* p, const char* end) {
+    while (p < end && *p != '\n') {
+        ++p;
+    }
+    return p;
+}
+
+// Locale-independent float parse; malformed numbers read as 0 and are skipped
+const char* parseFloat(const char* p, const char* end, float& out) {
+    p = skipSpace(p, end);
+    if (p < end && *p == '+') {
+        ++p;
+    }
+    auto res = std::from_chars(p, end, out);
+    if (res.ec == std::errc::invalid_argument) {
+        out = 0.0f;
+        return tokenEnd(p, end);
+    }
+    if (res.ec == std::errc::result_out_of_range) {
+        out = 0.0f;
+    }
+    return res.ptr;
+}
+
+// First "facet" keyword at or after pos that starts a token ("endfacet" does not)
+std::size_t nextFacetStart(std::string_view text, std::size_t pos) {
+    while ((pos = text.find("facet", pos)) != std::string_view::npos) {
+        bool startsToken = pos == 0 || isSpace(text[pos - 1]);
+        bool endsToken = pos + 5 < text.size() && isSpace(text[pos + 5]);
+        if (startsToken && endsToken) {
+            return pos;
+        }
+        pos += 5;
+    }
+    return text.size();
+}
+
+} // namespace
+
+std::uint64_t StlFacetReader::binaryFacetCount(const char* header, std::uint64_t fileSize) {
+    std::uint32_t declared = 0;
+    std::memcpy(&declared, header + HeaderSize, sizeof(declared));
+
+    std::uint64_t available = (fileSize - HeaderSize - CountSize) / RecordSize;
+    return (declared == 0 || declared > available) ? available : declared;
+}
+
+bool StlFacetReader::isAscii(const char* data, std::size_t size) {
+    return isAscii(data, size, size);
+}
+
+bool StlFacetReader::isAscii(const char* head, std::size_t headSize, std::uint64_t fileSize) {
+    if (!head || headSize < 5 || fileSize < 5) {
+        return false;
+    }
+
+    // A binary file is exactly header + count + records; some exporters
+    // still write "solid" into the binary header.
+    if (headSize >= HeaderSize + CountSize) {
+        std::uint32_t declared = 0;
+        std::memcpy(&declared, head + HeaderSize, sizeof(declared));
+        if (HeaderSize + CountSize + static_cast<std::uint64_t>(declared) * RecordSize == fileSize) {
+            return false;
+        }
+    }
+
+    std::size_t pos = 0;
+    while (pos < headSize && std::isspace(static_cast<unsigned char>(head[pos]))) {
+        ++pos;
+    }
+    return headSize - pos >= 5 && std::memcmp(head + pos, "solid", 5) == 0;
+}
+
+bool StlFacetReader::readBinary(const char* data, std::size_t size, StlFacets& facets,
+                                Application::LoadProgress* progress) {
+    if (!data || size < HeaderSize + CountSize) {
+        facets.clear();
+        return false;
+    }
+
+    const std::size_t count = static_cast<std::size_t>(binaryFacetCount(data, size));
+    return readBinaryRecords(data + HeaderSize + CountSize, count, facets, progress);
+}
+
+bool StlFacetReader::readBinaryRecords(const char* records, std::size_t count, StlFacets& facets,
+                                       Application::LoadProgress* progress) {
+    facets.resize(count);
+
+    float* x = facets.x.data();
+    float* y = facets.y.data();
+    float* z = facets.z.data();
+    float* nx = facets.nx.data();
+    float* ny = facets.ny.data();
+    float* nz = facets.nz.data();
+
+    // Records are 50 bytes and therefore not float-aligned; one 48-byte
+    // memcpy per record compiles to plain unaligned loads. STL is
+    // little-endian, as are all supported targets.
+    parallelForChunks(count, MinFacetsPerWorker,
+        [=](unsigned, std::size_t begin, std::size_t end) {
+            float rec[12];
+            std::size_t reported = begin;
+            for (std::size_t i = begin; i < end; ++i) {
+                if (progress && i - reported == ProgressFacets) {
+                    progress->addBytes(ProgressFacets * RecordSize);
+                    reported = i;
+                    if (progress->isCancelled()) {
+                        return;
+                    }
+                }
+                std::memcpy(rec, records + i * RecordSize, sizeof(rec));
+                nx[i] = rec[0];
+                ny[i] = rec[1];
+                nz[i] = rec[2];
+                x[3 * i + 0] = rec[3];
+                y[3 * i + 0] = rec[4];
+                z[3 * i + 0] = rec[5];
+                x[3 * i + 1] = rec[6];
+                y[3 * i + 1] = rec[7];
+                z[3 * i + 1] = rec[8];
+                x[3 * i + 2] = rec[9];
+                y[3 * i + 2] = rec[10];
+                z[3 * i + 2] = rec[11];
+            }
+            if (progress) {
+                progress->addBytes((end - reported) * RecordSize);
+            }
+        });
+
+    return !(progress && progress->isCancelled());
+}
+
+void StlFacetReader::parseAsciiRange(const char* begin, const char* end, StlFacets& facets,
+                                     Application::LoadProgress* progress) {
+    float normal[3] = {0.0f, 0.0f, 0.0f};
+    float corners[9];
+    int corner = 0;
+
+    const char* p = begin;
+    const char* reported = begin;
+    while ((p = skipSpace(p, end)) < end) {
+        if (progress && static_cast<std::size_t>(p - reported) >= ProgressBytes) {
+            progress->addBytes(static_cast<std::size_t>(p - reported));
+            reported = p;
+            if (progress->isCancelled()) {
+                return;
+            }
+        }
+
+        const char* q = tokenEnd(p, end);
+        std::string_view token(p, static_cast<std::size_t>(q - p));
+        p = q;
+
+        if (token == "vertex") {
+            p = parseFloat(p, end, corners[3 * corner + 0]);
+            p = parseFloat(p, end, corners[3 * corner + 1]);
+            p = parseFloat(p, end, corners[3 * corner + 2]);
+            if (++corner == 3) {
+                facets.nx.push_back(normal[0]);
+                facets.ny.push_back(normal[1]);
+                facets.nz.push_back(normal[2]);
+                for (int k = 0; k < 3; ++k) {
+                    facets.x.push_back(corners[3 * k + 0]);
+                    facets.y.push_back(corners[3 * k + 1]);
+                    facets.z.push_back(corners[3 * k + 2]);
+                }
+                corner = 0;
+            }
+        } else if (token == "facet") {
+            corner = 0;
+            p = skipSpace(p, end);
+            q = tokenEnd(p, end);
+            if (std::string_view(p, static_cast<std::size_t>(q - p)) == "normal") {
+                p = parseFloat(q, end, normal[0]);
+                p = parseFloat(p, end, normal[1]);
+                p = parseFloat(p, end, normal[2]);
+            }
+        } else if (token == "solid" || token == "endsolid") {
+            // Solid names are free text and may contain keywords
+            p = skipLine(p, end);
+        }
+        // outer, loop, endloop, endfacet carry no data
+    }
+
+    if (progress) {
+        progress->addBytes(static_cast<std::size_t>(end - reported));
+    }
+}
+
+bool StlFacetReader::readAscii(const char* data, std::size_t size, StlFacets& facets,
+                               Application::LoadProgress* progress) {
+    facets.clear();
+    if (!data || size == 0) {
+        return false;
+    }
+
+    // Chunk boundaries always sit on a "facet" keyword so no facet is split
+    const std::string_view text(data, size);
+    const unsigned wanted = parallelWorkerCount(size, MinAsciiBytesPerWorker);
+    std::vector<std::size_t> bounds{0};
+    for (unsigned w = 1; w < wanted; ++w) {
+        std::size_t cut = nextFacetStart(text, size / wanted * w);
+        if (cut > bounds.back() && cut < size) {
+            bounds.push_back(cut);
+        }
+    }
+    bounds.push_back(size);
+
+    const std::size_t chunkCount = bounds.size() - 1;
+    std::vector<StlFacets> parts(chunkCount);
+    parallelForChunks(chunkCount, 1, [&](unsigned, std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+            // Exporters write roughly 200-250 bytes per facet
+            std::size_t guess = (bounds[c + 1] - bounds[c]) / 200;
+            parts[c].nx.reserve(guess);
+            parts[c].ny.reserve(guess);
+            parts[c].nz.reserve(guess);
+            parts[c].x.reserve(guess * 3);
+            parts[c].y.reserve(guess * 3);
+            parts[c].z.reserve(guess * 3);
+            parseAsciiRange(data + bounds[c], data + bounds[c + 1], parts[c], progress);
+        }
+    });
+    if (progress && progress->isCancelled()) {
+        return false;
+    }
+
+    // Concatenate in file order
+    std::vector<std::size_t> offsets(chunkCount + 1, 0);
+    for (std::size_t c = 0; c < chunkCount; ++c) {
+        offsets[c + 1] = offsets[c] + parts[c].facetCount();
+    }
+    facets.resize(offsets.back());
+
+    parallelForChunks(chunkCount, 1, [&](unsigned, std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+            const StlFacets& part = parts[c];
+            const std::size_t f = offsets[c];
+            std::copy(part.nx.begin(), part.nx.end(), facets.nx.begin() + f);
+            std::copy(part.ny.begin(), part.ny.end(), facets.ny.begin() + f);
+            std::copy(part.nz.begin(), part.nz.end(), facets.nz.begin() + f);
+            std::copy(part.x.begin(), part.x.end(), facets.x.begin() + 3 * f);
+            std::copy(part.y.begin(), part.y.end(), facets.y.begin() + 3 * f);
+            std::copy(part.z.begin(), part.z.end(), facets.z.begin() + 3 * f);
+        }
+    });
+
+    return facets.facetCount() > 0;
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
@@ -0,0 +1,127 @@
+#ifndef STLFACETREADER_H
+#define STLFACETREADER_H
+
+#include "../core/application/LoadProgress.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief Raw (unindexed) STL triangles in structure-of-arrays layout
+ *
+ * Corner k (0..2) of facet i is stored at index 3 * i + k of x/y/z.
+ * Facet normals are stored once per facet, exactly as written in the file.
+ */
+struct StlFacets {
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+    std::vector<float> nx;
+    std::vector<float> ny;
+    std::vector<float> nz;
+
+    std::size_t facetCount() const { return nx.size(); }
+
+    void resize(std::size_t facets) {
+        x.resize(facets * 3);
+        y.resize(facets * 3);
+        z.resize(facets * 3);
+        nx.resize(facets);
+        ny.resize(facets);
+        nz.resize(facets);
+    }
+
+    void clear() {
+        resize(0);
+    }
+};
+
+/**
+ * @brief Decodes STL file contents that are already in memory
+ *
+ * Works on a raw byte range (typically a MappedFile) so records are read
+ * in place; no stream or per-triangle allocation is involved.
+ */
+class StlFacetReader {
+public:
+    static constexpr std::size_t HeaderSize = 80;
+    static constexpr std::size_t CountSize = 4;
+    static constexpr std::size_t RecordSize = 50;  // normal + 3 vertices + attribute word
+
+    /**
+     * @brief Decide whether the data is an ASCII STL
+     *
+     * Binary files whose header happens to start with "solid" are detected
+     * by their size matching the declared facet count.
+     */
+    static bool isAscii(const char* data, std::size_t size);
+
+    /**
+     * @brief Same as isAscii() when only the start of the file is at hand
+     * @param head First headSize bytes of the file (a few KB is plenty)
+     * @param fileSize Size of the whole file
+     */
+    static bool isAscii(const char* head, std::size_t headSize, std::uint64_t fileSize);
+
+    /**
+     * @brief Number of complete binary records in a file
+     *
+     * The header count, unless it is zero or larger than the file can hold.
+     * @param header At least HeaderSize + CountSize bytes
+     */
+    static std::uint64_t binaryFacetCount(const char* header, std::uint64_t fileSize);
+
+    /**
+     * @brief Decode a binary STL into facets
+     *
+     * If the header count disagrees with the file length (truncated files or
+     * exporters that leave the count at zero) the number of complete records
+     * actually present is used. Large files are decoded on all cores.
+     *
+     * @param progress Optional; receives decoded bytes and is polled for
+     *        cancellation between blocks of records
+     * @return false if the data is too short to hold a binary STL header,
+     *         or the load was cancelled
+     */
+    static bool readBinary(const char* data, std::size_t size, StlFacets& facets,
+                           Application::LoadProgress* progress = nullptr);
+
+    /**
+     * @brief Decode count consecutive 50-byte binary records
+     *
+     * The building block of readBinary(), for callers that walk a file in
+     * windows. facets is resized to count.
+     * @return false if the load was cancelled
+     */
+    static bool readBinaryRecords(const char* records, std::size_t count, StlFacets& facets,
+                                  Application::LoadProgress* progress = nullptr);
+
+    /**
+     * @brief Decode an ASCII STL into facets
+     *
+     * The text is split on facet boundaries and the chunks are tokenized
+     * in parallel with locale-independent std::from_chars. Chunk results are
+     * concatenated in file order, so the output matches a sequential parse.
+     * Every three "vertex" lines form a triangle carrying the normal of the
+     * enclosing "facet normal" line.
+     *
+     * @param progress Optional; receives parsed bytes and is polled for
+     *        cancellation while tokenizing
+     * @return false if no facet could be parsed or the load was cancelled
+     */
+    static bool readAscii(const char* data, std::size_t size, StlFacets& facets,
+                          Application::LoadProgress* progress = nullptr);
+
+private:
+    static void parseAsciiRange(const char* begin, const char* end, StlFacets& facets,
+                                Application::LoadProgress* progress);
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // STLFACETREADER_H
@@ -0,0 +1,155 @@
+#include "StlTriangleStream.h"
+
+#include <algorithm>
+#include <string_view>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+namespace {
+
+// Decoded size of one facet in StlFacets: 9 corner and 3 normal floats
+constexpr std::size_t DecodedFacetBytes = 12 * sizeof(float);
+
+// Enough of the file to recognise the format
+constexpr std::size_t HeadBytes = 4096;
+
+// Below this a window no longer amortises the cost of remapping
+constexpr std::size_t MinWindowBytes = std::size_t(1) << 16;
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+}
+
+// Last "facet" keyword in text that starts a token ("endfacet" does not);
+// 0 if there is none after the first byte
+std::size_t lastFacetStart(std::string_view text) {
+    std::size_t pos = text.size();
+    while (pos > 0 && (pos = text.rfind("facet", pos - 1)) != std::string_view::npos) {
+        bool startsToken = pos == 0 || isSpace(text[pos - 1]);
+        bool endsToken = pos + 5 < text.size() && isSpace(text[pos + 5]);
+        if (startsToken && endsToken) {
+            return pos;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+bool StlTriangleStream::open(const std::string& filePath, std::size_t memoryLimit) {
+    close();
+    if (!m_file.openRanges(filePath)) {
+        return false;
+    }
+
+    const std::uint64_t size = m_file.fileSize();
+    if (!m_file.mapRange(0, HeadBytes) || m_file.size() == 0) {
+        close();
+        return false;
+    }
+
+    m_ascii = StlFacetReader::isAscii(m_file.data(), m_file.size(), size);
+    if (m_ascii) {
+        // Decoded facets take up to ~0.6x the text they came from, and the
+        // parser briefly holds two copies; a quarter of the limit for the
+        // window leaves room for both.
+        m_windowBytes = std::max(memoryLimit / 4, MinWindowBytes);
+        m_end = size;
+    } else {
+        if (m_file.size() < StlFacetReader::HeaderSize + StlFacetReader::CountSize) {
+            close();
+            return false;
+        }
+        m_facetCount = StlFacetReader::binaryFacetCount(m_file.data(), size);
+        m_blockFacets = std::max<std::size_t>(
+            memoryLimit / (StlFacetReader::RecordSize + DecodedFacetBytes), 1);
+        m_end = m_facetCount;
+    }
+
+    m_file.mapRange(0, 0);
+    m_position = 0;
+    return true;
+}
+
+void StlTriangleStream::close() {
+    m_file.close();
+    m_ascii = false;
+    m_facetCount = 0;
+    m_position = 0;
+    m_end = 0;
+    m_blockFacets = 0;
+    m_windowBytes = 0;
+}
+
+void StlTriangleStream::rewind() {
+    m_position = 0;
+}
+
+bool StlTriangleStream::next(StlFacets& block, Application::LoadProgress* progress) {
+    block.clear();
+    if (!isOpen() || atEnd()) {
+        m_file.mapRange(0, 0);
+        return false;
+    }
+    if (progress && progress->isCancelled()) {
+        return false;
+    }
+    return m_ascii ? nextAscii(block, progress) : nextBinary(block, progress);
+}
+
+bool StlTriangleStream::nextBinary(StlFacets& block, Application::LoadProgress* progress) {
+    const std::size_t count = static_cast<std::size_t>(
+        std::min<std::uint64_t>(m_blockFacets, m_end - m_position));
+    const std::uint64_t offset = StlFacetReader::HeaderSize + StlFacetReader::CountSize +
+                                 m_position * StlFacetReader::RecordSize;
+
+    if (!m_file.mapRange(offset, count * StlFacetReader::RecordSize) ||
+        m_file.size() != count * StlFacetReader::RecordSize) {
+        return false;
+    }
+    if (!StlFacetReader::readBinaryRecords(m_file.data(), count, block, progress)) {
+        block.clear();
+        return false;
+    }
+
+    if (progress && m_position == 0) {
+        progress->addBytes(StlFacetReader::HeaderSize + StlFacetReader::CountSize);
+    }
+    m_position += count;
+    return true;
+}
+
+bool StlTriangleStream::nextAscii(StlFacets& block, Application::LoadProgress* progress) {
+    // Windows holding no facet (e.g. only "endsolid") are skipped
+    while (!atEnd()) {
+        if (!m_file.mapRange(m_position, m_windowBytes)) {
+            return false;
+        }
+        const std::string_view text(m_file.data(), m_file.size());
+
+        // Stop before the last facet that may continue past the window
+        std::size_t length = text.size();
+        if (m_position + length < m_end) {
+            length = lastFacetStart(text);
+            if (length == 0) {
+                return false;  // a single facet larger than the window
+            }
+        }
+
+        StlFacetReader::readAscii(text.data(), length, block, progress);
+        if (progress && progress->isCancelled()) {
+            block.clear();
+            return false;
+        }
+        m_position += length;
+        if (block.facetCount() > 0) {
+            return true;
+        }
+    }
+    m_file.mapRange(0, 0);
+    return false;
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
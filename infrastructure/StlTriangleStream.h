@@ -0,0 +1,97 @@
+#ifndef STLTRIANGLESTREAM_H
+#define STLTRIANGLESTREAM_H
+
+#include "MappedFile.h"
+#include "StlFacetReader.h"
+#include "../core/application/LoadProgress.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief Walks the triangles of an STL file in bounded blocks
+ *
+ * For files too large to hold in memory (multi-gigabyte lattice parts).
+ * Only one window of the file is mapped at a time and triangles are
+ * decoded into a caller-owned StlFacets block that is reused from call to
+ * call, so memory use stays under the limit given to open() regardless of
+ * file size. Consumers (metrics, slicing) make one pass with next():
+ *
+ * @code
+ * StlTriangleStream stream;
+ * StlFacets block;
+ * if (stream.open(path)) {
+ *     while (stream.next(block)) {
+ *         consume(block);
+ *     }
+ * }
+ * @endcode
+ *
+ * Blocks are delivered in file order and contain whole facets only.
+ * Binary files are cut at record boundaries; ASCII files at "facet"
+ * keywords, so every block decodes exactly as in a full-file parse.
+ */
+class StlTriangleStream {
+public:
+    static constexpr std::size_t DefaultMemoryLimit = std::size_t(256) << 20;
+
+    StlTriangleStream() = default;
+
+    StlTriangleStream(const StlTriangleStream&) = delete;
+    StlTriangleStream& operator=(const StlTriangleStream&) = delete;
+
+    /**
+     * @brief Open a file for streaming
+     * @param memoryLimit Upper bound in bytes for the mapped window plus
+     *        the decoded block together
+     * @return false if the file cannot be opened or is not an STL
+     */
+    bool open(const std::string& filePath, std::size_t memoryLimit = DefaultMemoryLimit);
+    void close();
+
+    bool isOpen() const { return m_file.isOpen(); }
+    bool isAscii() const { return m_ascii; }
+    std::uint64_t fileSize() const { return m_file.fileSize(); }
+
+    /// Facets in a binary file; 0 for ASCII, where the count is only known at the end
+    std::uint64_t triangleCount() const { return m_ascii ? 0 : m_facetCount; }
+
+    /// Largest number of facets next() puts into one block
+    std::size_t blockCapacity() const { return m_blockFacets; }
+
+    /**
+     * @brief Decode the next block of facets
+     * @param block Receives the facets; reuse it across calls to keep its storage
+     * @param progress Optional; receives decoded bytes and is polled for cancellation
+     * @return false at the end of the file, on a read error or on cancellation;
+     *         atEnd() tells the first case apart
+     */
+    bool next(StlFacets& block, Application::LoadProgress* progress = nullptr);
+
+    /// True once every facet of the file has been delivered
+    bool atEnd() const { return m_position >= m_end; }
+
+    /// Start over from the first facet
+    void rewind();
+
+private:
+    MappedFile m_file;
+    bool m_ascii = false;
+    std::uint64_t m_facetCount = 0;   // binary only
+    std::uint64_t m_position = 0;     // binary: next facet; ASCII: next byte
+    std::uint64_t m_end = 0;          // binary: facet count; ASCII: file size
+    std::size_t m_blockFacets = 0;    // binary facets per block
+    std::size_t m_windowBytes = 0;    // ASCII bytes per window
+
+    bool nextBinary(StlFacets& block, Application::LoadProgress* progress);
+    bool nextAscii(StlFacets& block, Application::LoadProgress* progress);
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // STLTRIANGLESTREAM_H
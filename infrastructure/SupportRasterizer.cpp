@@ -0,0 +1,309 @@
+#include "SupportRasterizer.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+namespace {
+
+constexpr std::size_t MinVerticesPerWorker = 1 << 16;
+constexpr std::size_t MinTrianglesPerWorker = 1 << 14;
+constexpr std::size_t MinTilesPerWorker = 4;
+
+constexpr int TileSize = 32;              // cells per tile side
+constexpr std::int64_t SubCells = 256;    // fixed-point steps per cell
+constexpr std::int64_t HalfCell = SubCells / 2;
+
+// Same tolerance as Domain::FaceNormals, so both agree on which faces
+// need support
+constexpr double ThresholdTolerance = 1e-5;
+
+enum FaceKind : std::uint8_t {
+    Upward,
+    SelfSupporting,
+    NeedsSupport,
+};
+
+struct Fragment {
+    float height;
+    std::uint16_t cell;  // within the tile
+    std::uint8_t kind;
+};
+
+// A triangle ready to rasterize: counter-clockwise seen from above
+struct TriangleSetup {
+    std::int64_t x[3], y[3];  // fixed point, cell centres at SubCells * i + HalfCell
+    float h[3];
+    std::int64_t area2 = 0;   // twice the projected area, fixed point; 0 = skipped
+    int cellX0, cellX1, cellY0, cellY1;  // cells whose centre may be covered, inclusive
+    std::uint8_t kind;
+};
+
+std::int64_t floorDiv(std::int64_t a, std::int64_t b) {
+    return a >= 0 ? a / b : -((-a + b - 1) / b);
+}
+
+std::int64_t ceilDiv(std::int64_t a, std::int64_t b) {
+    return -floorDiv(-a, b);
+}
+
+std::int64_t edge(std::int64_t ax, std::int64_t ay, std::int64_t bx, std::int64_t by,
+                  std::int64_t px, std::int64_t py) {
+    return (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+}
+
+// Top-left fill rule for counter-clockwise triangles with y up: a centre
+// exactly on an edge belongs to the triangle only if the edge is a left
+// edge (going down) or a top edge (horizontal, going left)
+bool ownsEdge(std::int64_t ax, std::int64_t ay, std::int64_t bx, std::int64_t by) {
+    return by < ay || (by == ay && bx < ax);
+}
+
+void rasterizeTile(const std::vector<TriangleSetup>& setups,
+                   const std::vector<std::vector<std::vector<std::uint32_t>>>& bins,
+                   std::size_t tile, int tileX0, int tileY0, int tileX1, int tileY1,
+                   std::vector<Fragment>& fragments, std::vector<Fragment>& sorted,
+                   std::vector<std::uint32_t>& offsets,
+                   double& columnHeight, std::size_t& columns) {
+    fragments.clear();
+    for (const auto& chunk : bins) {
+        for (std::uint32_t t : chunk[tile]) {
+            const TriangleSetup& s = setups[t];
+            const int x0 = std::max(s.cellX0, tileX0), x1 = std::min(s.cellX1, tileX1);
+            const int y0 = std::max(s.cellY0, tileY0), y1 = std::min(s.cellY1, tileY1);
+            const bool own0 = ownsEdge(s.x[1], s.y[1], s.x[2], s.y[2]);
+            const bool own1 = ownsEdge(s.x[2], s.y[2], s.x[0], s.y[0]);
+            const bool own2 = ownsEdge(s.x[0], s.y[0], s.x[1], s.y[1]);
+            const double inverseArea = 1.0 / static_cast<double>(s.area2);
+
+            for (int cy = y0; cy <= y1; ++cy) {
+                const std::int64_t py = SubCells * cy + HalfCell;
+                for (int cx = x0; cx <= x1; ++cx) {
+                    const std::int64_t px = SubCells * cx + HalfCell;
+                    // Edge i is the one opposite corner i
+                    const std::int64_t e0 = edge(s.x[1], s.y[1], s.x[2], s.y[2], px, py);
+                    const std::int64_t e1 = edge(s.x[2], s.y[2], s.x[0], s.y[0], px, py);
+                    const std::int64_t e2 = edge(s.x[0], s.y[0], s.x[1], s.y[1], px, py);
+                    if (e0 < 0 || e1 < 0 || e2 < 0) continue;
+                    if ((e0 == 0 && !own0) || (e1 == 0 && !own1) || (e2 == 0 && !own2)) continue;
+
+                    const double h = (e0 * static_cast<double>(s.h[0]) + e1 * static_cast<double>(s.h[1]) +
+                                      e2 * static_cast<double>(s.h[2])) * inverseArea;
+                    fragments.push_back({ static_cast<float>(h),
+                                          static_cast<std::uint16_t>((cy - tileY0) * TileSize + (cx - tileX0)),
+                                          s.kind });
+                }
+            }
+        }
+    }
+
+    // Counting sort by cell, then each cell's few crossings by height
+    constexpr std::size_t Cells = TileSize * TileSize;
+    offsets.assign(Cells + 1, 0);
+    for (const Fragment& f : fragments) {
+        ++offsets[f.cell + 1];
+    }
+    for (std::size_t c = 0; c < Cells; ++c) {
+        offsets[c + 1] += offsets[c];
+    }
+    sorted.resize(fragments.size());
+    for (const Fragment& f : fragments) {
+        sorted[offsets[f.cell]++] = f;
+    }
+
+    std::size_t begin = 0;
+    for (std::size_t c = 0; c < Cells; ++c) {
+        const std::size_t end = offsets[c];
+        if (end - begin > 1) {
+            std::sort(sorted.begin() + begin, sorted.begin() + end,
+                      [](const Fragment& a, const Fragment& b) { return a.height < b.height; });
+        }
+        // Heights are relative to the plate. Support under a face reaches
+        // down to whatever surface was crossed before it.
+        double below = 0.0;
+        for (std::size_t i = begin; i < end; ++i) {
+            const double h = sorted[i].height;
+            if (sorted[i].kind == NeedsSupport && h > below) {
+                columnHeight += h - below;
+                ++columns;
+            }
+            below = h;
+        }
+        begin = end;
+    }
+}
+
+} // namespace
+
+SupportRasterizer::SupportRasterizer(const float* vertices, std::size_t vertexCount,
+                                     const std::uint32_t* indices, std::size_t triangleCount)
+    : m_vertices(vertices)
+    , m_vertexCount(vertexCount)
+    , m_indices(indices)
+    , m_triangleCount(vertices && indices ? triangleCount : 0)
+{
+}
+
+void SupportRasterizer::setResolution(int cells) {
+    m_resolution = std::clamp(cells, 1, 4096);
+}
+
+SupportEstimate SupportRasterizer::estimate(const double up[3], double cosThreshold) const {
+    SupportEstimate result;
+    if (empty() || m_vertexCount == 0) {
+        return result;
+    }
+
+    // Right-handed frame (e1, e2, up): e1 x e2 = up, so counter-clockwise
+    // in (u, v) means facing up
+    const double ax = std::fabs(up[0]), ay = std::fabs(up[1]), az = std::fabs(up[2]);
+    double helper[3] = { 0, 0, 0 };
+    helper[ax <= ay && ax <= az ? 0 : (ay <= az ? 1 : 2)] = 1.0;
+    double e1[3] = { up[1] * helper[2] - up[2] * helper[1],
+                     up[2] * helper[0] - up[0] * helper[2],
+                     up[0] * helper[1] - up[1] * helper[0] };
+    const double e1Length = std::sqrt(e1[0] * e1[0] + e1[1] * e1[1] + e1[2] * e1[2]);
+    for (double& c : e1) c /= e1Length;
+    const double e2[3] = { up[1] * e1[2] - up[2] * e1[1],
+                           up[2] * e1[0] - up[0] * e1[2],
+                           up[0] * e1[1] - up[1] * e1[0] };
+
+    // Vertices in the frame, with per-chunk bounds merged in order
+    std::vector<double> u(m_vertexCount), v(m_vertexCount), h(m_vertexCount);
+    struct Bounds {
+        double minU = std::numeric_limits<double>::max(), maxU = std::numeric_limits<double>::lowest();
+        double minV = std::numeric_limits<double>::max(), maxV = std::numeric_limits<double>::lowest();
+        double minH = std::numeric_limits<double>::max();
+    };
+    std::vector<Bounds> partial(parallelWorkerCount(m_vertexCount, MinVerticesPerWorker));
+    parallelForChunks(m_vertexCount, MinVerticesPerWorker,
+        [&](unsigned chunk, std::size_t begin, std::size_t end) {
+            Bounds b;
+            for (std::size_t i = begin; i < end; ++i) {
+                const double x = m_vertices[3 * i], y = m_vertices[3 * i + 1], z = m_vertices[3 * i + 2];
+                u[i] = x * e1[0] + y * e1[1] + z * e1[2];
+                v[i] = x * e2[0] + y * e2[1] + z * e2[2];
+                h[i] = x * up[0] + y * up[1] + z * up[2];
+                b.minU = std::min(b.minU, u[i]);
+                b.maxU = std::max(b.maxU, u[i]);
+                b.minV = std::min(b.minV, v[i]);
+                b.maxV = std::max(b.maxV, v[i]);
+                b.minH = std::min(b.minH, h[i]);
+            }
+            partial[chunk] = b;
+        });
+    Bounds bounds;
+    for (const Bounds& b : partial) {
+        bounds.minU = std::min(bounds.minU, b.minU);
+        bounds.maxU = std::max(bounds.maxU, b.maxU);
+        bounds.minV = std::min(bounds.minV, b.minV);
+        bounds.maxV = std::max(bounds.maxV, b.maxV);
+        bounds.minH = std::min(bounds.minH, b.minH);
+    }
+
+    const double cellSize = std::max(bounds.maxU - bounds.minU, bounds.maxV - bounds.minV) / m_resolution;
+    if (!(cellSize > 0.0)) {
+        return result;
+    }
+    result.pixelSize = cellSize;
+    const int columnsX = static_cast<int>((bounds.maxU - bounds.minU) / cellSize) + 1;
+    const int columnsY = static_cast<int>((bounds.maxV - bounds.minV) / cellSize) + 1;
+    const int tilesX = (columnsX + TileSize - 1) / TileSize;
+    const int tilesY = (columnsY + TileSize - 1) / TileSize;
+    const std::size_t tileCount = static_cast<std::size_t>(tilesX) * tilesY;
+
+    // Triangle setup and binning. Each chunk bins its own triangles, so
+    // tiles see them in triangle order whatever the number of threads.
+    const double scale = SubCells / cellSize;
+    std::vector<TriangleSetup> setups(m_triangleCount);
+    std::vector<std::vector<std::vector<std::uint32_t>>> bins(
+        parallelWorkerCount(m_triangleCount, MinTrianglesPerWorker),
+        std::vector<std::vector<std::uint32_t>>(tileCount));
+    parallelForChunks(m_triangleCount, MinTrianglesPerWorker,
+        [&](unsigned chunk, std::size_t begin, std::size_t end) {
+            for (std::size_t t = begin; t < end; ++t) {
+                TriangleSetup& s = setups[t];
+                const std::uint32_t* corner = m_indices + 3 * t;
+                for (int k = 0; k < 3; ++k) {
+                    s.x[k] = std::llround((u[corner[k]] - bounds.minU) * scale);
+                    s.y[k] = std::llround((v[corner[k]] - bounds.minV) * scale);
+                    s.h[k] = static_cast<float>(h[corner[k]] - bounds.minH);
+                }
+                s.area2 = edge(s.x[0], s.y[0], s.x[1], s.y[1], s.x[2], s.y[2]);
+                if (s.area2 == 0) continue;
+
+                // Orientation from the exact projected winding; steepness
+                // from the unsnapped triangle
+                const float* a = m_vertices + 3 * corner[0];
+                const float* b = m_vertices + 3 * corner[1];
+                const float* c = m_vertices + 3 * corner[2];
+                const double ux = b[0] - a[0], uy = b[1] - a[1], uz = b[2] - a[2];
+                const double vx = c[0] - a[0], vy = c[1] - a[1], vz = c[2] - a[2];
+                const double nx = uy * vz - uz * vy, ny = uz * vx - ux * vz, nz = ux * vy - uy * vx;
+                const double length = std::sqrt(nx * nx + ny * ny + nz * nz);
+                const double cosUp = length > 0.0 ? (nx * up[0] + ny * up[1] + nz * up[2]) / length : 0.0;
+                if (s.area2 > 0) {
+                    s.kind = Upward;
+                } else {
+                    s.kind = cosUp < cosThreshold - ThresholdTolerance ? NeedsSupport : SelfSupporting;
+                    std::swap(s.x[1], s.x[2]);
+                    std::swap(s.y[1], s.y[2]);
+                    std::swap(s.h[1], s.h[2]);
+                    s.area2 = -s.area2;
+                }
+
+                const std::int64_t minX = std::min({ s.x[0], s.x[1], s.x[2] });
+                const std::int64_t maxX = std::max({ s.x[0], s.x[1], s.x[2] });
+                const std::int64_t minY = std::min({ s.y[0], s.y[1], s.y[2] });
+                const std::int64_t maxY = std::max({ s.y[0], s.y[1], s.y[2] });
+                s.cellX0 = static_cast<int>(std::max<std::int64_t>(0, ceilDiv(minX - HalfCell, SubCells)));
+                s.cellX1 = static_cast<int>(std::min<std::int64_t>(columnsX - 1, floorDiv(maxX - HalfCell, SubCells)));
+                s.cellY0 = static_cast<int>(std::max<std::int64_t>(0, ceilDiv(minY - HalfCell, SubCells)));
+                s.cellY1 = static_cast<int>(std::min<std::int64_t>(columnsY - 1, floorDiv(maxY - HalfCell, SubCells)));
+                if (s.cellX0 > s.cellX1 || s.cellY0 > s.cellY1) {
+                    s.area2 = 0;  // covers no cell centre
+                    continue;
+                }
+
+                for (int ty = s.cellY0 / TileSize; ty <= s.cellY1 / TileSize; ++ty) {
+                    for (int tx = s.cellX0 / TileSize; tx <= s.cellX1 / TileSize; ++tx) {
+                        bins[chunk][static_cast<std::size_t>(ty) * tilesX + tx].push_back(
+                            static_cast<std::uint32_t>(t));
+                    }
+                }
+            }
+        });
+
+    // Tiles in parallel, each with its own fragment buffers; per-tile sums
+    // are added in tile order so the result does not depend on threads
+    std::vector<double> tileHeight(tileCount, 0.0);
+    std::vector<std::size_t> tileColumns(tileCount, 0);
+    parallelForChunks(tileCount, MinTilesPerWorker,
+        [&](unsigned, std::size_t begin, std::size_t end) {
+            std::vector<Fragment> fragments, sorted;
+            std::vector<std::uint32_t> offsets;
+            for (std::size_t tile = begin; tile < end; ++tile) {
+                const int tileX0 = static_cast<int>(tile % tilesX) * TileSize;
+                const int tileY0 = static_cast<int>(tile / tilesX) * TileSize;
+                rasterizeTile(setups, bins, tile, tileX0, tileY0,
+                              std::min(tileX0 + TileSize, columnsX) - 1,
+                              std::min(tileY0 + TileSize, columnsY) - 1,
+                              fragments, sorted, offsets, tileHeight[tile], tileColumns[tile]);
+            }
+        });
+
+    const double cellArea = cellSize * cellSize;
+    for (std::size_t tile = 0; tile < tileCount; ++tile) {
+        result.volume += tileHeight[tile] * cellArea;
+        result.area += static_cast<double>(tileColumns[tile]) * cellArea;
+    }
+    return result;
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
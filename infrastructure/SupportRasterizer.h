@@ -0,0 +1,71 @@
+#ifndef SUPPORTRASTERIZER_H
+#define SUPPORTRASTERIZER_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief Support needed under a part for one build direction, measured on a grid
+ */
+struct SupportEstimate {
+    double volume = 0.0;     // sum of the support columns under overhangs
+    double area = 0.0;       // plate area covered by those columns, counted once per column
+    double pixelSize = 0.0;  // edge length of one grid cell
+};
+
+/**
+ * @brief CPU rasterizer measuring support volume on a height field
+ *
+ * The mesh is projected along the build direction onto a square grid over
+ * its footprint. Every grid cell collects the heights at which its centre
+ * line crosses the mesh, tagged with the crossing face's orientation. Going
+ * up a column, a face that needs support starts a support column that
+ * reaches down to the last upward face crossed (the part below) or to the
+ * plate; a self-supporting downward face needs none.
+ *
+ * Rasterization is tiled: triangles are binned to 32 x 32 cell tiles and
+ * the tiles are processed on all cores, each with its own fragment list.
+ * Vertices are snapped to 1/256 of a cell so that triangles sharing an
+ * edge never both cover, or both miss, a cell centre on it.
+ *
+ * Thread-safe: estimate() only reads the mesh. The mesh must outlive the
+ * rasterizer.
+ */
+class SupportRasterizer {
+public:
+    /**
+     * @param vertices Interleaved x, y, z
+     * @param indices Three vertex indices per triangle, all in range
+     */
+    SupportRasterizer(const float* vertices, std::size_t vertexCount,
+                      const std::uint32_t* indices, std::size_t triangleCount);
+
+    /// Cells along the longer side of the footprint (default 256)
+    void setResolution(int cells);
+    int resolution() const { return m_resolution; }
+
+    bool empty() const { return m_triangleCount == 0; }
+
+    /**
+     * @brief Support under the part when built along up
+     * @param up Unit build direction
+     * @param cosThreshold Faces with n . up below this need support, as in
+     *        Domain::FaceNormals::supportArea()
+     */
+    SupportEstimate estimate(const double up[3], double cosThreshold) const;
+
+private:
+    const float* m_vertices;
+    std::size_t m_vertexCount;
+    const std::uint32_t* m_indices;
+    std::size_t m_triangleCount;
+    int m_resolution = 256;
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // SUPPORTRASTERIZER_H
@@ -0,0 +1,536 @@
+#include "ThreeMfFileLoader.h"
+#include "MeshMetrics.h"
+#include "ParallelFor.h"
+#include "VtkMeshAdapter.h"
+#include "ZipArchive.h"
+
+#include <array>
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+namespace {
+
+const char* const DefaultModelPart = "3D/3dmodel.model";
+const char* const RelationshipsPart = "_rels/.rels";
+
+// Vertex lines are ~50 bytes; 1 MB chunks keep every task worth a thread
+constexpr std::size_t MinChunkBytes = 1 << 20;
+
+// Component references deeper than this are treated as a cycle
+constexpr int MaxComponentDepth = 32;
+
+// Row-vector 3x4 affine transform as written in 3MF:
+// x' = x * m[0] + y * m[3] + z * m[6] + m[9], and so on
+using Affine = std::array<double, 12>;
+constexpr Affine Identity = {1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0};
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// One XML start tag: the text between '<name' and '>'
+struct Tag {
+    const char* attrBegin = nullptr;
+    const char* end = nullptr;  // points at '>'
+    bool selfClosing = false;
+};
+
+/**
+ * Find the next start tag with the given name at or after pos and move pos
+ * past it. Names must match exactly ("<vertex" does not match "<vertices").
+ */
+const char* findTag(std::string_view text, std::size_t& pos, std::string_view name, Tag& tag) {
+    while (pos < text.size()) {
+        std::size_t at = text.find('<', pos);
+        if (at == std::string_view::npos || at + 1 + name.size() >= text.size()) {
+            break;
+        }
+        pos = at + 1;
+        if (text.compare(at + 1, name.size(), name) != 0) {
+            continue;
+        }
+        const char next = text[at + 1 + name.size()];
+        if (!isSpace(next) && next != '/' && next != '>') {
+            continue;
+        }
+        std::size_t close = text.find('>', at);
+        if (close == std::string_view::npos) {
+            break;
+        }
+        tag.attrBegin = text.data() + at + 1 + name.size();
+        tag.end = text.data() + close;
+        tag.selfClosing = text[close - 1] == '/';
+        pos = close + 1;
+        return text.data() + at;
+    }
+    pos = text.size();
+    return nullptr;
+}
+
+/**
+ * Walk the attributes of a tag once, calling fn(name, value) for each.
+ * Handles both quote styles; values are not unescaped (numbers and ids
+ * never need it).
+ */
+template <typename Fn>
+void forEachAttribute(const Tag& tag, Fn&& fn) {
+    const char* p = tag.attrBegin;
+    const char* end = tag.end;
+    while (p < end) {
+        while (p < end && (isSpace(*p) || *p == '/')) {
+            ++p;
+        }
+        const char* nameBegin = p;
+        while (p < end && *p != '=' && !isSpace(*p)) {
+            ++p;
+        }
+        std::string_view name(nameBegin, static_cast<std::size_t>(p - nameBegin));
+        while (p < end && *p != '"' && *p != '\'') {
+            ++p;
+        }
+        if (p >= end) {
+            return;
+        }
+        const char quote = *p++;
+        const char* valueBegin = p;
+        while (p < end && *p != quote) {
+            ++p;
+        }
+        fn(name, std::string_view(valueBegin, static_cast<std::size_t>(p - valueBegin)));
+        ++p;
+    }
+}
+
+std::string_view attributeValue(const Tag& tag, std::string_view wanted) {
+    std::string_view result;
+    forEachAttribute(tag, [&](std::string_view name, std::string_view value) {
+        if (name == wanted) {
+            result = value;
+        }
+    });
+    return result;
+}
+
+template <typename T>
+bool parseNumber(std::string_view text, T& out) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (p < end && isSpace(*p)) {
+        ++p;
+    }
+    if (p < end && *p == '+') {
+        ++p;
+    }
+    return std::from_chars(p, end, out).ec == std::errc();
+}
+
+bool parseTransform(std::string_view text, Affine& out) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    for (double& m : out) {
+        while (p < end && isSpace(*p)) {
+            ++p;
+        }
+        if (p < end && *p == '+') {
+            ++p;
+        }
+        auto res = std::from_chars(p, end, m);
+        if (res.ec != std::errc()) {
+            return false;
+        }
+        p = res.ptr;
+    }
+    return true;
+}
+
+// a then b
+Affine compose(const Affine& a, const Affine& b) {
+    Affine r;
+    for (int row = 0; row < 4; ++row) {
+        for (int col = 0; col < 3; ++col) {
+            double v = a[3 * row + 0] * b[0 + col] + a[3 * row + 1] * b[3 + col] + a[3 * row + 2] * b[6 + col];
+            r[3 * row + col] = row == 3 ? v + b[9 + col] : v;
+        }
+    }
+    return r;
+}
+
+double determinant(const Affine& m) {
+    return m[0] * (m[4] * m[8] - m[5] * m[7])
+         - m[1] * (m[3] * m[8] - m[5] * m[6])
+         + m[2] * (m[3] * m[7] - m[4] * m[6]);
+}
+
+double unitScale(std::string_view unit) {
+    if (unit == "micron") return 0.001;
+    if (unit == "centimeter") return 10.0;
+    if (unit == "inch") return 25.4;
+    if (unit == "foot") return 304.8;
+    if (unit == "meter") return 1000.0;
+    return 1.0;  // millimeter is the default
+}
+
+struct Component {
+    std::string_view objectId;
+    Affine transform = Identity;
+};
+
+struct ObjectInfo {
+    std::string_view id;
+    std::string_view vertices;   // body of <vertices>
+    std::string_view triangles;  // body of <triangles>
+    std::vector<Component> components;
+    std::vector<float> vertexData;
+    std::vector<std::uint32_t> indexData;
+};
+
+struct DecodeTask {
+    std::size_t object;
+    bool triangles;
+    std::string_view text;
+    std::vector<float> vertices;
+    std::vector<std::uint32_t> indices;
+    bool ok = true;
+};
+
+// Body of <name ...> ... </name> starting at pos, or empty if self-closing/missing
+std::string_view sectionBody(std::string_view text, std::string_view name) {
+    std::size_t pos = 0;
+    Tag tag;
+    if (!findTag(text, pos, name, tag) || tag.selfClosing) {
+        return {};
+    }
+    const std::string closing = "</" + std::string(name) + ">";
+    std::size_t close = text.find(closing, pos);
+    if (close == std::string_view::npos) {
+        return {};
+    }
+    return text.substr(pos, close - pos);
+}
+
+// Split a section into element-aligned chunks of roughly MinChunkBytes
+void addChunks(std::size_t object, bool triangles, std::string_view body,
+               std::string_view element, std::vector<DecodeTask>& tasks) {
+    std::size_t begin = 0;
+    while (begin < body.size()) {
+        std::size_t cut = body.size();
+        if (body.size() - begin > 2 * MinChunkBytes) {
+            std::size_t at = body.find(element, begin + MinChunkBytes);
+            if (at != std::string_view::npos) {
+                cut = at;
+            }
+        }
+        DecodeTask task;
+        task.object = object;
+        task.triangles = triangles;
+        task.text = body.substr(begin, cut - begin);
+        tasks.push_back(std::move(task));
+        begin = cut;
+    }
+}
+
+void decodeVertices(DecodeTask& task) {
+    const std::string_view text = task.text;
+    task.vertices.reserve(text.size() / 50 * 3);
+    std::size_t pos = 0;
+    Tag tag;
+    while (findTag(text, pos, "vertex", tag)) {
+        float xyz[3] = {0.0f, 0.0f, 0.0f};
+        int found = 0;
+        forEachAttribute(tag, [&](std::string_view name, std::string_view value) {
+            if (name.size() == 1 && name[0] >= 'x' && name[0] <= 'z') {
+                found += parseNumber(value, xyz[name[0] - 'x']) ? 1 : 0;
+            }
+        });
+        if (found != 3) {
+            task.ok = false;
+            return;
+        }
+        task.vertices.insert(task.vertices.end(), xyz, xyz + 3);
+    }
+}
+
+void decodeTriangles(DecodeTask& task) {
+    const std::string_view text = task.text;
+    task.indices.reserve(text.size() / 40 * 3);
+    std::size_t pos = 0;
+    Tag tag;
+    while (findTag(text, pos, "triangle", tag)) {
+        std::uint32_t v[3] = {0, 0, 0};
+        int found = 0;
+        forEachAttribute(tag, [&](std::string_view name, std::string_view value) {
+            if (name.size() == 2 && name[0] == 'v' && name[1] >= '1' && name[1] <= '3') {
+                found += parseNumber(value, v[name[1] - '1']) ? 1 : 0;
+            }
+        });
+        if (found != 3) {
+            task.ok = false;
+            return;
+        }
+        task.indices.insert(task.indices.end(), v, v + 3);
+    }
+}
+
+class MeshAssembler {
+public:
+    MeshAssembler(const std::vector<ObjectInfo>& objects, double scale, Domain::TriangleMesh& mesh)
+        : m_objects(objects), m_scale(scale), m_mesh(mesh)
+    {
+        for (std::size_t i = 0; i < objects.size(); ++i) {
+            m_byId.emplace(objects[i].id, i);
+        }
+    }
+
+    bool add(std::string_view objectId, const Affine& transform, int depth = 0) {
+        auto it = m_byId.find(objectId);
+        if (it == m_byId.end() || depth > MaxComponentDepth) {
+            return false;
+        }
+        const ObjectInfo& object = m_objects[it->second];
+
+        if (!object.indexData.empty()) {
+            appendMesh(object, transform);
+        }
+        for (const Component& component : object.components) {
+            if (!add(component.objectId, compose(component.transform, transform), depth + 1)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    const std::vector<ObjectInfo>& m_objects;
+    std::unordered_map<std::string_view, std::size_t> m_byId;
+    double m_scale;
+    Domain::TriangleMesh& m_mesh;
+
+    void appendMesh(const ObjectInfo& object, const Affine& t) {
+        const std::uint32_t base = static_cast<std::uint32_t>(m_mesh.vertexCount());
+        const std::size_t firstVertex = m_mesh.vertices.size();
+        const std::size_t firstIndex = m_mesh.indices.size();
+        m_mesh.vertices.resize(firstVertex + object.vertexData.size());
+        m_mesh.indices.resize(firstIndex + object.indexData.size());
+
+        const std::size_t count = object.vertexData.size() / 3;
+        const float* src = object.vertexData.data();
+        float* dst = m_mesh.vertices.data() + firstVertex;
+        parallelForChunks(count, 1 << 16, [&](unsigned, std::size_t begin, std::size_t end) {
+            for (std::size_t v = begin; v < end; ++v) {
+                const double x = src[3 * v], y = src[3 * v + 1], z = src[3 * v + 2];
+                dst[3 * v + 0] = static_cast<float>((x * t[0] + y * t[3] + z * t[6] + t[9]) * m_scale);
+                dst[3 * v + 1] = static_cast<float>((x * t[1] + y * t[4] + z * t[7] + t[10]) * m_scale);
+                dst[3 * v + 2] = static_cast<float>((x * t[2] + y * t[5] + z * t[8] + t[11]) * m_scale);
+            }
+        });
+
+        // Mirroring transforms flip the winding; swap two corners to keep
+        // the faces pointing outwards.
+        const bool mirrored = determinant(t) < 0.0;
+        const std::uint32_t* in = object.indexData.data();
+        std::uint32_t* out = m_mesh.indices.data() + firstIndex;
+        for (std::size_t i = 0; i < object.indexData.size(); i += 3) {
+            out[i + 0] = base + in[i + 0];
+            out[i + 1] = base + in[mirrored ? i + 2 : i + 1];
+            out[i + 2] = base + in[mirrored ? i + 1 : i + 2];
+        }
+    }
+};
+
+bool findModelPart(const ZipArchive& zip, std::string& modelPart) {
+    modelPart = DefaultModelPart;
+
+    const ZipArchive::Entry* rels = zip.find(RelationshipsPart);
+    std::vector<char> text;
+    if (!rels || !zip.extract(*rels, text)) {
+        return zip.find(modelPart) != nullptr;
+    }
+
+    const std::string_view view(text.data(), text.size());
+    std::size_t pos = 0;
+    Tag tag;
+    while (findTag(view, pos, "Relationship", tag)) {
+        std::string_view type = attributeValue(tag, "Type");
+        std::string_view target = attributeValue(tag, "Target");
+        if (type.size() >= 8 && type.substr(type.size() - 8) == "/3dmodel" && !target.empty()) {
+            modelPart.assign(target.data(), target.size());
+            break;
+        }
+    }
+    return zip.find(modelPart) != nullptr;
+}
+
+} // namespace
+
+bool ThreeMfFileLoader::parseModel(const char* data, std::size_t size, Domain::TriangleMesh& mesh,
+                                   Application::LoadProgress* progress) {
+    mesh.vertices.clear();
+    mesh.indices.clear();
+    const std::string_view text(data, size);
+
+    // 1. Structural scan: unit, objects and their sections, build items
+    double scale = 1.0;
+    std::size_t pos = 0;
+    Tag tag;
+    if (findTag(text, pos, "model", tag)) {
+        scale = unitScale(attributeValue(tag, "unit"));
+    }
+
+    std::vector<ObjectInfo> objects;
+    std::size_t resourcesEnd = pos;
+    while (findTag(text, pos, "object", tag)) {
+        ObjectInfo object;
+        object.id = attributeValue(tag, "id");
+        if (!tag.selfClosing) {
+            std::size_t close = text.find("</object>", pos);
+            if (close == std::string_view::npos) {
+                return false;
+            }
+            const std::string_view body = text.substr(pos, close - pos);
+            object.vertices = sectionBody(body, "vertices");
+            object.triangles = sectionBody(body, "triangles");
+
+            const std::string_view components = sectionBody(body, "components");
+            std::size_t cpos = 0;
+            Tag ctag;
+            while (findTag(components, cpos, "component", ctag)) {
+                Component component;
+                component.objectId = attributeValue(ctag, "objectid");
+                std::string_view transform = attributeValue(ctag, "transform");
+                if (!transform.empty() && !parseTransform(transform, component.transform)) {
+                    return false;
+                }
+                object.components.push_back(component);
+            }
+            pos = close + 9;
+        }
+        resourcesEnd = pos;
+        objects.push_back(std::move(object));
+    }
+
+    std::vector<Component> items;
+    const std::string_view build = sectionBody(text.substr(resourcesEnd), "build");
+    std::size_t bpos = 0;
+    while (findTag(build, bpos, "item", tag)) {
+        Component item;
+        item.objectId = attributeValue(tag, "objectid");
+        std::string_view transform = attributeValue(tag, "transform");
+        if (!transform.empty() && !parseTransform(transform, item.transform)) {
+            return false;
+        }
+        items.push_back(item);
+    }
+
+    // 2. Decode the vertex and triangle sections of all objects in parallel
+    std::vector<DecodeTask> tasks;
+    for (std::size_t o = 0; o < objects.size(); ++o) {
+        addChunks(o, false, objects[o].vertices, "<vertex", tasks);
+        addChunks(o, true, objects[o].triangles, "<triangle", tasks);
+    }
+    parallelForChunks(tasks.size(), 1, [&](unsigned, std::size_t begin, std::size_t end) {
+        for (std::size_t t = begin; t < end; ++t) {
+            if (progress && progress->isCancelled()) {
+                tasks[t].ok = false;
+                continue;
+            }
+            if (tasks[t].triangles) {
+                decodeTriangles(tasks[t]);
+            } else {
+                decodeVertices(tasks[t]);
+            }
+            if (progress) {
+                progress->addBytes(tasks[t].text.size());
+            }
+        }
+    });
+
+    // Chunks were created in document order, so appending keeps indices valid
+    for (DecodeTask& task : tasks) {
+        if (!task.ok) {
+            return false;
+        }
+        ObjectInfo& object = objects[task.object];
+        object.vertexData.insert(object.vertexData.end(), task.vertices.begin(), task.vertices.end());
+        object.indexData.insert(object.indexData.end(), task.indices.begin(), task.indices.end());
+    }
+    tasks.clear();
+
+    for (const ObjectInfo& object : objects) {
+        const std::size_t vertexCount = object.vertexData.size() / 3;
+        for (std::uint32_t index : object.indexData) {
+            if (index >= vertexCount) {
+                return false;
+            }
+        }
+    }
+
+    // 3. Instantiate build items; files without a build section show every mesh
+    if (items.empty()) {
+        for (const ObjectInfo& object : objects) {
+            if (!object.indexData.empty()) {
+                items.push_back(Component{object.id, Identity});
+            }
+        }
+    }
+
+    MeshAssembler assembler(objects, scale, mesh);
+    for (const Component& item : items) {
+        if (!assembler.add(item.objectId, item.transform)) {
+            return false;
+        }
+    }
+    return !mesh.empty();
+}
+
+std::unique_ptr<Application::MeshData> ThreeMfFileLoader::load(const std::string& filePath) {
+    Application::LoadProgress progress;
+    return loadWithProgress(filePath, progress);
+}
+
+std::unique_ptr<Application::MeshData> ThreeMfFileLoader::loadWithProgress(
+    const std::string& filePath, Application::LoadProgress& progress) {
+    ZipArchive zip;
+    if (progress.isCancelled() || !zip.open(filePath)) {
+        return nullptr;
+    }
+
+    // Progress covers inflating the model part, then tokenizing its text
+    std::string modelPart;
+    std::vector<char> document;
+    if (!findModelPart(zip, modelPart)) {
+        return nullptr;
+    }
+    const ZipArchive::Entry& entry = *zip.find(modelPart);
+    progress.setTotalBytes(entry.compressedSize + entry.uncompressedSize);
+    if (!zip.extract(entry, document, &progress)) {
+        return nullptr;
+    }
+
+    auto mesh = std::make_shared<Domain::TriangleMesh>();
+    if (!parseModel(document.data(), document.size(), *mesh, &progress)) {
+        return nullptr;
+    }
+    document = std::vector<char>();
+
+    const MeshMetrics metrics = MeshMetrics::compute(*mesh);
+
+    auto meshData = std::make_unique<Application::MeshData>();
+    meshData->bounds = metrics.bounds();
+    meshData->triangleCount = static_cast<int>(metrics.triangleCount());
+    meshData->volume = metrics.volume();
+    meshData->surfaceArea = metrics.surfaceArea();
+    meshData->mesh = mesh;
+    meshData->nativeData = VtkMeshAdapter::wrapNative(mesh);
+
+    progress.setBytesDone(progress.totalBytes());
+    return meshData;
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
@@ -0,0 +1,48 @@
+#ifndef THREEMFFILELOADER_H
+#define THREEMFFILELOADER_H
+
+#include "../core/application/interfaces/IStlFileLoader.h"
+
+#include <cstddef>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief 3MF file loader behind the IStlFileLoader interface
+ *
+ * Opens the package with ZipArchive, locates the root model part through
+ * the package relationships and inflates it straight from the mapping.
+ * The model XML is read by a small purpose-built tokenizer: a structural
+ * scan finds the objects, then the <vertices> and <triangles> sections of
+ * all objects are cut into element-aligned chunks that are decoded in
+ * parallel with std::from_chars.
+ *
+ * All build items are merged into one mesh, with component and item
+ * transforms applied and coordinates converted to millimeters. 3MF meshes
+ * are already indexed, so no welding is needed.
+ */
+class ThreeMfFileLoader : public Application::IStlFileLoader {
+public:
+    ThreeMfFileLoader() = default;
+    ~ThreeMfFileLoader() override = default;
+
+    std::unique_ptr<Application::MeshData> load(const std::string& filePath) override;
+    std::unique_ptr<Application::MeshData> loadWithProgress(const std::string& filePath,
+                                                            Application::LoadProgress& progress) override;
+
+    /**
+     * @brief Decode a 3MF model part (the XML document) into a single mesh
+     * @param progress Optional; receives decoded bytes and is polled for
+     *        cancellation between chunks
+     * @return false if the document is malformed, contains no triangles or
+     *         the load was cancelled
+     */
+    static bool parseModel(const char* data, std::size_t size, Domain::TriangleMesh& mesh,
+                           Application::LoadProgress* progress = nullptr);
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // THREEMFFILELOADER_H
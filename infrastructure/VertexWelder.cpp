@@ -0,0 +1,300 @@
+#include "VertexWelder.h"
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+namespace {
+
+// Keeps cell indices well inside int64 for any plausible coordinate range
+constexpr float MinEpsilon = 1e-12f;
+
+// Non-finite coordinates share one cell; they never compare close anyway
+constexpr std::int64_t NonFiniteCell = std::numeric_limits<std::int64_t>::min();
+
+// Sorting below this many corners per worker is not worth a thread
+constexpr std::size_t MinCornersPerWorker = 1 << 16;
+
+inline bool isClose(float a, float b, float eps) {
+    return std::fabs(a - b) < eps;
+}
+
+// Coordinate bits plus the corner index as tie-breaker: a strict total
+// order, so the sorted sequence does not depend on how the work was split.
+struct CornerKey {
+    std::uint64_t xy;
+    std::uint64_t zc;
+
+    bool operator<(const CornerKey& o) const {
+        return xy < o.xy || (xy == o.xy && zc < o.zc);
+    }
+    bool samePosition(const CornerKey& o) const {
+        return xy == o.xy && (zc >> 32) == (o.zc >> 32);
+    }
+    std::uint32_t corner() const { return static_cast<std::uint32_t>(zc); }
+};
+
+inline std::uint32_t floatBits(float f) {
+    std::uint32_t b;
+    std::memcpy(&b, &f, sizeof(b));
+    return b;
+}
+
+// Sort chunks in parallel, then merge neighbouring runs pairwise
+void parallelSort(std::vector<CornerKey>& keys) {
+    const std::size_t n = keys.size();
+    const unsigned workers = parallelWorkerCount(n, MinCornersPerWorker);
+    const std::size_t chunk = (n + workers - 1) / workers;
+
+    std::vector<std::size_t> runs;
+    for (std::size_t b = 0; b < n; b += chunk) {
+        runs.push_back(b);
+    }
+    runs.push_back(n);
+
+    parallelForChunks(runs.size() - 1, 1, [&](unsigned, std::size_t begin, std::size_t end) {
+        for (std::size_t r = begin; r < end; ++r) {
+            std::sort(keys.begin() + runs[r], keys.begin() + runs[r + 1]);
+        }
+    });
+
+    if (runs.size() <= 2) {
+        return;
+    }
+
+    std::vector<CornerKey> buffer(n);
+    std::vector<CornerKey>* src = &keys;
+    std::vector<CornerKey>* dst = &buffer;
+
+    while (runs.size() > 2) {
+        const std::size_t pairs = (runs.size() - 1 + 1) / 2;
+        parallelForChunks(pairs, 1, [&](unsigned, std::size_t begin, std::size_t end) {
+            for (std::size_t p = begin; p < end; ++p) {
+                std::size_t lo = runs[2 * p];
+                std::size_t mid = std::min(runs[2 * p + 1], n);
+                std::size_t hi = (2 * p + 2 < runs.size()) ? runs[2 * p + 2] : mid;
+                std::merge(src->begin() + lo, src->begin() + mid,
+                           src->begin() + mid, src->begin() + hi,
+                           dst->begin() + lo);
+            }
+        });
+
+        std::vector<std::size_t> merged;
+        for (std::size_t i = 0; i < runs.size() - 1; i += 2) {
+            merged.push_back(runs[i]);
+        }
+        merged.push_back(n);
+        runs.swap(merged);
+        std::swap(src, dst);
+    }
+
+    if (src != &keys) {
+        keys.swap(buffer);
+    }
+}
+
+} // namespace
+
+std::size_t VertexWelder::CellKeyHash::operator()(const CellKey& k) const {
+    // Large odd multipliers spread neighbouring cells across the table
+    std::uint64_t h = static_cast<std::uint64_t>(k.x) * 0x9E3779B97F4A7C15ull;
+    h ^= static_cast<std::uint64_t>(k.y) * 0xC2B2AE3D27D4EB4Full;
+    h ^= static_cast<std::uint64_t>(k.z) * 0x165667B19E3779F9ull;
+    h ^= h >> 29;
+    return static_cast<std::size_t>(h);
+}
+
+VertexWelder::VertexWelder(float epsilon)
+    : m_epsilon(std::max(epsilon, MinEpsilon))
+    , m_invCellSize(1.0 / (2.0 * static_cast<double>(std::max(epsilon, MinEpsilon))))
+{
+}
+
+void VertexWelder::reserve(std::size_t vertexCount) {
+    m_vertices.reserve(vertexCount * 3);
+    m_next.reserve(vertexCount);
+    m_cells.reserve(vertexCount);
+}
+
+std::int64_t VertexWelder::cellOf(double v) const {
+    if (!std::isfinite(v)) {
+        return NonFiniteCell;
+    }
+    return static_cast<std::int64_t>(std::floor(v * m_invCellSize));
+}
+
+std::uint32_t VertexWelder::findClose(float x, float y, float z) const {
+    const double eps = m_epsilon;
+
+    // The query box [v - eps, v + eps] is exactly one cell wide, so it
+    // touches at most two cells along each axis.
+    const std::int64_t x0 = cellOf(x - eps), x1 = cellOf(x + eps);
+    const std::int64_t y0 = cellOf(y - eps), y1 = cellOf(y + eps);
+    const std::int64_t z0 = cellOf(z - eps), z1 = cellOf(z + eps);
+
+    std::uint32_t best = NoVertex;
+    for (std::int64_t cx = x0; cx <= x1; ++cx) {
+        for (std::int64_t cy = y0; cy <= y1; ++cy) {
+            for (std::int64_t cz = z0; cz <= z1; ++cz) {
+                auto it = m_cells.find(CellKey{cx, cy, cz});
+                if (it == m_cells.end()) {
+                    continue;
+                }
+                for (std::uint32_t v = it->second; v != NoVertex; v = m_next[v]) {
+                    const float* p = &m_vertices[3 * static_cast<std::size_t>(v)];
+                    if (v < best &&
+                        isClose(p[0], x, m_epsilon) &&
+                        isClose(p[1], y, m_epsilon) &&
+                        isClose(p[2], z, m_epsilon)) {
+                        best = v;
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+std::uint32_t VertexWelder::insert(float x, float y, float z) {
+    std::uint32_t existing = findClose(x, y, z);
+    if (existing != NoVertex) {
+        ++m_stats.welded;
+        return existing;
+    }
+
+    const std::uint32_t index = static_cast<std::uint32_t>(m_vertices.size() / 3);
+    m_vertices.insert(m_vertices.end(), {x, y, z});
+
+    CellKey key{cellOf(x), cellOf(y), cellOf(z)};
+    auto inserted = m_cells.emplace(key, index);
+    m_next.push_back(inserted.second ? NoVertex : inserted.first->second);
+    inserted.first->second = index;
+
+    ++m_stats.unwelded;
+    return index;
+}
+
+std::vector<float> VertexWelder::takeVertices() {
+    std::vector<float> out = std::move(m_vertices);
+    m_vertices.clear();
+    m_next.clear();
+    m_cells.clear();
+    return out;
+}
+
+VertexWelder::Stats VertexWelder::weldSoup(const float* x, const float* y, const float* z,
+                                           std::size_t count, float epsilon,
+                                           std::uint32_t* outIndices,
+                                           std::vector<float>& outVertices) {
+    Stats stats;
+    outVertices.clear();
+    if (count == 0) {
+        return stats;
+    }
+
+    // 1. Sort corners by exact coordinate bits
+    std::vector<CornerKey> keys(count);
+    parallelForChunks(count, MinCornersPerWorker, [&](unsigned, std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+            keys[c].xy = (static_cast<std::uint64_t>(floatBits(x[c])) << 32) | floatBits(y[c]);
+            keys[c].zc = (static_cast<std::uint64_t>(floatBits(z[c])) << 32) | static_cast<std::uint32_t>(c);
+        }
+    });
+    parallelSort(keys);
+
+    // 2. Every corner points at the first corner of its equal-position run.
+    //    The tie-breaker puts the lowest corner index at the head of each run.
+    std::uint32_t* repr = outIndices;
+    parallelForChunks(count, MinCornersPerWorker, [&](unsigned, std::size_t begin, std::size_t end) {
+        if (begin == end) {
+            return;
+        }
+        std::size_t head = begin;
+        while (head > 0 && keys[head - 1].samePosition(keys[begin])) {
+            --head;
+        }
+        for (std::size_t s = begin; s < end; ++s) {
+            if (!keys[s].samePosition(keys[head])) {
+                head = s;
+            }
+            repr[keys[s].corner()] = keys[head].corner();
+        }
+    });
+    keys.clear();
+    keys.shrink_to_fit();
+
+    // 3. Number run heads by first appearance (parallel prefix sum)
+    std::vector<std::uint32_t> ids(count);
+    std::vector<std::size_t> chunkTotals(parallelWorkerCount(count, MinCornersPerWorker) + 1, 0);
+    parallelForChunks(count, MinCornersPerWorker, [&](unsigned w, std::size_t begin, std::size_t end) {
+        std::size_t n = 0;
+        for (std::size_t c = begin; c < end; ++c) {
+            n += (repr[c] == c) ? 1 : 0;
+        }
+        chunkTotals[w + 1] = n;
+    });
+    for (std::size_t w = 1; w < chunkTotals.size(); ++w) {
+        chunkTotals[w] += chunkTotals[w - 1];
+    }
+    const std::size_t exactUnique = chunkTotals.back();
+
+    std::vector<float> unique(exactUnique * 3);
+    parallelForChunks(count, MinCornersPerWorker, [&](unsigned w, std::size_t begin, std::size_t end) {
+        std::size_t next = chunkTotals[w];
+        for (std::size_t c = begin; c < end; ++c) {
+            if (repr[c] == c) {
+                ids[c] = static_cast<std::uint32_t>(next);
+                unique[3 * next + 0] = x[c];
+                unique[3 * next + 1] = y[c];
+                unique[3 * next + 2] = z[c];
+                ++next;
+            }
+        }
+    });
+    parallelForChunks(count, MinCornersPerWorker, [&](unsigned, std::size_t begin, std::size_t end) {
+        for (std::size_t c = begin; c < end; ++c) {
+            outIndices[c] = ids[repr[c]];
+        }
+    });
+    ids.clear();
+    ids.shrink_to_fit();
+
+    if (epsilon <= 0.0f) {
+        outVertices = std::move(unique);
+        stats.unwelded = exactUnique;
+        stats.welded = count - exactUnique;
+        return stats;
+    }
+
+    // 4. Weld the remaining near-coincident positions on the grid hash.
+    //    Inserting in first-appearance order keeps insert() semantics.
+    VertexWelder welder(epsilon);
+    welder.reserve(exactUnique);
+    std::vector<std::uint32_t> weldMap(exactUnique);
+    for (std::size_t u = 0; u < exactUnique; ++u) {
+        weldMap[u] = welder.insert(unique[3 * u + 0], unique[3 * u + 1], unique[3 * u + 2]);
+    }
+
+    if (welder.stats().welded > 0) {
+        parallelForChunks(count, MinCornersPerWorker, [&](unsigned, std::size_t begin, std::size_t end) {
+            for (std::size_t c = begin; c < end; ++c) {
+                outIndices[c] = weldMap[outIndices[c]];
+            }
+        });
+        outVertices = welder.takeVertices();
+    } else {
+        outVertices = std::move(unique);
+    }
+
+    stats.unwelded = outVertices.size() / 3;
+    stats.welded = count - stats.unwelded;
+    return stats;
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
@@ -0,0 +1,109 @@
+#ifndef VERTEXWELDER_H
+#define VERTEXWELDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief Tolerance-aware vertex welding on a quantized grid hash
+ *
+ * Two vertices are welded when every coordinate differs by less than
+ * epsilon (the per-axis |a - b| < eps test STL loading has always used).
+ * Space is bucketed into cells of 2 * epsilon, so the neighbourhood of a
+ * query point overlaps at most two cells per axis: every insert probes at
+ * most 8 buckets instead of scanning all known vertices.
+ *
+ * When several existing vertices are within tolerance the one with the
+ * lowest index wins, so the result does not depend on hash iteration order.
+ *
+ * For whole triangle soups use weldSoup(), which removes exact duplicates
+ * with a parallel sort before the grid hash sees any vertex.
+ */
+class VertexWelder {
+public:
+    struct Stats {
+        std::size_t welded = 0;    // inserts merged into an existing vertex
+        std::size_t unwelded = 0;  // inserts that created a new vertex
+    };
+
+    /**
+     * @param epsilon Per-axis tolerance; must be positive
+     */
+    explicit VertexWelder(float epsilon = 1e-6f);
+
+    /**
+     * @brief Pre-size internal tables for an expected number of unique vertices
+     */
+    void reserve(std::size_t vertexCount);
+
+    /**
+     * @brief Insert a vertex, welding it to an existing one if within tolerance
+     * @return Index of the (possibly pre-existing) vertex
+     */
+    std::uint32_t insert(float x, float y, float z);
+
+    /// Welded vertices as interleaved x, y, z
+    const std::vector<float>& vertices() const { return m_vertices; }
+    std::vector<float> takeVertices();
+
+    /**
+     * @brief Index a whole triangle soup in bulk
+     *
+     * Equivalent to calling insert() for every corner in order, but exact
+     * duplicates (the vast majority in STL files) are collapsed first by a
+     * parallel sort on the coordinate bits; only the remaining unique
+     * positions go through the tolerance grid. The output is deterministic
+     * and independent of the number of threads: vertices are numbered in
+     * order of first appearance.
+     *
+     * Extra memory is bounded at about 36 bytes per corner.
+     *
+     * @param x, y, z Corner coordinates, count entries each
+     * @param count Number of corners
+     * @param epsilon Per-axis weld tolerance; zero merges exact duplicates only
+     * @param outIndices Receives count vertex indices
+     * @param outVertices Receives the welded vertices as interleaved x, y, z
+     */
+    static Stats weldSoup(const float* x, const float* y, const float* z,
+                          std::size_t count, float epsilon,
+                          std::uint32_t* outIndices,
+                          std::vector<float>& outVertices);
+
+    std::size_t vertexCount() const { return m_vertices.size() / 3; }
+    float epsilon() const { return m_epsilon; }
+    const Stats& stats() const { return m_stats; }
+
+private:
+    struct CellKey {
+        std::int64_t x;
+        std::int64_t y;
+        std::int64_t z;
+        bool operator==(const CellKey& o) const { return x == o.x && y == o.y && z == o.z; }
+    };
+
+    struct CellKeyHash {
+        std::size_t operator()(const CellKey& k) const;
+    };
+
+    static constexpr std::uint32_t NoVertex = 0xFFFFFFFFu;
+
+    float m_epsilon;
+    double m_invCellSize;
+    std::vector<float> m_vertices;
+    std::vector<std::uint32_t> m_next;                          // per-vertex bucket chain
+    std::unordered_map<CellKey, std::uint32_t, CellKeyHash> m_cells;  // cell -> newest vertex
+    Stats m_stats;
+
+    std::int64_t cellOf(double v) const;
+    std::uint32_t findClose(float x, float y, float z) const;
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // VERTEXWELDER_H
@@ -0,0 +1,53 @@
+#include "VtkMeshAdapter.h"
+
+#include <vtkCellArray.h>
+#include <vtkFloatArray.h>
+#include <vtkPoints.h>
+#include <vtkTypeInt32Array.h>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+vtkSmartPointer<vtkPolyData> VtkMeshAdapter::toPolyData(const Domain::TriangleMesh& mesh) {
+    // save = 1: VTK reads the buffers in place and never frees or resizes them
+    vtkSmartPointer<vtkFloatArray> coords = vtkSmartPointer<vtkFloatArray>::New();
+    coords->SetNumberOfComponents(3);
+    coords->SetArray(const_cast<float*>(mesh.vertices.data()),
+                     static_cast<vtkIdType>(mesh.vertices.size()), 1);
+
+    vtkSmartPointer<vtkPoints> points = vtkSmartPointer<vtkPoints>::New();
+    points->SetData(coords);
+
+    // Indices stay below 2^31 for any mesh that fits in memory, so the
+    // unsigned buffer can back VTK's 32-bit connectivity storage directly.
+    vtkSmartPointer<vtkTypeInt32Array> connectivity = vtkSmartPointer<vtkTypeInt32Array>::New();
+    connectivity->SetArray(reinterpret_cast<vtkTypeInt32*>(const_cast<std::uint32_t*>(mesh.indices.data())),
+                           static_cast<vtkIdType>(mesh.indices.size()), 1);
+
+    vtkSmartPointer<vtkCellArray> polys = vtkSmartPointer<vtkCellArray>::New();
+    polys->SetData(3, connectivity);
+
+    vtkSmartPointer<vtkPolyData> polyData = vtkSmartPointer<vtkPolyData>::New();
+    polyData->SetPoints(points);
+    polyData->SetPolys(polys);
+    return polyData;
+}
+
+std::shared_ptr<void> VtkMeshAdapter::wrapNative(std::shared_ptr<const Domain::TriangleMesh> mesh) {
+    if (!mesh || mesh->empty()) {
+        return nullptr;
+    }
+
+    vtkSmartPointer<vtkPolyData> polyData = toPolyData(*mesh);
+    polyData->Register(nullptr); // ownership passes to the shared_ptr below
+
+    // The deleter keeps the mesh buffers alive for as long as the handle is
+    return std::shared_ptr<void>(polyData.GetPointer(), [mesh](void* p) {
+        if (p) {
+            static_cast<vtkPolyData*>(p)->UnRegister(nullptr);
+        }
+    });
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
@@ -0,0 +1,40 @@
+#ifndef VTKMESHADAPTER_H
+#define VTKMESHADAPTER_H
+
+#include "../core/domain/TriangleMesh.h"
+
+#include <vtkSmartPointer.h>
+#include <vtkPolyData.h>
+#include <memory>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief Exposes a Domain::TriangleMesh to VTK without copying it
+ *
+ * The point and connectivity arrays of the resulting vtkPolyData alias the
+ * mesh buffers (VTK is told not to free them). The mesh must therefore
+ * outlive every VTK object that reads the polydata; wrapNative() takes care
+ * of that for the MeshData::nativeData handle.
+ */
+class VtkMeshAdapter {
+public:
+    /**
+     * @brief Build a polydata viewing the mesh's vertex and index buffers
+     */
+    static vtkSmartPointer<vtkPolyData> toPolyData(const Domain::TriangleMesh& mesh);
+
+    /**
+     * @brief Build the opaque nativeData handle for MeshData
+     *
+     * The returned pointer is a vtkPolyData* that holds one VTK reference
+     * and a shared reference to the mesh, both released together.
+     */
+    static std::shared_ptr<void> wrapNative(std::shared_ptr<const Domain::TriangleMesh> mesh);
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // VTKMESHADAPTER_H
@@ -5,8 +5,10 @@
 namespace MarcSLM {
 namespace Infrastructure {
 
-VtkModelRenderer::VtkModelRenderer(vtkSmartPointer<vtkRenderer> renderer)
+VtkModelRenderer::VtkModelRenderer(vtkSmartPointer<vtkRenderer> renderer,
+                                   std::shared_ptr<ActorRegistry> actors)
     : m_renderer(renderer)
+    , m_registry(actors ? std::move(actors) : std::make_shared<ActorRegistry>())
     , m_nextActorId(1)
 {
 }
@@ -45,6 +47,7 @@ int VtkModelRenderer::addModel(const Domain::Model& model, const std::shared_ptr
     data.mapper = mapper;
     data.meshData = meshData; // keep shared ownership so polydata isn't freed
     m_actors[actorId] = data;
+    m_registry->add(actorId, actor);
 
     // Add to renderer
     if (m_renderer) {
@@ -74,6 +77,7 @@ void VtkModelRenderer::removeModel(int actorId) {
     }
     // actor and mapper smart pointers will release here; meshData shared_ptr will
     // release and call UnRegister on vtkPolyData if this was the last owner.
+    m_registry->remove(actorId);
     m_actors.erase(it);
 }
 
@@ -95,6 +99,7 @@ void VtkModelRenderer::clearScene() {
         // still detached from renderer to avoid VTK accessing freed memory
         pair.second.meshData.reset();
     }
+    m_registry->clear();
     m_actors.clear();
     m_nextActorId = 1;
 }
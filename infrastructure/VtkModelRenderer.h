@@ -2,6 +2,7 @@
 #define VTKMODELRENDERER_H
 
 #include "../core/application/interfaces/IModelRenderer.h"
+#include "ActorRegistry.h"
 
 #include <vtkSmartPointer.h>
 #include <vtkRenderer.h>
@@ -21,10 +22,19 @@ namespace Infrastructure {
  * Manages VTK actors and their transforms, syncing with domain Model data.
  * This class owns the rendering-specific VTK objects but does not own
  * the business data (transforms, bounds, etc.) - those live in Model.
+ * 
+ * Every model actor is also entered in an ActorRegistry under its actor
+ * id, which other scene code can share to look actors up directly.
  */
 class VtkModelRenderer : public Application::IModelRenderer {
 public:
-    explicit VtkModelRenderer(vtkSmartPointer<vtkRenderer> renderer);
+    /**
+     * @param renderer Renderer the model actors are added to
+     * @param actors Registry to keep in step with the actors; a new one
+     *        if null
+     */
+    explicit VtkModelRenderer(vtkSmartPointer<vtkRenderer> renderer,
+                              std::shared_ptr<ActorRegistry> actors = nullptr);
     ~VtkModelRenderer() override = default;
     
     // IModelRenderer interface
@@ -35,18 +45,23 @@ public:
     void clearScene() override;
     void render() override;
     
+    std::shared_ptr<const ActorRegistry> actorRegistry() const { return m_registry; }
+    
 private:
     struct ActorData {
-        vtkSmartPointer<vtkActor> actor;
-        vtkSmartPointer<vtkTransform> transform;
-        vtkSmartPointer<vtkPolyDataMapper> mapper;
         // Keep a shared ownership of the raw VTK polydata to prevent it from
         // being destroyed while the actor/mapper are still using it.
+        // Declared first so it is released last: the polydata may view
+        // buffers owned by this handle (see VtkMeshAdapter).
         std::shared_ptr<void> meshData;
+        vtkSmartPointer<vtkActor> actor;
+        vtkSmartPointer<vtkTransform> transform;
+        vtkSmartPointer<vtkPolyDataMapper> mapper;
     };
     
     vtkSmartPointer<vtkRenderer> m_renderer;  // Now owned/shared via smart pointer
     std::map<int, ActorData> m_actors;
+    std::shared_ptr<ActorRegistry> m_registry;
     int m_nextActorId = 1;
     
     void applyTransform(vtkTransform* vtkTrans, const Domain::Transform& domainTrans);
@@ -0,0 +1,255 @@
+#include "ZipArchive.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <limits>
+
+#include <vtk_zlib.h>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+namespace {
+
+constexpr std::uint32_t EndOfCentralDirSig = 0x06054b50;
+constexpr std::uint32_t Zip64LocatorSig = 0x07064b50;
+constexpr std::uint32_t Zip64EndOfCentralDirSig = 0x06064b50;
+constexpr std::uint32_t CentralHeaderSig = 0x02014b50;
+constexpr std::uint32_t LocalHeaderSig = 0x04034b50;
+
+constexpr std::size_t EndOfCentralDirSize = 22;
+constexpr std::size_t Zip64LocatorSize = 20;
+constexpr std::size_t Zip64EndOfCentralDirSize = 56;
+constexpr std::size_t CentralHeaderSize = 46;
+constexpr std::size_t LocalHeaderSize = 30;
+constexpr std::size_t MaxCommentSize = 0xFFFF;
+
+constexpr std::uint16_t MethodStored = 0;
+constexpr std::uint16_t MethodDeflated = 8;
+constexpr std::uint16_t Zip64ExtraId = 0x0001;
+
+// zlib counts in uInt; produce at most this much output per call
+constexpr std::size_t InflateWindow = 1u << 30;
+
+// Compressed input per call; also the progress and cancellation granularity
+constexpr std::size_t InputWindow = 1u << 20;
+
+// ZIP is little-endian, as are all supported targets
+template <typename T>
+T read(const char* p) {
+    T v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+std::string normalizedName(const std::string& name) {
+    std::string out = (!name.empty() && name[0] == '/') ? name.substr(1) : name;
+    std::transform(out.begin(), out.end(), out.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return out;
+}
+
+} // namespace
+
+bool ZipArchive::open(const std::string& filePath) {
+    m_entries.clear();
+    if (!m_file.open(filePath)) {
+        return false;
+    }
+    if (!readCentralDirectory()) {
+        m_entries.clear();
+        m_file.close();
+        return false;
+    }
+    return true;
+}
+
+bool ZipArchive::readCentralDirectory() {
+    const char* data = m_file.data();
+    const std::size_t size = m_file.size();
+    if (size < EndOfCentralDirSize) {
+        return false;
+    }
+
+    // The end record sits before an optional trailing comment
+    std::size_t eocd = std::numeric_limits<std::size_t>::max();
+    const std::size_t lowest = size > EndOfCentralDirSize + MaxCommentSize
+        ? size - EndOfCentralDirSize - MaxCommentSize : 0;
+    for (std::size_t pos = size - EndOfCentralDirSize + 1; pos-- > lowest;) {
+        if (read<std::uint32_t>(data + pos) == EndOfCentralDirSig) {
+            eocd = pos;
+            break;
+        }
+    }
+    if (eocd == std::numeric_limits<std::size_t>::max()) {
+        return false;
+    }
+
+    std::uint64_t entryCount = read<std::uint16_t>(data + eocd + 10);
+    std::uint64_t dirSize = read<std::uint32_t>(data + eocd + 12);
+    std::uint64_t dirOffset = read<std::uint32_t>(data + eocd + 16);
+
+    if (eocd >= Zip64LocatorSize &&
+        read<std::uint32_t>(data + eocd - Zip64LocatorSize) == Zip64LocatorSig) {
+        std::uint64_t zip64Eocd = read<std::uint64_t>(data + eocd - Zip64LocatorSize + 8);
+        if (zip64Eocd + Zip64EndOfCentralDirSize > size ||
+            read<std::uint32_t>(data + zip64Eocd) != Zip64EndOfCentralDirSig) {
+            return false;
+        }
+        entryCount = read<std::uint64_t>(data + zip64Eocd + 32);
+        dirSize = read<std::uint64_t>(data + zip64Eocd + 40);
+        dirOffset = read<std::uint64_t>(data + zip64Eocd + 48);
+    }
+
+    if (dirOffset > size || dirSize > size - dirOffset) {
+        return false;
+    }
+
+    const char* p = data + dirOffset;
+    const char* end = p + dirSize;
+    m_entries.reserve(static_cast<std::size_t>(std::min<std::uint64_t>(entryCount, dirSize / CentralHeaderSize)));
+
+    for (std::uint64_t i = 0; i < entryCount; ++i) {
+        if (end - p < static_cast<std::ptrdiff_t>(CentralHeaderSize) ||
+            read<std::uint32_t>(p) != CentralHeaderSig) {
+            return false;
+        }
+
+        Entry entry;
+        entry.method = read<std::uint16_t>(p + 10);
+        entry.crc = read<std::uint32_t>(p + 16);
+        entry.compressedSize = read<std::uint32_t>(p + 20);
+        entry.uncompressedSize = read<std::uint32_t>(p + 24);
+        const std::size_t nameLen = read<std::uint16_t>(p + 28);
+        const std::size_t extraLen = read<std::uint16_t>(p + 30);
+        const std::size_t commentLen = read<std::uint16_t>(p + 32);
+        entry.localHeaderOffset = read<std::uint32_t>(p + 42);
+
+        if (static_cast<std::size_t>(end - p) < CentralHeaderSize + nameLen + extraLen + commentLen) {
+            return false;
+        }
+        entry.name.assign(p + CentralHeaderSize, nameLen);
+
+        // ZIP64 extra field holds the real values of saturated fields, in order
+        const char* extra = p + CentralHeaderSize + nameLen;
+        const char* extraEnd = extra + extraLen;
+        while (extraEnd - extra >= 4) {
+            const std::uint16_t id = read<std::uint16_t>(extra);
+            const std::uint16_t len = read<std::uint16_t>(extra + 2);
+            const char* field = extra + 4;
+            const char* fieldEnd = field + std::min<std::ptrdiff_t>(len, extraEnd - field);
+            if (id == Zip64ExtraId) {
+                for (std::uint64_t* value : {&entry.uncompressedSize, &entry.compressedSize,
+                                             &entry.localHeaderOffset}) {
+                    if (*value == 0xFFFFFFFFu && fieldEnd - field >= 8) {
+                        *value = read<std::uint64_t>(field);
+                        field += 8;
+                    }
+                }
+            }
+            extra += 4 + len;
+        }
+
+        m_entries.push_back(std::move(entry));
+        p += CentralHeaderSize + nameLen + extraLen + commentLen;
+    }
+    return true;
+}
+
+const ZipArchive::Entry* ZipArchive::find(const std::string& name) const {
+    const std::string wanted = normalizedName(name);
+    for (const Entry& entry : m_entries) {
+        if (normalizedName(entry.name) == wanted) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+bool ZipArchive::extract(const Entry& entry, std::vector<char>& out,
+                         Application::LoadProgress* progress) const {
+    out.clear();
+    const char* data = m_file.data();
+    const std::size_t size = m_file.size();
+
+    if (entry.localHeaderOffset > size || size - entry.localHeaderOffset < LocalHeaderSize) {
+        return false;
+    }
+    const char* local = data + entry.localHeaderOffset;
+    if (read<std::uint32_t>(local) != LocalHeaderSig) {
+        return false;
+    }
+    const std::uint64_t payloadOffset = entry.localHeaderOffset + LocalHeaderSize
+        + read<std::uint16_t>(local + 26) + read<std::uint16_t>(local + 28);
+    if (payloadOffset > size || entry.compressedSize > size - payloadOffset) {
+        return false;
+    }
+    const char* payload = data + payloadOffset;
+
+    out.resize(static_cast<std::size_t>(entry.uncompressedSize));
+
+    if (entry.method == MethodStored) {
+        if (entry.compressedSize != entry.uncompressedSize) {
+            return false;
+        }
+        std::memcpy(out.data(), payload, out.size());
+        if (progress) {
+            progress->addBytes(out.size());
+        }
+    } else if (entry.method == MethodDeflated) {
+        z_stream stream;
+        std::memset(&stream, 0, sizeof(stream));
+        if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {  // raw deflate, no zlib header
+            return false;
+        }
+
+        std::uint64_t inLeft = entry.compressedSize;
+        std::uint64_t outLeft = entry.uncompressedSize;
+        std::uint64_t fed = 0;  // input already reported to progress
+        stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(payload));
+        stream.next_out = reinterpret_cast<Bytef*>(out.data());
+
+        int status = Z_OK;
+        while (status == Z_OK) {
+            if (stream.avail_in == 0) {
+                if (progress) {
+                    progress->addBytes(entry.compressedSize - inLeft - fed);
+                    fed = entry.compressedSize - inLeft;
+                    if (progress->isCancelled()) {
+                        break;
+                    }
+                }
+                stream.avail_in = static_cast<uInt>(std::min<std::uint64_t>(inLeft, InputWindow));
+                inLeft -= stream.avail_in;
+            }
+            if (stream.avail_out == 0) {
+                stream.avail_out = static_cast<uInt>(std::min<std::uint64_t>(outLeft, InflateWindow));
+                outLeft -= stream.avail_out;
+            }
+            status = inflate(&stream, Z_NO_FLUSH);
+            if (status == Z_BUF_ERROR && (inLeft > 0 || outLeft > 0)) {
+                status = Z_OK;  // only needs the next window
+            }
+        }
+        const bool complete = status == Z_STREAM_END && stream.avail_out == 0 && outLeft == 0;
+        inflateEnd(&stream);
+        if (!complete) {
+            return false;
+        }
+    } else {
+        return false;
+    }
+
+    // crc32 takes uInt lengths as well
+    uLong crc = crc32(0L, Z_NULL, 0);
+    for (std::size_t offset = 0; offset < out.size(); offset += InflateWindow) {
+        const std::size_t len = std::min(InflateWindow, out.size() - offset);
+        crc = crc32(crc, reinterpret_cast<const Bytef*>(out.data() + offset), static_cast<uInt>(len));
+    }
+    return static_cast<std::uint32_t>(crc) == entry.crc;
+}
+
+} // namespace Infrastructure
+} // namespace MarcSLM
@@ -0,0 +1,71 @@
+#ifndef ZIPARCHIVE_H
+#define ZIPARCHIVE_H
+
+#include "MappedFile.h"
+#include "../core/application/LoadProgress.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace MarcSLM {
+namespace Infrastructure {
+
+/**
+ * @brief Minimal read-only ZIP reader for OPC packages such as 3MF
+ *
+ * Reads the central directory (including ZIP64 records) straight from a
+ * memory mapping and inflates single entries on demand; compressed data is
+ * never copied. Only stored and deflated entries are supported, which is
+ * all the 3MF specification allows.
+ */
+class ZipArchive {
+public:
+    struct Entry {
+        std::string name;
+        std::uint16_t method = 0;
+        std::uint32_t crc = 0;
+        std::uint64_t compressedSize = 0;
+        std::uint64_t uncompressedSize = 0;
+        std::uint64_t localHeaderOffset = 0;
+    };
+
+    /**
+     * @brief Map an archive and read its central directory
+     * @return false if the file cannot be mapped or is not a ZIP archive
+     */
+    bool open(const std::string& filePath);
+
+    const std::vector<Entry>& entries() const { return m_entries; }
+
+    /**
+     * @brief Find an entry by part name
+     *
+     * Matching ignores ASCII case and a leading '/', as OPC part names do.
+     * @return nullptr if there is no such entry
+     */
+    const Entry* find(const std::string& name) const;
+
+    /**
+     * @brief Decompress an entry into a buffer of its exact size
+     *
+     * Input is streamed from the mapping through zlib; the CRC is verified.
+     * @param progress Optional; receives consumed compressed bytes and is
+     *        polled for cancellation between input windows
+     * @return false on unsupported method, corrupt data, CRC mismatch or
+     *         cancellation
+     */
+    bool extract(const Entry& entry, std::vector<char>& out,
+                 Application::LoadProgress* progress = nullptr) const;
+
+private:
+    MappedFile m_file;
+    std::vector<Entry> m_entries;
+
+    bool readCentralDirectory();
+};
+
+} // namespace Infrastructure
+} // namespace MarcSLM
+
+#endif // ZIPARCHIVE_H
@@ -11,9 +11,24 @@
 #include <vtkPolyDataNormals.h>
 #include <vtkSmartPointer.h>
 #include <vtkTransform.h>
+#include <vtkCellArray.h>
+#include <vtkCellArrayIterator.h>
+#include <vtkPoints.h>
+
+#include "../core/domain/ConvexHull.h"
+#include "../core/domain/Footprint.h"
+#include "../core/domain/MeshDecimator.h"
+#include "../core/domain/NormalHistogram.h"
+#include "../infrastructure/ContentHash.h"
+#include "../infrastructure/ParallelFor.h"
 
 #include <QDebug>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <limits>
+#include <utility>
+#include <vector>
 OrientationOptimizer::OrientationOptimizer(QObject* parent)
     : QObject(parent)
 {
@@ -25,6 +40,114 @@ void OrientationOptimizer::setCriticalFaceIds(const QVector<vtkIdType>& ids) {
     criticalFaceIds = ids;
 }
 
+namespace {
+
+// Face evaluations below which another thread costs more than it saves
+constexpr std::size_t MinFacesPerWorker = std::size_t(1) << 18;
+
+// Faces binned per histogram chunk; each chunk has its own histogram
+constexpr std::size_t MinFacesPerHistogram = std::size_t(1) << 16;
+
+// Angle between neighbouring vertices of the icosahedron, atan(2); each
+// subdivision halves it
+constexpr double IcosahedronEdgeRadians = 1.1071487177940904;
+
+// Refinement: basins explored, budget each needs to be worth it, the poll
+// of eight directions around the current one, and the finest step
+constexpr int MaxSeeds = 4;
+constexpr int EvaluationsPerSeed = 32;
+constexpr int RescoredPerSeed = 4;
+
+// Resting poses tried ahead of the sphere directions, largest contact first
+constexpr std::size_t MaxRestingPoses = 64;
+
+// Part of every cache key; bump when a change to the search changes results
+constexpr std::uint64_t SearchVersion = 3;
+
+constexpr int PollSize = 8;
+constexpr double MinStepDegrees = 0.25;
+
+// Height field cells along the footprint's longer side when measuring
+// support volume; about 1% from the converged volume at a few ms per call
+constexpr int SupportRasterCells = 128;
+
+double coarseSpacing(int levels) {
+    return IcosahedronEdgeRadians / static_cast<double>(1 << levels);
+}
+
+using Direction = MarcSLM::Domain::NormalHistogram::Direction;
+
+Direction cross(const Direction& a, const Direction& b) {
+    return { a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0] };
+}
+
+double dot(const Direction& a, const Direction& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Direction normalized(const Direction& v) {
+    const double len = std::sqrt(dot(v, v));
+    return { v[0] / len, v[1] / len, v[2] / len };
+}
+
+// Centroid of the solid mesh (signed tetrahedra against the hull centroid);
+// the hull's own centroid when the mesh is open or has no triangles
+Direction centerOfMass(const std::vector<float>& points, const std::vector<std::uint32_t>& indices,
+                       const MarcSLM::Domain::ConvexHull& hull) {
+    const Direction ref = hull.centroid();
+    Direction weighted = { 0, 0, 0 };
+    double volume = 0.0;
+    for (std::size_t t = 0; t + 2 < indices.size(); t += 3) {
+        Direction corner[3];
+        for (int k = 0; k < 3; ++k) {
+            const float* p = points.data() + 3 * static_cast<std::size_t>(indices[t + k]);
+            corner[k] = { p[0] - ref[0], p[1] - ref[1], p[2] - ref[2] };
+        }
+        const double v = dot(corner[0], cross(corner[1], corner[2])) / 6.0;
+        volume += v;
+        for (int k = 0; k < 3; ++k) {
+            weighted[k] += v * (corner[0][k] + corner[1][k] + corner[2][k]) / 4.0;
+        }
+    }
+    if (!(std::fabs(volume) > 0.0)) {
+        return ref;
+    }
+    return { ref[0] + weighted[0] / volume, ref[1] + weighted[1] / volume, ref[2] + weighted[2] / volume };
+}
+
+// Quadric-decimated copy of a mesh with about the given number of faces.
+// Critical faces come through unchanged and keep their flags; normals and
+// centroids share the full mesh's origin.
+// deviation receives the decimator's bound on how far vertices moved
+OrientationOptimizer::MeshSample decimatedProxy(const OrientationOptimizer::MeshSample& mesh, std::size_t faces,
+                                                double& deviation) {
+    MarcSLM::Domain::DecimatedMesh decimated =
+        MarcSLM::Domain::MeshDecimator::decimate(mesh.points, mesh.indices, faces, mesh.faces.critical);
+    deviation = std::sqrt(decimated.maxError);
+
+    OrientationOptimizer::MeshSample proxy;
+    std::copy(mesh.faces.origin, mesh.faces.origin + 3, proxy.faces.origin);
+    proxy.faces.reserve(decimated.sourceFaces.size());
+    for (std::size_t t = 0; t < decimated.sourceFaces.size(); ++t) {
+        double corner[3][3];
+        for (int k = 0; k < 3; ++k) {
+            const float* p = decimated.points.data() + 3 * static_cast<std::size_t>(decimated.indices[3 * t + k]);
+            corner[k][0] = p[0];
+            corner[k][1] = p[1];
+            corner[k][2] = p[2];
+        }
+        proxy.faces.addTriangle(corner[0], corner[1], corner[2]);
+        if (!mesh.faces.critical.empty()) {
+            proxy.faces.critical.push_back(mesh.faces.critical[decimated.sourceFaces[t]]);
+        }
+    }
+    proxy.points = std::move(decimated.points);
+    proxy.indices = std::move(decimated.indices);
+    return proxy;
+}
+
+} // namespace
+
 // Optimize orientation based on minimal support area (lower Z-facing surfaces)
 void OrientationOptimizer::optimizeModelOrientation(ModelInfo& model, double overhangThresholdDegrees) {
     if (!model.actor) {
@@ -32,56 +155,504 @@ void OrientationOptimizer::optimizeModelOrientation(ModelInfo& model, double ove
         return;
     }
 
+    // Normals and areas once; a candidate rotation then only changes the
+    // build direction they are scored against, so no mesh is transformed.
+    const MeshSample mesh = sampleMesh(model);
+    if (mesh.faces.empty()) {
+        return;
+    }
+
+    applyOrientation(model, findBestOrientation(mesh, overhangThresholdDegrees));
+}
+
+OrientationOptimizer::MeshSample OrientationOptimizer::sampleMesh(const ModelInfo& model) {
+    MeshSample sample;
     auto mesh = getPolyData(model.actor);
     if (!mesh) {
         //qWarning("optimizeModelOrientation: Failed to get vtkPolyData from actor.");
         emit logMessage(QString(" Failed to get vtkPolyData from actor."));
-        return;
+        return sample;
+    }
+
+    sample.faces = extractFaceNormals(mesh);
+    if (vtkPoints* points = mesh->GetPoints()) {
+        sample.points.reserve(3 * static_cast<std::size_t>(points->GetNumberOfPoints()));
+        for (vtkIdType i = 0; i < points->GetNumberOfPoints(); ++i) {
+            double p[3];
+            points->GetPoint(i, p);
+            sample.points.push_back(static_cast<float>(p[0]));
+            sample.points.push_back(static_cast<float>(p[1]));
+            sample.points.push_back(static_cast<float>(p[2]));
+        }
+    }
+    if (vtkCellArray* polys = mesh->GetPolys()) {
+        sample.indices.reserve(3 * static_cast<std::size_t>(polys->GetNumberOfCells()));
+        auto it = vtk::TakeSmartPointer(polys->NewIterator());
+        for (it->GoToFirstCell(); !it->IsDoneWithTraversal(); it->GoToNextCell()) {
+            vtkIdType npts = 0;
+            const vtkIdType* pts = nullptr;
+            it->GetCurrentCell(npts, pts);
+            if (npts != 3) continue;
+            for (int k = 0; k < 3; ++k) {
+                sample.indices.push_back(static_cast<std::uint32_t>(pts[k]));
+            }
+        }
+    }
+    return sample;
+}
+
+void OrientationOptimizer::setSearchResolution(int histogramSubdivisions, int coarseSubdivisions) {
+    histogramLevels = std::max(0, histogramSubdivisions);
+    coarseLevels = std::max(0, coarseSubdivisions);
+}
+
+void OrientationOptimizer::setWeights(double supportArea, double supportVolume, double buildHeight,
+                                      double criticalSurface) {
+    weightSupportArea = supportArea;
+    weightSupportVolume = supportVolume;
+    weightBuildHeight = buildHeight;
+    weightCriticalSurface = criticalSurface;
+}
+
+void OrientationOptimizer::setEvaluationBudget(int evaluations) {
+    evaluationBudget = std::max(1, evaluations);
+}
+
+void OrientationOptimizer::setProxyFaceCount(int faces) {
+    proxyFaceCount = std::max(0, faces);
+}
+
+std::uint64_t OrientationOptimizer::cacheKey(const MeshSample& mesh, double overhangThresholdDegrees) const {
+    using MarcSLM::Infrastructure::ContentHash;
+    auto bytesOf = [](const auto& values) {
+        return ContentHash::of(reinterpret_cast<const char*>(values.data()),
+                               values.size() * sizeof(values[0]));
+    };
+    auto bitsOf = [](double value) {
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    };
+
+    std::uint64_t key = ContentHash::combine(bytesOf(mesh.points), bytesOf(mesh.indices));
+    key = ContentHash::combine(key, bytesOf(mesh.faces.critical));
+    key = ContentHash::combine(key, bitsOf(overhangThresholdDegrees));
+    for (double weight : { weightSupportArea, weightSupportVolume, weightBuildHeight, weightCriticalSurface }) {
+        key = ContentHash::combine(key, bitsOf(weight));
     }
+    key = ContentHash::combine(key, static_cast<std::uint64_t>(histogramLevels));
+    key = ContentHash::combine(key, static_cast<std::uint64_t>(coarseLevels));
+    key = ContentHash::combine(key, static_cast<std::uint64_t>(evaluationBudget));
+    key = ContentHash::combine(key, static_cast<std::uint64_t>(proxyFaceCount));
+    return ContentHash::combine(key, SearchVersion);
+}
+
+std::vector<Direction> OrientationOptimizer::coarseDirections(const MarcSLM::Domain::ConvexHull& hull,
+                                                              const Direction& centerOfMass) const {
+    // Stable resting poses first: the contact facet faces the plate, so up
+    // is opposite its normal. Largest contact first, so that among equal
+    // scores the part keeps its broadest face on the plate.
+    std::vector<Direction> directions;
+    for (const auto& pose : hull.restingPoses(centerOfMass)) {
+        if (directions.size() == MaxRestingPoses) break;
+        directions.push_back({ -pose.down[0], -pose.down[1], -pose.down[2] });
+    }
+
+    // Then the six axes, so an axis-aligned part stays as it is (+Z: no
+    // rotation), and directions spread over the sphere: support optima
+    // often tilt the part off every facet
+    const std::vector<Direction> axes = {
+        { 0, 0, 1 }, { 0, 0, -1 }, { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 },
+    };
+    const auto sphere = MarcSLM::Domain::NormalHistogram::sphereDirections(coarseLevels);
+    directions.insert(directions.end(), axes.begin(), axes.end());
+    directions.insert(directions.end(), sphere.begin(), sphere.end());
+    return directions;
+}
+
+std::size_t OrientationOptimizer::coarseCount() const {
+    return MaxRestingPoses + 6 + 10 * (std::size_t(1) << (2 * coarseLevels)) + 2;
+}
+
+long long OrientationOptimizer::candidatesPerModel() const {
+    return static_cast<long long>(coarseCount()) + evaluationBudget;
+}
 
-    double angleThreshold = vtkMath::RadiansFromDegrees(overhangThresholdDegrees);
-    double bestScore = std::numeric_limits<double>::max();
-    vtkSmartPointer<vtkTransform> bestTransform = vtkSmartPointer<vtkTransform>::New();
+OrientationOptimizer::OrientationResult OrientationOptimizer::findBestOrientation(
+    const MeshSample& mesh, double overhangThresholdDegrees) {
+    candidatesDone.store(0);
+    lastPercent.store(-1);
+    candidatesTotal = candidatesPerModel();
+    return searchCandidates(mesh, overhangThresholdDegrees);
+}
 
-    double b_roll = 0.0, b_pitch = 0.0;
+QVector<OrientationOptimizer::OrientationResult> OrientationOptimizer::findBestOrientations(
+    const QVector<MeshSample>& models, double overhangThresholdDegrees) {
+    candidatesDone.store(0);
+    lastPercent.store(-1);
+    candidatesTotal = candidatesPerModel() * models.size();
 
-    for (double pitch = 0; pitch <= 180; pitch += 5) {
-        for (double roll = 0; roll <= 360; roll += 10) {
-            auto transform = vtkSmartPointer<vtkTransform>::New();
-            transform->Identity();
-            transform->RotateY(pitch);
-            transform->RotateX(roll);
+    QVector<OrientationResult> results;
+    results.reserve(models.size());
+    for (const auto& mesh : models) {
+        results.append(searchCandidates(mesh, overhangThresholdDegrees));
+    }
+    return results;
+}
 
-            auto transformer = vtkSmartPointer<vtkTransformPolyDataFilter>::New();
-            transformer->SetInputData(mesh);
-            transformer->SetTransform(transform);
-            transformer->Update();
+MarcSLM::Domain::NormalHistogram OrientationOptimizer::buildHistogram(const MarcSLM::Domain::FaceNormals& faces) const {
+    const MarcSLM::Domain::NormalHistogram empty(histogramLevels);
+
+    // Per-chunk histograms merged in chunk order: the sums do not depend
+    // on the number of threads
+    std::vector<MarcSLM::Domain::NormalHistogram> partial(
+        MarcSLM::Infrastructure::parallelWorkerCount(faces.size(), MinFacesPerHistogram), empty);
+    const unsigned chunks = MarcSLM::Infrastructure::parallelForChunks(
+        faces.size(), MinFacesPerHistogram,
+        [&](unsigned chunk, std::size_t begin, std::size_t end) {
+            partial[chunk].add(faces, begin, end);
+        });
+
+    MarcSLM::Domain::NormalHistogram histogram = empty;
+    for (unsigned chunk = 0; chunk < chunks; ++chunk) {
+        histogram.merge(partial[chunk]);
+    }
+    return histogram;
+}
 
-            auto rotated = transformer->GetOutput();
-            if (!rotated) {
-                qWarning("optimizeModelOrientation: Transformation failed.");
-                continue;
+std::vector<double> OrientationOptimizer::scoreDirections(const MarcSLM::Domain::FaceNormals& faces,
+                                                          const std::vector<Direction>& directions,
+                                                          const ScoreContext& context) {
+    std::vector<double> scores(directions.size(), std::numeric_limits<double>::max());
+    if (faces.empty()) {
+        return scores;
+    }
+
+    // The rasterizer already runs on all cores; candidates then go in turn
+    const std::size_t minCandidatesPerWorker = context.raster
+        ? directions.size()
+        : std::max<std::size_t>(1, MinFacesPerWorker / faces.size());
+    MarcSLM::Infrastructure::parallelForChunks(
+        directions.size(), minCandidatesPerWorker,
+        [&](unsigned, std::size_t begin, std::size_t end) {
+            for (std::size_t c = begin; c < end; ++c) {
+                if (isCancelled()) {
+                    break;
+                }
+                scores[c] = scoreCandidate(faces, directions[c].data(), context);
+                reportCandidateDone();
             }
+        });
+    return scores;
+}
 
-            double supportVol = computeSupportVolume(rotated, angleThreshold);
-            double score = supportVol;
+OrientationOptimizer::OrientationResult OrientationOptimizer::searchCandidates(
+    const MeshSample& mesh, double overhangThresholdDegrees) {
+    OrientationResult best;
+    if (mesh.faces.empty() || isCancelled()) {
+        candidatesDone.fetch_add(candidatesPerModel());
+        return best;
+    }
 
-            if (score < bestScore) {
-                bestScore = score;
-                bestTransform->DeepCopy(transform);
-                b_roll = roll;
-                b_pitch = pitch;
+    // Extents (plate height, build height, footprint) only need the hull,
+    // which is taken from the full mesh either way
+    const MarcSLM::Domain::ConvexHull hull = MarcSLM::Domain::ConvexHull::compute(mesh.points);
+
+    // Large meshes are searched on a decimated proxy, built once per model,
+    // when support volume is weighted: rasterizing dominates then. The
+    // per-face terms alone stream through the full mesh faster than it can
+    // be decimated. The proxy's candidates are rescored on the full mesh,
+    // and the largest change seen among them is reported with the result.
+    const bool useProxy = proxyFaceCount > 0 && weightSupportVolume != 0.0 &&
+                          mesh.faces.size() > 2 * static_cast<std::size_t>(proxyFaceCount);
+    double proxyDeviation = 0.0;
+    const MeshSample proxy = useProxy
+        ? decimatedProxy(mesh, static_cast<std::size_t>(proxyFaceCount), proxyDeviation)
+        : MeshSample();
+    std::vector<std::pair<double, Direction>> found =
+        searchDirections(useProxy ? proxy : mesh, hull, overhangThresholdDegrees);
+    if (isCancelled() || found.empty()) {
+        return best;
+    }
+
+    double proxyScoreGap = 0.0;
+    if (useProxy) {
+        ScoreContext context = makeScoreContext(mesh.faces, hull, overhangThresholdDegrees);
+        MarcSLM::Infrastructure::SupportRasterizer raster(mesh.points.data(), mesh.points.size() / 3,
+                                                          mesh.indices.data(), mesh.indices.size() / 3);
+        raster.setResolution(SupportRasterCells);
+        if (weightSupportVolume != 0.0 && !raster.empty()) {
+            context.raster = &raster;
+        }
+        for (auto& candidate : found) {
+            const double score = scoreCandidate(mesh.faces, candidate.second.data(), context);
+            proxyScoreGap = std::max(proxyScoreGap, std::fabs(score - candidate.first));
+            candidate.first = score;
+        }
+    }
+
+    // Best first; refined seeds that met in one basin are reported once
+    std::stable_sort(found.begin(), found.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    orientationForUp(found.front().second, hull, best);
+    best.score = found.front().first;
+    if (useProxy) {
+        best.proxyScoreGap = proxyScoreGap;
+        best.proxyCandidates = static_cast<int>(found.size());
+        best.proxyDeviation = proxyDeviation;
+    }
+    best.valid = true;
+    const double distinct = std::cos(coarseSpacing(coarseLevels));
+    for (std::size_t k = 1; k < found.size(); ++k) {
+        bool duplicate = false;
+        for (std::size_t j = 0; j < k && !duplicate; ++j) {
+            duplicate = dot(found[k].second, found[j].second) > distinct;
+        }
+        if (duplicate) continue;
+
+        OrientationResult alternative;
+        orientationForUp(found[k].second, hull, alternative);
+        alternative.score = found[k].first;
+        alternative.valid = true;
+        best.alternatives.push_back(alternative);
+    }
+    return best;
+}
+
+std::vector<std::pair<double, Direction>> OrientationOptimizer::searchDirections(
+    const MeshSample& mesh, const MarcSLM::Domain::ConvexHull& hull, double overhangThresholdDegrees) {
+    std::vector<std::pair<double, Direction>> found;
+    const MarcSLM::Domain::FaceNormals& faces = mesh.faces;
+    ScoreContext context = makeScoreContext(faces, hull, overhangThresholdDegrees);
+
+    // Support volume is rasterized only on the mesh itself; the coarse
+    // stage keeps the per-face estimate, so seeds are rescored before refining
+    const ScoreContext coarseContext = context;
+    MarcSLM::Infrastructure::SupportRasterizer raster(mesh.points.data(), mesh.points.size() / 3,
+                                                      mesh.indices.data(), mesh.indices.size() / 3);
+    raster.setResolution(SupportRasterCells);
+    if (weightSupportVolume != 0.0 && !raster.empty()) {
+        context.raster = &raster;
+    }
+
+    // Coarse: directions a few degrees apart scored against the histogram
+    // bins, a few thousand "faces" instead of millions. Meshes smaller than
+    // that are scored directly, which is already exact.
+    const std::vector<Direction> coarse =
+        coarseDirections(hull, centerOfMass(mesh.points, mesh.indices, hull));
+    candidatesDone.fetch_add(static_cast<long long>(coarseCount() - coarse.size()));
+    const MarcSLM::Domain::FaceNormals bins = buildHistogram(faces).bins();
+    const bool approximate = bins.size() < faces.size();
+    const std::vector<double> coarseScores =
+        scoreDirections(approximate ? bins : faces, coarse, coarseContext);
+    if (isCancelled()) {
+        return found;
+    }
+
+    // Seeds: the best coarse directions of distinct basins. Equal scores
+    // keep candidate order, so the outcome matches a serial scan whatever
+    // the thread count.
+    std::vector<std::size_t> order(coarse.size());
+    for (std::size_t i = 0; i < order.size(); ++i) order[i] = i;
+    std::sort(order.begin(), order.end(), [&coarseScores](std::size_t a, std::size_t b) {
+        return coarseScores[a] < coarseScores[b] || (coarseScores[a] == coarseScores[b] && a < b);
+    });
+
+    // Coarse scores that only approximate the mesh's score (histogram
+    // bins, per-face support volume) rank basins roughly; a wider pool is
+    // rescored on the mesh and the seeds taken from that
+    const bool rescore = approximate || context.raster;
+    const int seedCount = std::clamp(evaluationBudget / EvaluationsPerSeed, 1, MaxSeeds);
+    const int poolSize = rescore ? std::min(seedCount * RescoredPerSeed, evaluationBudget) : seedCount;
+    const double separation = std::cos(2.0 * coarseSpacing(coarseLevels));
+    std::vector<std::size_t> pool;
+    for (std::size_t i : order) {
+        if (static_cast<int>(pool.size()) == poolSize) break;
+        bool distinct = true;
+        for (std::size_t s : pool) {
+            if (dot(coarse[i], coarse[s]) > separation) {
+                distinct = false;
+                break;
             }
         }
+        if (distinct) pool.push_back(i);
+    }
+
+    int budget = evaluationBudget;
+    std::vector<double> poolScores(pool.size());
+    for (std::size_t k = 0; k < pool.size(); ++k) {
+        poolScores[k] = coarseScores[pool[k]];
+    }
+    if (rescore) {
+        std::vector<Direction> directions;
+        for (std::size_t i : pool) directions.push_back(coarse[i]);
+        poolScores = scoreDirections(faces, directions, context);
+        budget -= static_cast<int>(pool.size());
+    }
+    std::vector<std::size_t> ranked(pool.size());
+    for (std::size_t k = 0; k < ranked.size(); ++k) ranked[k] = k;
+    std::stable_sort(ranked.begin(), ranked.end(), [&poolScores](std::size_t a, std::size_t b) {
+        return poolScores[a] < poolScores[b];
+    });
+    if (ranked.size() > static_cast<std::size_t>(seedCount)) {
+        ranked.resize(seedCount);
     }
 
-    model.actor->SetUserTransform(bestTransform);
-    model.best_orientation_angles[0] = b_roll;
-    model.best_orientation_angles[1] = b_pitch;
-    model.best_orientation_angles[2] = 0.0; // yaw assumed 0
+    // Fine: pattern search from each seed in turn, the budget shared
+    // between them. Seeds the budget does not reach keep their pool score.
+    for (std::size_t k : ranked) {
+        if (isCancelled()) break;
 
-    emit logMessage(QString("Best Orientation Found - Roll: %1, Pitch: %2").arg(b_roll).arg(b_pitch));
+        double score = poolScores[k];
+        Direction up = coarse[pool[k]];
+        if (budget > 0) {
+            up = refineDirection(faces, up, score, context, budget);
+        }
+        found.emplace_back(score, up);
+    }
+    candidatesDone.fetch_add(std::max(0, budget));
+    return found;
+}
 
+Direction OrientationOptimizer::refineDirection(const MarcSLM::Domain::FaceNormals& faces, Direction up,
+                                                double& score, const ScoreContext& context, int& budget) {
+    const double minStep = vtkMath::RadiansFromDegrees(MinStepDegrees);
+    double step = 0.5 * coarseSpacing(coarseLevels);
+
+    while (step >= minStep && budget >= PollSize && !isCancelled()) {
+        // Poll eight directions at angle step around up, in its tangent plane
+        const Direction helper = std::fabs(up[2]) < 0.9 ? Direction{ 0, 0, 1 } : Direction{ 1, 0, 0 };
+        const Direction t1 = normalized(cross(up, helper));
+        const Direction t2 = cross(up, t1);
+
+        std::vector<Direction> poll(PollSize);
+        for (int k = 0; k < PollSize; ++k) {
+            const double phi = 2.0 * vtkMath::Pi() * k / PollSize;
+            for (int i = 0; i < 3; ++i) {
+                poll[k][i] = up[i] * std::cos(step) +
+                             std::sin(step) * (std::cos(phi) * t1[i] + std::sin(phi) * t2[i]);
+            }
+            poll[k] = normalized(poll[k]);
+        }
+        const std::vector<double> scores = scoreDirections(faces, poll, context);
+        budget -= PollSize;
+
+        int moveTo = -1;
+        for (int k = 0; k < PollSize; ++k) {
+            if (scores[k] < score && (moveTo < 0 || scores[k] < scores[moveTo])) {
+                moveTo = k;
+            }
+        }
+        if (moveTo >= 0) {
+            up = poll[moveTo];
+            score = scores[moveTo];
+        } else {
+            step *= 0.5;
+        }
+    }
+    return up;
+}
+
+void OrientationOptimizer::orientationForUp(const Direction& up, const MarcSLM::Domain::ConvexHull& hull,
+                                            OrientationResult& result) {
+    // Shortest rotation taking up onto +Z (Rodrigues)
+    double R[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+    const double c = std::clamp(up[2], -1.0, 1.0);
+    if (c < -1.0 + 1e-12) {
+        R[1][1] = R[2][2] = -1.0;  // upside down: half turn about X
+    } else if (c < 1.0 - 1e-12) {
+        const Direction axis = normalized(cross(up, { 0, 0, 1 }));
+        const double s = std::sqrt(1.0 - c * c);
+        const double K[3][3] = { { 0, -axis[2], axis[1] }, { axis[2], 0, -axis[0] }, { -axis[1], axis[0], 0 } };
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                double kk = 0.0;
+                for (int m = 0; m < 3; ++m) kk += K[i][m] * K[m][j];
+                R[i][j] += s * K[i][j] + (1.0 - c) * kk;
+            }
+        }
+    }
+
+    // Yaw: align the smallest rectangle around the footprint with the plate.
+    // The footprint's outline is the projection of hull vertices.
+    std::vector<MarcSLM::Domain::Point2> footprint;
+    footprint.reserve(hull.vertices().size());
+    for (const auto& p : hull.vertices()) {
+        footprint.push_back({ R[0][0] * p[0] + R[0][1] * p[1] + R[0][2] * p[2],
+                              R[1][0] * p[0] + R[1][1] * p[1] + R[1][2] * p[2] });
+    }
+    const double theta = MarcSLM::Domain::Footprint::minimumAreaRectangle(
+        MarcSLM::Domain::Footprint::convexHull(std::move(footprint))).angle;
+
+    // M = Rz(-theta) R, written as Rz(yaw) Ry(pitch) Rx(roll): the product
+    // StlViewer builds with PostMultiply RotateX, RotateY, RotateZ, and the
+    // order of Domain::Transform::matrix()
+    const double cz = std::cos(-theta), sz = std::sin(-theta);
+    double M[3][3];
+    for (int j = 0; j < 3; ++j) {
+        M[0][j] = cz * R[0][j] - sz * R[1][j];
+        M[1][j] = sz * R[0][j] + cz * R[1][j];
+        M[2][j] = R[2][j];
+    }
+
+    const double pitch = -std::asin(std::clamp(M[2][0], -1.0, 1.0));
+    double roll = 0.0, yaw = 0.0;
+    if (std::cos(pitch) > 1e-9) {
+        roll = std::atan2(M[2][1], M[2][2]);
+        yaw = std::atan2(M[1][0], M[0][0]);
+    } else {
+        roll = std::atan2(-M[1][2], M[1][1]);  // gimbal lock: yaw folded into roll
+    }
+    result.roll = vtkMath::DegreesFromRadians(roll);
+    result.pitch = vtkMath::DegreesFromRadians(pitch);
+    result.yaw = vtkMath::DegreesFromRadians(yaw);
+}
+
+void OrientationOptimizer::reportCandidateDone() {
+    const long long done = candidatesDone.fetch_add(1) + 1;
+    if (candidatesTotal <= 0) {
+        return;
+    }
+    const int percent = static_cast<int>(done * 100 / candidatesTotal);
+
+    // Only the thread that moves the percentage forward emits it
+    int previous = lastPercent.load();
+    while (percent > previous) {
+        if (lastPercent.compare_exchange_weak(previous, percent)) {
+            emit progressChanged(percent);
+            break;
+        }
+    }
+}
+
+void OrientationOptimizer::applyOrientation(ModelInfo& model, const OrientationResult& result) {
+    if (!result.valid || !model.actor) {
+        return;
+    }
+
+    model.actor->SetUserTransform(transformFor(result));
+    model.best_orientation_angles[0] = vtkMath::RadiansFromDegrees(result.roll);
+    model.best_orientation_angles[1] = vtkMath::RadiansFromDegrees(result.pitch);
+    model.best_orientation_angles[2] = vtkMath::RadiansFromDegrees(result.yaw);
+
+    emit logMessage(QString("Best Orientation Found - Roll: %1, Pitch: %2, Yaw: %3")
+        .arg(result.roll).arg(result.pitch).arg(result.yaw));
+    if (result.proxyCandidates > 0) {
+        emit logMessage(QString("Searched on a decimated proxy (surface within %1 mm); largest observed "
+                                "score gap among %2 rescored candidates: %3")
+            .arg(result.proxyDeviation).arg(result.proxyCandidates).arg(result.proxyScoreGap));
+    }
+}
+
+vtkSmartPointer<vtkTransform> OrientationOptimizer::transformFor(const OrientationResult& result) {
+    vtkSmartPointer<vtkTransform> transform = vtkSmartPointer<vtkTransform>::New();
+    transform->Identity();
+    transform->PostMultiply();
+    transform->RotateX(result.roll);
+    transform->RotateY(result.pitch);
+    transform->RotateZ(result.yaw);
+    return transform;
 }
 
 vtkSmartPointer<vtkPolyData> OrientationOptimizer::getPolyData(vtkSmartPointer<vtkActor> actor) {
@@ -111,84 +682,98 @@ vtkSmartPointer<vtkPolyData> OrientationOptimizer::getPolyData(vtkSmartPointer<v
 }
 
 
-// Compute support volume (total area of faces needing support)
-double OrientationOptimizer::computeSupportVolume(vtkSmartPointer<vtkPolyData> mesh, double angleThreshold) {
-    if (!mesh) return 0.0;
+// Per-face unit normals and areas of the triangles in mesh
+MarcSLM::Domain::FaceNormals OrientationOptimizer::extractFaceNormals(vtkPolyData* mesh) {
+    MarcSLM::Domain::FaceNormals faces;
+    if (!mesh || !mesh->GetPoints()) return faces;
 
-    auto normalGen = vtkSmartPointer<vtkPolyDataNormals>::New();
-    normalGen->SetInputData(mesh);
-    normalGen->ComputePointNormalsOff();
-    normalGen->ComputeCellNormalsOn();
-    normalGen->Update();
+    vtkCellArray* polys = mesh->GetPolys();
+    if (!polys) return faces;
 
-    auto polyData = normalGen->GetOutput();
-    if (!polyData) return 0.0;
+    faces.reserve(static_cast<std::size_t>(polys->GetNumberOfCells()));
+    mesh->GetCenter(faces.origin);
 
-    auto normals = polyData->GetCellData()->GetNormals();
-    if (!normals) return 0.0;
-
-    double totalArea = 0.0;
-    double supportArea = 0.0;
+    // Critical flags follow the cell ids in criticalFaceIds
+    std::vector<char> isCritical;
+    if (!criticalFaceIds.empty()) {
+        isCritical.assign(static_cast<std::size_t>(polys->GetNumberOfCells()), 0);
+        for (vtkIdType id : criticalFaceIds) {
+            if (id >= 0 && static_cast<std::size_t>(id) < isCritical.size()) {
+                isCritical[static_cast<std::size_t>(id)] = 1;
+            }
+        }
+        faces.critical.reserve(isCritical.size());
+    }
 
-    for (vtkIdType i = 0; i < polyData->GetNumberOfCells(); ++i) {
-        auto cell = polyData->GetCell(i);
-        if (!cell || cell->GetCellType() != VTK_TRIANGLE) continue;
+    auto it = vtk::TakeSmartPointer(polys->NewIterator());
+    for (it->GoToFirstCell(); !it->IsDoneWithTraversal(); it->GoToNextCell()) {
+        vtkIdType npts = 0;
+        const vtkIdType* pts = nullptr;
+        it->GetCurrentCell(npts, pts);
+        if (npts != 3) continue;
 
         double p0[3], p1[3], p2[3];
-        polyData->GetPoint(cell->GetPointId(0), p0);
-        polyData->GetPoint(cell->GetPointId(1), p1);
-        polyData->GetPoint(cell->GetPointId(2), p2);
-
-        double area = vtkTriangle::TriangleArea(p0, p1, p2);
-        totalArea += area;
-
-        double* normal = normals->GetTuple(i);
-        if (normal[2] < std::cos(angleThreshold)) {
-            supportArea += area;
+        mesh->GetPoint(pts[0], p0);
+        mesh->GetPoint(pts[1], p1);
+        mesh->GetPoint(pts[2], p2);
+        faces.addTriangle(p0, p1, p2);
+        if (!isCritical.empty()) {
+            faces.critical.push_back(isCritical[static_cast<std::size_t>(it->GetCurrentCellId())] ? 1.0f : 0.0f);
         }
     }
 
-    return supportArea;
-}
-
-// Compute overhang penalty (currently same as support volume)
-double OrientationOptimizer::computeOverhangPenalty(vtkSmartPointer<vtkPolyData> mesh, double angleThreshold) {
-    return computeSupportVolume(mesh, angleThreshold);
+    return faces;
 }
 
-// Evaluate penalty based on critical face overhang
-double OrientationOptimizer::computeCriticalSurfacePenalty(vtkSmartPointer<vtkPolyData> mesh, double angleThreshold) {
-    if (!mesh || criticalFaceIds.isEmpty()) return 0.0;
-
-    auto normalGen = vtkSmartPointer<vtkPolyDataNormals>::New();
-    normalGen->SetInputData(mesh);
-    normalGen->ComputePointNormalsOff();
-    normalGen->ComputeCellNormalsOn();
-    normalGen->Update();
-
-    auto polyData = normalGen->GetOutput();
-    if (!polyData) return 0.0;
-
-    auto normals = polyData->GetCellData()->GetNormals();
-    if (!normals) return 0.0;
-
-    double penalty = 0.0;
-    int count = 0;
-
-    for (vtkIdType id : criticalFaceIds) {
-        if (id < 0 || id >= polyData->GetNumberOfCells()) continue;
-
-        double* normal = normals->GetTuple(id);
-        if (normal && normal[2] < std::cos(angleThreshold)) {
-            penalty += 1.0;
-        }
-        ++count;
+OrientationOptimizer::ScoreContext OrientationOptimizer::makeScoreContext(
+    const MarcSLM::Domain::FaceNormals& faces, const MarcSLM::Domain::ConvexHull& hull,
+    double overhangThresholdDegrees) const {
+    ScoreContext context;
+    context.hull = &hull;
+    context.cosThreshold = std::cos(vtkMath::RadiansFromDegrees(overhangThresholdDegrees));
+    context.weights[0] = weightSupportArea;
+    context.weights[1] = weightSupportVolume;
+    context.weights[2] = weightBuildHeight;
+    context.weights[3] = weightCriticalSurface;
+
+    // Each term is divided by its largest plausible value so that the
+    // weights compare like with like
+    context.areaScale = std::max(faces.totalArea, 1e-12);
+    double lo[3] = { 0, 0, 0 }, hi[3] = { 0, 0, 0 };
+    for (int k = 0; k < 3; ++k) {
+        double axis[3] = { 0, 0, 0 };
+        axis[k] = 1.0;
+        hull.extent(axis, lo[k], hi[k]);
     }
-
-    return count > 0 ? (penalty / count) : 0.0;
+    context.lengthScale = std::max(std::sqrt((hi[0] - lo[0]) * (hi[0] - lo[0]) +
+                                             (hi[1] - lo[1]) * (hi[1] - lo[1]) +
+                                             (hi[2] - lo[2]) * (hi[2] - lo[2])), 1e-12);
+    context.criticalScale = faces.criticalArea();
+    return context;
 }
 
-// Compute model height from bounds (Z-axis)
-double OrientationOptimizer::computeBuildHeight(double bounds[6]) {
-    return bounds[5] - bounds[4];
+// Weighted objective; every mesh term comes from the same pass over the faces
+double OrientationOptimizer::scoreCandidate(const MarcSLM::Domain::FaceNormals& faces, const double up[3],
+                                            const ScoreContext& context) const {
+    if (faces.empty()) return 0.0;
+
+    // Plate and top of the part from the hull; the plate height is passed
+    // relative to the faces' origin, like their centroids
+    double lowest = 0.0, highest = 0.0;
+    context.hull->extent(up, lowest, highest);
+    const double origin = faces.origin[0] * up[0] + faces.origin[1] * up[1] + faces.origin[2] * up[2];
+    const MarcSLM::Domain::SupportTerms terms =
+        faces.supportTerms(up, context.cosThreshold, lowest - origin);
+
+    const double supportVolume = context.raster
+        ? context.raster->estimate(up, context.cosThreshold).volume
+        : terms.supportVolume;
+
+    double score = context.weights[0] * terms.supportArea / context.areaScale +
+                   context.weights[1] * supportVolume / (context.areaScale * context.lengthScale) +
+                   context.weights[2] * (highest - lowest) / context.lengthScale;
+    if (context.criticalScale > 0.0) {
+        score += context.weights[3] * terms.criticalArea / context.criticalScale;
+    }
+    return score;
 }
@@ -16,7 +16,16 @@
 #include <vtkTriangle.h>
 //#include "StlViewer.h"
 #include "slmcommons.h"
+#include "../core/domain/ConvexHull.h"
+#include "../core/domain/FaceNormals.h"
+#include "../core/domain/NormalHistogram.h"
+#include "../infrastructure/SupportRasterizer.h"
 #include <QObject>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
 
 class OrientationOptimizer : public QObject
 {
@@ -24,26 +33,202 @@ class OrientationOptimizer : public QObject
 public:
     explicit OrientationOptimizer(QObject* parent = nullptr);  // add explicit constructor with parent
  
+    /**
+     * @brief Outcome of an orientation search, angles in degrees
+     *
+     * The model is oriented by RotateX(roll), RotateY(pitch), RotateZ(yaw)
+     * applied in that order to a PostMultiply vtkTransform, as StlViewer
+     * does when it arranges the plate: M = Rz(yaw) Ry(pitch) Rx(roll).
+     */
+    struct OrientationResult {
+        double roll = 0.0;   // about X
+        double pitch = 0.0;  // about Y
+        double yaw = 0.0;    // about Z
+        double score = std::numeric_limits<double>::max();
+        bool valid = false;  // false when cancelled or there was nothing to score
+        // Searches on a decimated proxy only: the largest proxy vs full-mesh
+        // score gap observed among the rescored candidates (a sample, not a
+        // bound), how many candidates that was, and how far the proxy's
+        // vertices may lie off the mesh's surface (mesh units)
+        double proxyScoreGap = 0.0;
+        int proxyCandidates = 0;
+        double proxyDeviation = 0.0;
+        std::vector<OrientationResult> alternatives;  // other basins found, best first
+    };
+
+    /**
+     * @brief What the search needs from a mesh, copied off the VTK pipeline
+     */
+    struct MeshSample {
+        MarcSLM::Domain::FaceNormals faces;
+        std::vector<float> points;  // xyz of the mesh vertices, for the hull and footprint
+        std::vector<std::uint32_t> indices;  // three points per triangle, for the support rasterizer
+    };
+
     void optimizeModelOrientation(ModelInfo& model, double overhangThresholdDegrees);
 
-        double b_roll = 0;  // best_rotation about x axis
-         double b_pitch = 0;  // best_rotation about y axis
-        double  b_yaw = 0;  // best_rotation about z axis
+    /**
+     * @brief Face normals, areas and vertices of a model's mesh
+     *
+     * Reads the actor's VTK pipeline, so call it on the GUI thread; the
+     * result can then be searched on any thread.
+     */
+    MeshSample sampleMesh(const ModelInfo& model);
+
+    /**
+     * @brief Find the orientation with the lowest weighted score, on all cores
+     *
+     * Coarse to fine: the stable resting poses of the part's convex hull
+     * and build directions spread evenly over the sphere are scored
+     * against a NormalHistogram of the mesh, then pattern search on
+     * the full mesh refines the best few basins until the step drops below
+     * a quarter degree or the evaluation budget is spent. Yaw does not
+     * change support; it is chosen so that the part's footprint on the plate
+     * has the smallest bounding rectangle, aligned with the plate axes.
+     *
+     * Thread-safe: touches no VTK or Qt object other than emitting
+     * progressChanged. Candidates are split into fixed chunks and ties go
+     * to the lowest candidate index, so the result does not depend on the
+     * number of threads.
+     */
+    OrientationResult findBestOrientation(const MeshSample& mesh, double overhangThresholdDegrees);
+
+    /// Search several models in turn; progress covers all of them
+    QVector<OrientationResult> findBestOrientations(const QVector<MeshSample>& models,
+                                                    double overhangThresholdDegrees);
+
+    /**
+     * @brief Key for caching a search result
+     *
+     * Hashes the mesh contents (points, triangles, critical faces) together
+     * with everything else the result depends on: threshold, weights and
+     * search settings. Identical parts loaded from different files share a key.
+     */
+    std::uint64_t cacheKey(const MeshSample& mesh, double overhangThresholdDegrees) const;
+
+    /// Set the model's transform and angles (radians) from a search result (GUI thread)
+    void applyOrientation(ModelInfo& model, const OrientationResult& result);
+
+    /// Rotation of a search result as StlViewer applies it
+    static vtkSmartPointer<vtkTransform> transformFor(const OrientationResult& result);
+
+    /**
+     * @brief Resolution of the coarse stage
+     * @param histogramSubdivisions Normal histogram resolution (4: 5120 bins, ~3 degrees)
+     * @param coarseSubdivisions Coarse direction spacing (3: 642 directions, ~8 degrees)
+     */
+    void setSearchResolution(int histogramSubdivisions, int coarseSubdivisions);
+
+    /**
+     * @brief Mesh evaluations allowed for refinement, per model
+     *
+     * The coarse stage runs on the histogram and is not counted; nor is
+     * rescoring a proxy's candidates on the full mesh.
+     */
+    void setEvaluationBudget(int evaluations);
+
+    /**
+     * @brief Faces of the decimated proxy that large meshes are searched on
+     *
+     * When support volume is weighted, meshes with more than twice this
+     * many faces are searched on a quadric-decimated copy
+     * (Domain::MeshDecimator); the best candidates are then rescored on the
+     * full mesh, which picks the result and sets
+     * OrientationResult::proxyScoreGap. Other weightings score the full mesh
+     * faster than it decimates. 0 always searches the full mesh. Defaults
+     * to 20000.
+     */
+    void setProxyFaceCount(int faces);
+
+    /**
+     * @brief Weights of the terms of the orientation score
+     *
+     * Each term is normalised to about [0, 1] before weighting: support area
+     * by the mesh area, support volume by mesh area times the part's
+     * diagonal, build height (which sets the recoat count) by the
+     * diagonal and critical overhang area by the total critical area.
+     * Defaults to support area only.
+     *
+     * Support volume is measured by Infrastructure::SupportRasterizer on the
+     * mesh, so supports end on the part below rather than the plate;
+     * the coarse stage uses the per-face estimate of FaceNormals instead.
+     */
+    void setWeights(double supportArea, double supportVolume, double buildHeight, double criticalSurface);
+
+    /// Stop running searches soon; the optimizer stays cancelled afterwards
+    void cancel() { cancelRequested.store(true); }
+    bool isCancelled() const { return cancelRequested.load(); }
 
     void setCriticalFaceIds(const QVector<vtkIdType>& ids); // Faces to preserve
     
 
 signals:
     void logMessage(const QString& message);
+
+    /// Percentage of candidates scored; emitted from worker threads
+    void progressChanged(int percent);
 private:
     QVector<vtkIdType> criticalFaceIds;
 
-    double computeSupportVolume(vtkSmartPointer<vtkPolyData> mesh, double angleThreshold);
-    double computeOverhangPenalty(vtkSmartPointer<vtkPolyData> mesh, double angleThreshold);
-    double computeBuildHeight(double bounds[6]);
-    double computeCriticalSurfacePenalty(vtkSmartPointer<vtkPolyData> mesh, double angleThreshold);
+    std::atomic<bool> cancelRequested{false};
+    std::atomic<long long> candidatesDone{0};
+    std::atomic<int> lastPercent{-1};
+    long long candidatesTotal = 0;
+
+    int histogramLevels = 4;
+    int coarseLevels = 3;
+    int evaluationBudget = 256;
+    int proxyFaceCount = 20000;
+
+    double weightSupportArea = 1.0;
+    double weightSupportVolume = 0.0;
+    double weightBuildHeight = 0.0;
+    double weightCriticalSurface = 0.0;
+
+    using Direction = MarcSLM::Domain::NormalHistogram::Direction;
+
+    // Per-model constants of the score: the hull for extents, the overhang
+    // threshold, the weights and the scales that normalise each term
+    struct ScoreContext {
+        const MarcSLM::Domain::ConvexHull* hull = nullptr;
+        double cosThreshold = 0.0;
+        double weights[4] = { 1.0, 0.0, 0.0, 0.0 };
+        double areaScale = 1.0;
+        double lengthScale = 1.0;
+        double criticalScale = 0.0;  // 0 when no face is critical
+        const MarcSLM::Infrastructure::SupportRasterizer* raster = nullptr;  // support volume, or per-face estimate
+    };
+
+    OrientationResult searchCandidates(const MeshSample& mesh, double overhangThresholdDegrees);
+    // Coarse stage and refinement on one mesh: (score, up) of each seed, in seed order
+    std::vector<std::pair<double, Direction>> searchDirections(const MeshSample& mesh,
+                                                               const MarcSLM::Domain::ConvexHull& hull,
+                                                               double overhangThresholdDegrees);
+    MarcSLM::Domain::NormalHistogram buildHistogram(const MarcSLM::Domain::FaceNormals& faces) const;
+    std::vector<Direction> coarseDirections(const MarcSLM::Domain::ConvexHull& hull,
+                                            const Direction& centerOfMass) const;
+    std::size_t coarseCount() const;
+    long long candidatesPerModel() const;
+    std::vector<double> scoreDirections(const MarcSLM::Domain::FaceNormals& faces,
+                                        const std::vector<Direction>& directions,
+                                        const ScoreContext& context);
+    Direction refineDirection(const MarcSLM::Domain::FaceNormals& faces, Direction up,
+                              double& score, const ScoreContext& context, int& budget);
+    void reportCandidateDone();
+
+    ScoreContext makeScoreContext(const MarcSLM::Domain::FaceNormals& faces,
+                                  const MarcSLM::Domain::ConvexHull& hull,
+                                  double overhangThresholdDegrees) const;
+    double scoreCandidate(const MarcSLM::Domain::FaceNormals& faces, const double up[3],
+                          const ScoreContext& context) const;
 
     vtkSmartPointer<vtkPolyData> getPolyData(vtkSmartPointer<vtkActor> actor);
+    MarcSLM::Domain::FaceNormals extractFaceNormals(vtkPolyData* mesh);
+
+    // Roll, pitch and yaw (degrees) that turn up into +Z and then yaw the
+    // part so its footprint rectangle lines up with the plate axes
+    static void orientationForUp(const Direction& up, const MarcSLM::Domain::ConvexHull& hull,
+                                 OrientationResult& result);
 };
 
 #endif // ORIENTATIONOPTIMIZER_H
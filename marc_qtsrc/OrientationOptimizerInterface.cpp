@@ -4,6 +4,11 @@
 #include <QDebug>
 #include <QtConcurrent>
 
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <vector>
+
 // Helper struct to pair model index with reference to ModelInfo
 struct ModelJob {
     int index;
@@ -12,10 +17,15 @@ struct ModelJob {
 
 OrientationOptimizerInterface::OrientationOptimizerInterface(QObject* parent)
     : QObject(parent), models(nullptr),
-    w1(1.0), w2(1.0), w3(1.0), w4(1.0),
+    w1(1.0), w2(0.0), w3(0.0), w4(0.0),
     overhangThreshold(45.0) {
 }
 
+OrientationOptimizerInterface::~OrientationOptimizerInterface()
+{
+    cancel();
+}
+
 void OrientationOptimizerInterface::setModels(QVector<ModelInfo>* modelsRef)
 {
     models = modelsRef;
@@ -34,37 +44,100 @@ void OrientationOptimizerInterface::setWeights(double weight1, double weight2, d
     w4 = weight4;
 }
 
-QVector<QVector<double>>  OrientationOptimizerInterface::startOptimization(double theta)
+bool OrientationOptimizerInterface::startOptimization(double theta)
 {
-  QVector<QVector<double>> best_transforms;
-    if (!models || models->isEmpty())
-        return best_transforms;
+    if (!models || models->isEmpty() || isRunning())
+        return false;
 
     overhangThreshold = theta;
-
-    best_transforms.reserve(models->size()); // optional: performance optimization
-
-    for (int i = 0; i < models->size(); ++i) {
-        ModelInfo& model = (*models)[i];
-
-        OrientationOptimizer optimizer;
-
+    const int count = models->size();
+
+    // Meshes are read here: VTK pipelines must stay on the calling thread
+    auto run = std::make_shared<Run>();
+    run->samples.resize(count);
+    run->results.resize(count);
+    run->optimizers.reserve(count);
+    run->actors.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        auto optimizer = std::make_unique<OrientationOptimizer>();
+        optimizer->setWeights(w1, w2, w3, w4);
         if (criticalFaceMap.contains(i)) {
-            optimizer.setCriticalFaceIds(criticalFaceMap[i]);
+            optimizer->setCriticalFaceIds(criticalFaceMap[i]);
         }
-        
-        QVector<double>  bestTransform;
-           optimizer.optimizeModelOrientation(model, theta);
-
-       // model.transform = bestTransform;
-       // if (model.actor)
-           // model.actor->SetUserTransform(bestTransform);
+        run->samples[i] = optimizer->sampleMesh((*models)[i]);
+        run->optimizers.push_back(std::move(optimizer));
+        run->actors.push_back((*models)[i].actor);
+    }
 
-        //best_transforms.push_back(bestTransform);
+    // Heaviest parts start first, so the plate finishes about when its
+    // largest part does rather than when a large part queued last does
+    std::vector<int> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&run](int a, int b) {
+        return run->samples[a].faces.size() > run->samples[b].faces.size();
+    });
+
+    // The pool already runs one search per thread; each search's own
+    // parallel loops only get its share of the pool, instead of all cores
+    // again. The share is taken at each loop, so the searches still
+    // running pick up the threads of those that have finished.
+    QThreadPool* pool = QThreadPool::globalInstance();
+    run->threads = std::make_unique<MarcSLM::Infrastructure::ParallelWorkerShare>(
+        static_cast<unsigned>(std::max(1, pool->maxThreadCount())), static_cast<unsigned>(count));
+
+    currentRun = run;
+    bestTransforms = QVector<QVector<double>>(count);
+    pendingSearches = count;
+    for (int i : order) {
+        auto* watcher = new QFutureWatcher<void>(this);
+        connect(watcher, &QFutureWatcher<void>::finished, this, [this, watcher, run, i]() {
+            watcher->deleteLater();
+            finishSearch(run, i);
+        });
+        watcher->setFuture(QtConcurrent::run(pool, [run, i, theta]() {
+            {
+                MarcSLM::Infrastructure::ScopedParallelWorkerLimit limit(*run->threads);
+                run->results[i] = run->optimizers[i]->findBestOrientation(run->samples[i], theta);
+            }
+            run->threads->taskFinished();
+        }));
+    }
+    return true;
+}
 
-       // emit modelOptimized(i); // optional: for UI updates
+void OrientationOptimizerInterface::cancel()
+{
+    if (!currentRun)
+        return;
+    for (auto& optimizer : currentRun->optimizers) {
+        optimizer->cancel();
     }
-    return  best_transforms;
-   // emit optimizationFinished(); // optional: if you're tracking full completion
 }
 
+void OrientationOptimizerInterface::finishSearch(const std::shared_ptr<Run>& run, int index)
+{
+    if (run != currentRun)
+        return;
+
+    // The model list may have changed since the run started
+    const OrientationOptimizer::OrientationResult& result = run->results[index];
+    OrientationOptimizer& optimizer = *run->optimizers[index];
+    if (result.valid && !optimizer.isCancelled() && models) {
+        for (ModelInfo& model : *models) {
+            if (model.actor != run->actors[index])
+                continue;
+            optimizer.applyOrientation(model, result);
+            vtkSmartPointer<vtkTransform> transform = OrientationOptimizer::transformFor(result);
+            model.transform = transform;
+            const double* elements = &transform->GetMatrix()->Element[0][0];
+            bestTransforms[index] = QVector<double>(elements, elements + 16);
+            break;
+        }
+    }
+    emit modelOptimized(index);
+
+    if (--pendingSearches == 0) {
+        currentRun.reset();
+        emit optimizationFinished(bestTransforms);
+    }
+}
@@ -15,6 +15,10 @@
 #include "StlViewer.h"
 #include <QtConcurrent/QtConcurrent>
 #include "OrientationOptimizer.h"
+#include "../infrastructure/ParallelFor.h"
+
+#include <memory>
+#include <vector>
 
 class OrientationOptimizer;
 
@@ -23,22 +27,67 @@ class OrientationOptimizerInterface : public QObject {
 
 public:
     explicit OrientationOptimizerInterface(QObject* parent = nullptr);
+    ~OrientationOptimizerInterface() override;
 
     void setModels(QVector<ModelInfo>* modelsRef);
     void setCriticalFaces(const QMap<int, QVector<vtkIdType>>& modelCriticalFaces);
+    /// Support area, support volume, build height and critical surface weights
     void setWeights(double weight1, double weight2, double weight3, double weight4);
-    QVector<QVector<double>> startOptimization(double theta);
+
+    /**
+     * @brief Start optimizing the orientation of every model, all at once
+     *
+     * Meshes are sampled on the calling thread, then each model is searched
+     * as its own task on the global thread pool, largest first, and the call
+     * returns. Each result is applied to its model (actor and transform) on
+     * this object's thread as its search finishes. Models share the pool's
+     * threads, so a search only splits its own loops across the threads
+     * its model gets.
+     *
+     * @param theta Overhang threshold angle in degrees
+     * @return False if there is nothing to optimize or a run is in progress
+     */
+    bool startOptimization(double theta);
+
+    bool isRunning() const { return pendingSearches > 0; }
+
+    /// Stop the running searches soon; models not yet done keep their orientation
+    void cancel();
 
 signals:
+    /// A model's result has been applied
     void modelOptimized(int index);
-    void optimizationFinished();
+
+    /**
+     * @brief Every search of the run has finished
+     * @param bestTransforms Per model, the row-major 4x4 matrix of its new
+     *        transform; empty for models that could not be optimized
+     */
+    void optimizationFinished(const QVector<QVector<double>>& bestTransforms);
 
 private:
+    // Owned jointly with the searches, so that they may outlive this object
+    struct Run {
+        std::vector<std::unique_ptr<OrientationOptimizer>> optimizers;
+        std::vector<OrientationOptimizer::MeshSample> samples;
+        std::vector<OrientationOptimizer::OrientationResult> results;
+        std::vector<vtkSmartPointer<vtkActor>> actors;
+        // Pool threads for the searches' own parallel loops, re-divided
+        // among the searches still running as others finish
+        std::unique_ptr<MarcSLM::Infrastructure::ParallelWorkerShare> threads;
+    };
+
+    void finishSearch(const std::shared_ptr<Run>& run, int index);
+
     QVector<ModelInfo>* models;
     QMap<int, QVector<vtkIdType>> criticalFaceMap;
 
     double w1, w2, w3, w4;
     double overhangThreshold;
+
+    std::shared_ptr<Run> currentRun;
+    QVector<QVector<double>> bestTransforms;
+    int pendingSearches = 0;
 };
 
 #endif // ORIENTATIONOPTIMIZERINTERFACE_H
@@ -4,6 +4,14 @@
 #include <vector>
 #include <string>
 #include <tuple>
+#include <cstddef>
+
+namespace MarcSLM {
+namespace Infrastructure {
+    class MappedFile;
+    struct StlFacets;
+}
+}
 
 class StlLoader {
 public:
@@ -13,22 +21,29 @@ public:
     const std::vector<unsigned int>& getIndices() const;
     const std::vector<std::tuple<float, float, float>>& getNormals() const;
 
+    // Vertex welding outcome of the last load
+    std::size_t getWeldedVertexCount() const { return weldedCount_; }
+    std::size_t getUnweldedVertexCount() const { return unweldedCount_; }
+
 private:
     void loadFile(const std::string& filename);
-    bool isAsciiSTL(std::ifstream& file);
 
-    void parseAsciiSTL(std::ifstream& file);
-    void parseBinarySTL(std::ifstream& file);
+    bool parseAsciiSTL(const MarcSLM::Infrastructure::MappedFile& file,
+                       MarcSLM::Infrastructure::StlFacets& facets);
+    bool parseBinarySTL(const MarcSLM::Infrastructure::MappedFile& file,
+                        MarcSLM::Infrastructure::StlFacets& facets);
+    void indexFacets(const MarcSLM::Infrastructure::StlFacets& facets);
 
-    bool areClose(float a, float b, float eps = 1e-6f) const;
-    bool float3Equal(const std::tuple<float, float, float>& a,
-                     const std::tuple<float, float, float>& b) const;
+    void reportWeldStats() const;
 
-    struct Float3Hash;
+    // Per-axis tolerance below which two vertices are treated as the same
+    static constexpr float WeldEpsilon = 1e-6f;
 
     std::vector<float> vertices_;
     std::vector<unsigned int> indices_;
     std::vector<std::tuple<float, float, float>> normals_;
+    std::size_t weldedCount_ = 0;
+    std::size_t unweldedCount_ = 0;
 };
 
 #endif // STL_LOADER_H
@@ -6,6 +6,7 @@
 #include <QDropEvent>
 #include <QFileInfo>
 #include <QDebug>
+#include <QStandardPaths>
 
 #include <vtkSTLReader.h>
 #include <vtkPolyDataMapper.h>
@@ -18,9 +19,33 @@
 #include <vtkProperty.h>
 #include <vtkCamera.h>
 
+namespace {
+
+// Faces steeper than this from the build direction need support
+constexpr double OverhangThresholdDegrees = 135.0;
+
+MarcSLM::Infrastructure::CachedOrientation toCached(const OrientationOptimizer::OrientationResult& result)
+{
+    return { result.roll, result.pitch, result.yaw, result.score };
+}
+
+OrientationOptimizer::OrientationResult fromCached(const MarcSLM::Infrastructure::CachedOrientation& cached)
+{
+    OrientationOptimizer::OrientationResult result;
+    result.roll = cached.roll;
+    result.pitch = cached.pitch;
+    result.yaw = cached.yaw;
+    result.score = cached.score;
+    result.valid = true;
+    return result;
+}
+
+} // namespace
+
 
 StlViewer::StlViewer(QWidget* parent)
     : QVTKOpenGLNativeWidget(parent)  // ✅ Now valid
+    , orientationCache((QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/orientations").toStdString())
 {
     setAcceptDrops(true);
 
@@ -119,6 +144,7 @@ StlViewer::StlViewer(QWidget* parent)
     arrangeBtn = new QPushButton("Arrange", this);
     pn_toggleButton = new QPushButton("Rot Dir", this);
     add_ModelBtn = new QPushButton("Add Model", this);
+    orientBtn = new QPushButton("Orient", this);
 
     pn_toggleButton->setCheckable(true);  // Makes it a toggle button
 
@@ -130,15 +156,16 @@ StlViewer::StlViewer(QWidget* parent)
     rotateZBtn->setStyleSheet(stlviewerButtonStyle);
     
     add_ModelBtn->setStyleSheet(stlviewerButtonStyle);
+    orientBtn->setStyleSheet(stlviewerButtonStyle);
     
  
 
   
     connect(add_ModelBtn, &QPushButton::clicked, this, [this]() {
 
-        QString filePath = QFileDialog::getOpenFileName(this, "Open STL File", "", "STL Files (*.stl)");
-        if (!filePath.isEmpty()) {
-            addModel(filePath);
+        QStringList filePaths = QFileDialog::getOpenFileNames(this, "Open STL Files", "", "STL Files (*.stl)");
+        if (!filePaths.isEmpty()) {
+            addModels(filePaths);
         }
     });
 
@@ -153,6 +180,7 @@ StlViewer::StlViewer(QWidget* parent)
     pn_toggleButton->setGeometry(10, 170, 100, 30);
     // Position in corner using fixed geometry or layout
     add_ModelBtn->setGeometry(140, 10, 140, 30);  // Position for add_ModelBtn
+    orientBtn->setGeometry(290, 10, 140, 30);
    
   
  
@@ -180,6 +208,22 @@ StlViewer::StlViewer(QWidget* parent)
     connect(arrangeBtn, &QPushButton::clicked, this, [this]() {
         arrangeModelsOnPlatter();
         });
+
+    connect(orientBtn, &QPushButton::clicked, this, [this]() {
+        if (isOptimizingOrientation()) {
+            cancelOrientationOptimization();
+            return;
+        }
+        OrientationOptimizerfnc();
+        if (isOptimizingOrientation()) {
+            orientBtn->setText("Cancel");
+        }
+        });
+
+    connect(&loadWatcher, &QFutureWatcher<vtkSmartPointer<vtkPolyData>>::finished,
+        this, &StlViewer::onModelsLoaded);
+    connect(&optimizationWatcher, &QFutureWatcher<QVector<OrientationOptimizer::OrientationResult>>::finished,
+        this, &StlViewer::onOrientationOptimizationFinished);
     auto customStyle = vtkSmartPointer<CustomInteractorStyle>::New();
     customStyle->SetDefaultRenderer(renderer);
 
@@ -300,12 +344,14 @@ void StlViewer::dragEnterEvent(QDragEnterEvent* event)
 void StlViewer::dropEvent(QDropEvent* event)
 {
     const QList<QUrl> urls = event->mimeData()->urls();
+    QStringList filePaths;
     for (const QUrl& url : urls) {
         QString filePath = url.toLocalFile();
         if (QFileInfo(filePath).suffix().toLower() == "stl") {
-            addModel(filePath);
+            filePaths.append(filePath);
         }
     }
+    addModels(filePaths);
 }
 
 void StlViewer::arrangeModelsOnPlatter()
@@ -427,11 +473,39 @@ void StlViewer::arrangeModelsOnPlatter()
 
 void StlViewer::onOrientationOptimizationFinished()
 {
-    //emit logMessage("-Orientation optimizations done!");
-    //optimizationWatcher.disconnect();  // Clean up connection
-    //optimizationNeeded = false; // Reset the optimization flag
+    orientBtn->setText("Orient");
+    if (!optimizer || optimizer->isCancelled()) {
+        emit logMessage("Orientation optimization cancelled.");
+        return;
+    }
+
+    // Results are applied here, on the GUI thread; models removed while the
+    // search ran are skipped by matching their actors.
+    const QVector<OrientationOptimizer::OrientationResult> results = optimizationWatcher.result();
+    for (int i = 0; i < results.size() && i < optimizationActors.size(); ++i) {
+        for (ModelInfo& model : models) {
+            if (model.actor == optimizationActors[i]) {
+                optimizer->applyOrientation(model, results[i]);
+                break;
+            }
+        }
+    }
+
+    // Remember the best orientation and the alternatives for next time
+    for (int i = 0; i < results.size() && i < optimizationKeys.size(); ++i) {
+        if (!results[i].valid) {
+            continue;
+        }
+        std::vector<MarcSLM::Infrastructure::CachedOrientation> orientations{ toCached(results[i]) };
+        for (const OrientationOptimizer::OrientationResult& alternative : results[i].alternatives) {
+            orientations.push_back(toCached(alternative));
+        }
+        orientationCache.store(optimizationKeys[i], orientations);
+    }
+    optimizationActors.clear();
+    optimizationKeys.clear();
+
     finalizeModelArrangement();        // Continue with arranging
-   // optimizationNeeded = false;
 }
 
 void StlViewer::finalizeModelArrangement()
@@ -470,19 +544,73 @@ void StlViewer::addModel(const QString& stlFilePath)
     if (!QFileInfo::exists(stlFilePath))
         return;
 
+    addModelActor(stlFilePath, readStl(stlFilePath));
+
+    renderer->ResetCamera();
+    vtkWidget->renderWindow()->Render();
+}
+
+void StlViewer::addModels(const QStringList& stlFilePaths)
+{
+    QStringList existing;
+    for (const QString& path : stlFilePaths) {
+        if (QFileInfo::exists(path))
+            existing.append(path);
+    }
+    if (existing.isEmpty())
+        return;
+
+    // One parse at a time; files dropped meanwhile follow in the next one
+    if (loadWatcher.isRunning()) {
+        queuedPaths.append(existing);
+        return;
+    }
+
+    // Parse all files concurrently off the GUI thread; each reader owns its
+    // own pipeline. onModelsLoaded() creates the actors and renders once.
+    loadingPaths = existing;
+    loadWatcher.setFuture(QtConcurrent::mapped(loadingPaths, &StlViewer::readStl));
+}
+
+void StlViewer::onModelsLoaded()
+{
+    const QList<vtkSmartPointer<vtkPolyData>> meshes = loadWatcher.future().results();
+    for (int i = 0; i < meshes.size() && i < loadingPaths.size(); ++i) {
+        addModelActor(loadingPaths[i], meshes[i]);
+    }
+    loadingPaths.clear();
+
+    renderer->ResetCamera();
+    vtkWidget->renderWindow()->Render();
+
+    if (!queuedPaths.isEmpty()) {
+        const QStringList next = queuedPaths;
+        queuedPaths.clear();
+        addModels(next);
+    }
+}
+
+vtkSmartPointer<vtkPolyData> StlViewer::readStl(const QString& stlFilePath)
+{
     auto reader = vtkSmartPointer<vtkSTLReader>::New();
     reader->SetFileName(stlFilePath.toUtf8().constData());
     reader->Update();
 
+    vtkSmartPointer<vtkPolyData> polyData = reader->GetOutput();
+    return polyData;
+}
+
+void StlViewer::addModelActor(const QString& stlFilePath, vtkSmartPointer<vtkPolyData> polyData)
+{
     auto mapper = vtkSmartPointer<vtkPolyDataMapper>::New();
-    mapper->SetInputConnection(reader->GetOutputPort());
+    mapper->SetInputData(polyData);
 
     auto actor = vtkSmartPointer<vtkActor>::New();
     actor->SetMapper(mapper);
     actor->GetProperty()->SetColor(0, 0.9, 0.1); // Default gray
     //this->setModelColor(index++, 0, 0.9, 0.1);
-       // Change background color to light gray
-    this->setBackgroundColor(0.95, 0.95, 0.95);
+       // Change background color to light gray (rendered by the caller)
+    renderer->SetBackground(0.95, 0.95, 0.95);
 
     // 🔷 Assign a transform for button-based rotation
     auto transform = vtkSmartPointer<vtkTransform>::New();
@@ -492,9 +620,6 @@ void StlViewer::addModel(const QString& stlFilePath)
     // 🔷 Add to scene and model list
     renderer->AddActor(actor);
     models.append({ stlFilePath, actor, transform });
-
-    renderer->ResetCamera();
-    vtkWidget->renderWindow()->Render();
 }
 
 
@@ -643,10 +768,10 @@ void StlViewer::rotateSelectedModel(double xDeg, double yDeg, double zDeg)
 
 void StlViewer::OrientationOptimizerfnc()
 {
-    // Use smart pointer to ensure automatic cleanup of optimizer
-    std::unique_ptr<OrientationOptimizer> optimizer = std::make_unique<OrientationOptimizer>(this);
-    connect(optimizer.get(), &OrientationOptimizer::logMessage,
-        this, &StlViewer::logMessage);
+    if (optimizationWatcher.isRunning()) {
+        emit logMessage("Orientation optimization is already running.");
+        return;
+    }
 
     // Guard against empty model list
     if (models.isEmpty()) {
@@ -654,22 +779,70 @@ void StlViewer::OrientationOptimizerfnc()
         return;
     }
 
-    // Iterate safely over models by reference
-    for (ModelInfo& model : this->models) {
-        // best_angles will hold the result for each model, freshly created
-        //QVector<double> best_angles;
-        emit logMessage("-Inside optimation loop!");
-        // If your function can fail, consider try-catch or error checking here
-        optimizer->optimizeModelOrientation(model, 135);
-
-       // model.best_orientation_angles[0] = best_angles[0];
-        //model.best_orientation_angles[1] = best_angles[1];
-        //model.best_orientation_angles[1] = best_angles[1];
-        // Use or store best_angles here safely
-        // For example, you could store it back into model or emit a signal
+    // A cancelled optimizer stays cancelled, so every run gets a fresh one
+    if (optimizer) {
+        optimizer->deleteLater();
+    }
+    optimizer = new OrientationOptimizer(this);
+    connect(optimizer, &OrientationOptimizer::logMessage,
+        this, &StlViewer::logMessage);
+    connect(optimizer, &OrientationOptimizer::progressChanged,
+        this, &StlViewer::orientationProgress);
+
+    // Meshes are copied off the VTK pipeline here on the GUI thread; only
+    // the search runs in the background, on all cores. Parts searched
+    // before with the same settings are oriented from the cache instead.
+    QVector<OrientationOptimizer::MeshSample> meshes;
+    meshes.reserve(models.size());
+    optimizationActors.clear();
+    optimizationKeys.clear();
+    int cached = 0;
+    for (ModelInfo& model : models) {
+        OrientationOptimizer::MeshSample mesh = optimizer->sampleMesh(model);
+        const std::uint64_t key = optimizer->cacheKey(mesh, OverhangThresholdDegrees);
+        const std::vector<MarcSLM::Infrastructure::CachedOrientation> hit = orientationCache.find(key);
+        if (!hit.empty()) {
+            optimizer->applyOrientation(model, fromCached(hit.front()));
+            ++cached;
+            continue;
+        }
+        meshes.append(std::move(mesh));
+        optimizationActors.append(model.actor);
+        optimizationKeys.append(key);
+    }
+
+    if (cached > 0) {
+        emit logMessage(QString("Orientation of %1 models taken from cache.").arg(cached));
+    }
+    if (meshes.isEmpty()) {
+        emit orientationProgress(100);
+        finalizeModelArrangement();
+        return;
+    }
+
+    emit logMessage(QString("Optimizing orientation of %1 models...").arg(meshes.size()));
+    OrientationOptimizer* search = optimizer;
+    optimizationWatcher.setFuture(QtConcurrent::run([search, meshes]() {
+        return search->findBestOrientations(meshes, OverhangThresholdDegrees);
+    }));
+}
+
+void StlViewer::cancelOrientationOptimization()
+{
+    if (optimizer && optimizationWatcher.isRunning()) {
+        optimizer->cancel();
     }
 }
 
+StlViewer::~StlViewer()
+{
+    // The search reads the optimizer, which is deleted with this widget
+    cancelOrientationOptimization();
+    optimizationWatcher.waitForFinished();
+    loadWatcher.cancel();
+    loadWatcher.waitForFinished();
+}
+
 std::vector<InternalGuiModel> StlViewer::getModels() const
 {
     std::vector<InternalGuiModel> internalModels;
@@ -17,6 +17,7 @@
 #include <vtkInteractorStyleTrackballActor.h>
 #include <vtkCylinderSource.h>
 #include <vtkPolyDataMapper.h>
+#include <vtkPolyData.h>
 #include <vtkAxesActor.h>
 #include <vtkOrientationMarkerWidget.h>
 #include <vtkProperty.h>
@@ -29,6 +30,7 @@
 
 #include "CustomInteractorStyle.h"
 #include "OrientationOptimizer.h"
+#include "../infrastructure/OrientationCache.h"
 #include "slmcommons.h"
 #include <QFileDialog>
 
@@ -38,8 +40,10 @@ class StlViewer : public QVTKOpenGLNativeWidget
 
 public:
     StlViewer(QWidget* parent = nullptr);
+    ~StlViewer() override;
 
     void addModel(const QString& stlFilePath);
+    void addModels(const QStringList& stlFilePaths);  // parsed in the background, rendered once
     QStringList getLoadedModelNames() const;
 
     void setModelColor(int index, double r, double g, double b);
@@ -47,6 +51,11 @@ public:
     void setBackgroundColor(double r, double g, double b);
     void arrangeModelsOnPlatter();
 
+    // Search every model's orientation in the background, then arrange the plate
+    void OrientationOptimizerfnc();
+    void cancelOrientationOptimization();
+    bool isOptimizingOrientation() const { return optimizationWatcher.isRunning(); }
+
     void addGroundPlate();
     void clearBuildPlate();
     QVector<int> getdeletedmodels();
@@ -54,6 +63,7 @@ public:
 
 signals:
     void logMessage(const QString& message);
+    void orientationProgress(int percent);
 
 protected:
     void dragEnterEvent(QDragEnterEvent* event) override;
@@ -61,6 +71,8 @@ protected:
 
 private:
     void finalizeModelArrangement();
+    static vtkSmartPointer<vtkPolyData> readStl(const QString& stlFilePath);
+    void addModelActor(const QString& stlFilePath, vtkSmartPointer<vtkPolyData> polyData);
 
     QVTKOpenGLNativeWidget* vtkWidget;
     vtkSmartPointer<vtkRenderer> renderer;
@@ -75,18 +87,25 @@ private:
     QPushButton* arrangeBtn;
     QPushButton* pn_toggleButton;
     QPushButton* add_ModelBtn;
+    QPushButton* orientBtn;  // starts the orientation search, cancels a running one
 	QVector<int> deletedmodels;
     enum RotationAxis { None, XAxis, YAxis, ZAxis };
     RotationAxis selectedRotationAxis = None;
 
     void showRotationButtons(bool show);
     void rotateSelectedModel(double xDeg, double yDeg, double zDeg);
-    void OrientationOptimizerfnc();
     int index = 0;
     double dir = 9;
     vtkSmartPointer<vtkOrientationMarkerWidget> axesWidget;
 
-    QFutureWatcher<void> optimizationWatcher;
+    QFutureWatcher<vtkSmartPointer<vtkPolyData>> loadWatcher;
+    QStringList loadingPaths;  // files being parsed, in result order
+    QStringList queuedPaths;   // files added while a parse was running
+
+    QFutureWatcher<QVector<OrientationOptimizer::OrientationResult>> optimizationWatcher;
+    QVector<vtkSmartPointer<vtkActor>> optimizationActors;  // models being searched, in result order
+    QVector<std::uint64_t> optimizationKeys;  // their cache keys, in the same order
+    MarcSLM::Infrastructure::OrientationCache orientationCache;  // results of earlier searches
     bool optimizationNeeded = false;
 
     OrientationOptimizer* optimizer = nullptr;  // ✅ Add optimizer as a member
@@ -95,6 +114,7 @@ private:
 
 
 private slots:
+    void onModelsLoaded();
     void onOrientationOptimizationFinished();
 };
 
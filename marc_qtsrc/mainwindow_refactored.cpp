@@ -17,6 +17,8 @@
 #include "presentation/PropertiesPanel.h"
 #include "presentation/MainWindowViewModel.h"
 #include "infrastructure/CollisionVisualizer.h"
+#include "infrastructure/CachingStlFileLoader.h"
+#include "infrastructure/MeshFileLoader.h"
 #include "infrastructure/VtkModelRenderer.h"
 
 #include <vtkRenderer.h>
@@ -26,6 +28,8 @@
 
 #include <QtConcurrent/QtConcurrent>
 #include <QFutureWatcher>
+#include <QShortcut>
+#include <QStandardPaths>
 
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
@@ -79,7 +83,10 @@ void MainWindow::setupNewArchitecture()
     m_buildPlate = std::make_shared<MarcSLM::Domain::BuildPlate>(100.0, 200.0);
     
     // 2. Create infrastructure services
-    m_stlLoader = std::make_shared<MarcSLM::Infrastructure::VtkStlFileLoader>();
+    // Repeatedly loaded parts are served from the on-disk mesh cache
+    m_stlLoader = std::make_shared<MarcSLM::Infrastructure::CachingStlFileLoader>(
+        MarcSLM::Infrastructure::MeshFileLoader::createDefault(),
+        (QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/meshes").toStdString());
     m_dllAdapter = std::make_shared<MarcSLM::Infrastructure::MarcDllAdapter>();
     
     // Note: m_modelRenderer and m_collisionVisualizer created after VTK viewport
@@ -173,10 +180,11 @@ void MainWindow::setupUI(QWidget *central)
     // Get VTK renderer from StlViewer (you may need to add this method to StlViewer)
     // For now, create a temporary renderer
     vtkSmartPointer<vtkRenderer> renderer = vtkSmartPointer<vtkRenderer>::New();
-    m_modelRenderer = std::make_shared<MarcSLM::Infrastructure::VtkModelRenderer>(renderer);
+    auto modelActors = std::make_shared<MarcSLM::Infrastructure::ActorRegistry>();
+    m_modelRenderer = std::make_shared<MarcSLM::Infrastructure::VtkModelRenderer>(renderer, modelActors);
     
-    // Create collision visualizer
-    m_collisionVisualizer = std::make_shared<MarcSLM::Infrastructure::CollisionVisualizer>(renderer);
+    // Create collision visualizer; it finds model actors through the renderer's registry
+    m_collisionVisualizer = std::make_shared<MarcSLM::Infrastructure::CollisionVisualizer>(renderer, modelActors);
 
     // ========================================
     // CREATE VIEWMODEL (BEFORE WIDGETS)
@@ -320,6 +328,20 @@ void MainWindow::connectNewArchitectureSignals()
                 (&MarcSLM::Presentation::ModelListWidget::addModelRequested),
             this, &MainWindow::onAddModelRequestedAsync);
     
+    // Model list ? Batch loader (several files picked or dropped at once)
+    connect(m_modelListWidget, &MarcSLM::Presentation::ModelListWidget::addModelsRequested,
+            this, [this](const QStringList& filePaths) {
+                if (!m_viewModel) {
+                    qCritical() << "ViewModel is null!";
+                    return;
+                }
+                appendLog(QString("Loading %1 models").arg(filePaths.size()));
+                progressBar->setRange(0, 100);
+                progressBar->setValue(0);
+                progressBar->setVisible(true);
+                m_viewModel->addModels(filePaths);
+            });
+    
     connect(m_modelListWidget, &MarcSLM::Presentation::ModelListWidget::removeModelRequested,
             m_viewModel.get(), &MarcSLM::Presentation::MainWindowViewModel::removeModel);
     
@@ -354,6 +376,20 @@ void MainWindow::connectNewArchitectureSignals()
     connect(m_viewModel.get(), &MarcSLM::Presentation::MainWindowViewModel::modelRemoved,
             m_modelListWidget, &MarcSLM::Presentation::ModelListWidget::onModelRemoved);
     
+    // Background loading progress; Esc aborts running loads
+    connect(m_viewModel.get(), &MarcSLM::Presentation::MainWindowViewModel::loadProgress,
+            progressBar, [this](const QString&, int percent) { progressBar->setValue(percent); });
+    
+    connect(m_viewModel.get(), &MarcSLM::Presentation::MainWindowViewModel::loadCancelled,
+            this, [this](const QString& fileName) { appendLog("Loading cancelled: " + fileName); });
+    
+    connect(m_viewModel.get(), &MarcSLM::Presentation::MainWindowViewModel::loadingFinished,
+            this, [this]() { progressBar->setVisible(false); });
+    
+    auto* cancelLoadShortcut = new QShortcut(QKeySequence(Qt::Key_Escape), this);
+    connect(cancelLoadShortcut, &QShortcut::activated,
+            m_viewModel.get(), &MarcSLM::Presentation::MainWindowViewModel::cancelLoading);
+    
     // ViewModel signals
     connect(m_viewModel.get(), &MarcSLM::Presentation::MainWindowViewModel::buildPlateCleared,
             this, &MainWindow::onBuildPlateCleared);
@@ -428,10 +464,21 @@ void MainWindow::onAddModelRequested()
         return;
     }
     
-    // Load models asynchronously
-    for (const QString& fileName : fileNames) {
-        onAddModelRequestedAsync(fileName);
+    // Load models asynchronously; several files load concurrently as one batch
+    if (fileNames.size() == 1) {
+        onAddModelRequestedAsync(fileNames.front());
+        return;
+    }
+    if (!m_viewModel) {
+        qCritical() << "ViewModel is null!";
+        return;
     }
+    
+    appendLog(QString("Loading %1 models").arg(fileNames.size()));
+    progressBar->setRange(0, 100);
+    progressBar->setValue(0);
+    progressBar->setVisible(true);
+    m_viewModel->addModels(fileNames);
 }
 
 void MainWindow::onAddModelRequestedAsync(const QString& filePath)
@@ -442,17 +489,12 @@ void MainWindow::onAddModelRequestedAsync(const QString& filePath)
     }
     
     appendLog("Loading model: " + QFileInfo(filePath).fileName());
+    progressBar->setRange(0, 100);
+    progressBar->setValue(0);
     progressBar->setVisible(true);
     
-    // Load synchronously to avoid threading issues
-    // TODO: Implement proper async loading with worker thread if needed
+    // Loads in the background; modelAdded / loadingFinished report back
     m_viewModel->addModel(filePath);
-    
-    progressBar->setVisible(false);
-    appendLog("Model loaded: " + QFileInfo(filePath).fileName());
-    
-    // Update collision visualization after model is added
-    updateCollisionVisualization();
 }
 
 // ========================================
@@ -473,8 +515,9 @@ void MainWindow::updateCollisionVisualization()
     }
     
     // Update visualization
-    std::map<int, int> emptyMap;  // TODO: Get actual model-to-actor map from ViewModel
-    m_collisionVisualizer->update(m_buildPlate.get(), emptyMap);
+    if (m_viewModel) {
+        m_collisionVisualizer->update(m_buildPlate.get(), m_viewModel->modelToActorMap());
+    }
     
     // Update status bar
     int collisionCount = m_collisionVisualizer->getCollisionCount();
@@ -2,11 +2,13 @@
 #include "../core/domain/BuildPlate.h"
 #include "../core/domain/Model.h"
 #include "../core/application/usecases/AddModelUseCase.h"
+#include "../core/application/usecases/AddModelsBatchUseCase.h"
 #include "../infrastructure/MarcDllAdapter.h"
 
 #include <QFileInfo>
 #include <algorithm>
 #include <QMetaObject>
+#include <QTimer>
 
 namespace MarcSLM {
 namespace Presentation {
@@ -23,7 +25,12 @@ MainWindowViewModel::MainWindowViewModel(
     , m_stlLoader(std::move(stlLoader))
     , m_renderer(std::move(renderer))
     , m_dllAdapter(std::move(dllAdapter))
+    , m_loadPollTimer(new QTimer(this))
 {
+    // Poll background loads often enough for a smooth progress bar
+    m_loadPollTimer->setInterval(50);
+    connect(m_loadPollTimer, &QTimer::timeout, this, &MainWindowViewModel::pollLoads);
+    
     // Validate dependencies
     if (!m_buildPlate || !m_stlLoader || !m_renderer || !m_dllAdapter) {
         qCritical() << "MainWindowViewModel: Null dependency detected!";
@@ -42,13 +49,25 @@ MainWindowViewModel::MainWindowViewModel(
         m_renderer
     );
     
+    m_addModelsBatchUseCase = std::make_unique<Application::AddModelsBatchUseCase>(
+        m_stlLoader,
+        m_buildPlate,
+        m_renderer
+    );
+    
     // Set progress callback
     m_addModelUseCase->setProgressCallback(
         [this](const std::string& msg) { this->onProgressUpdate(msg); }
     );
+    m_addModelsBatchUseCase->setProgressCallback(
+        [this](const std::string& msg) { this->onProgressUpdate(msg); }
+    );
 }
 
 MainWindowViewModel::~MainWindowViewModel() {
+    // Handles cancel and join their workers on destruction
+    cancelLoading();
+    m_pendingLoads.clear();
 }
 
 void MainWindowViewModel::addModel(const QString& filePath) {
@@ -59,25 +78,135 @@ void MainWindowViewModel::addModel(const QString& filePath) {
         return;
     }
     
-    std::string path = filePath.toStdString();
-    
     emit progressUpdate("Loading model: " + QFileInfo(filePath).fileName());
     
+    PendingLoad load;
+    load.filePath = filePath;
+    load.handle = std::make_unique<Application::MeshLoadHandle>();
+    
+    auto result = m_addModelUseCase->startLoad(filePath.toStdString(), *load.handle);
+    if (result.isError()) {
+        emit errorOccurred(QString::fromStdString(result.errorMessage()));
+        return;
+    }
+    
+    enqueueLoad(std::move(load));
+}
+
+void MainWindowViewModel::addModels(const QStringList& filePaths) {
+    if (filePaths.size() == 1) {
+        addModel(filePaths.front());
+        return;
+    }
+    if (!m_addModelsBatchUseCase) {
+        qCritical() << "AddModelsBatchUseCase not initialized - dependencies missing";
+        emit errorOccurred("Model loading system not initialized. Please check application setup.");
+        return;
+    }
+    
+    std::vector<std::string> paths;
+    paths.reserve(filePaths.size());
+    for (const QString& filePath : filePaths) {
+        paths.push_back(filePath.toStdString());
+    }
+    
+    emit progressUpdate(QString("Loading %1 models...").arg(filePaths.size()));
+    
+    PendingLoad load;
+    load.batch = std::make_unique<Application::MeshBatchLoadHandle>();
+    
+    auto result = m_addModelsBatchUseCase->startLoad(paths, *load.batch);
+    if (result.isError()) {
+        emit errorOccurred(QString::fromStdString(result.errorMessage()));
+        return;
+    }
+    
+    enqueueLoad(std::move(load));
+}
+
+void MainWindowViewModel::enqueueLoad(PendingLoad load) {
+    m_pendingLoads.push_back(std::move(load));
+    if (!m_loadPollTimer->isActive()) {
+        m_loadPollTimer->start();
+    }
+}
+
+void MainWindowViewModel::cancelLoading() {
+    for (auto& load : m_pendingLoads) {
+        load.cancel();
+    }
+}
+
+bool MainWindowViewModel::isLoading() const {
+    return !m_pendingLoads.empty();
+}
+
+void MainWindowViewModel::pollLoads() {
+    // Complete in request order so model IDs follow the order files were added
+    while (!m_pendingLoads.empty() && m_pendingLoads.front().isReady()) {
+        PendingLoad load = std::move(m_pendingLoads.front());
+        m_pendingLoads.pop_front();
+        if (load.batch) {
+            finishBatchLoad(load);
+        } else {
+            finishLoad(load);
+        }
+    }
+    
+    if (m_pendingLoads.empty()) {
+        m_loadPollTimer->stop();
+        emit loadingFinished();
+        return;
+    }
+    
+    const PendingLoad& current = m_pendingLoads.front();
+    int percent = static_cast<int>(current.progress() * 100.0);
+    emit loadProgress(current.displayName(), percent);
+}
+
+void MainWindowViewModel::finishLoad(PendingLoad& load) {
+    const QString fileName = QFileInfo(load.filePath).fileName();
+    
     try {
-        // Execute use case
-        auto result = m_addModelUseCase->execute(path);
+        auto result = m_addModelUseCase->finishLoad(load.filePath.toStdString(), *load.handle);
         
         if (result.isError()) {
-            emit errorOccurred(QString::fromStdString(result.errorMessage()));
+            if (load.handle->isCancelled()) {
+                emit loadCancelled(fileName);
+            } else {
+                emit errorOccurred(QString::fromStdString(result.errorMessage()));
+            }
             return;
         }
         
-        // Find the newly added model
-        auto models = m_buildPlate->getAllModels();
-        if (!models.empty()) {
-            auto lastModel = models.back();
-            if (lastModel) {
-                emit modelAdded(lastModel->id(), QFileInfo(filePath).fileName());
+        const int modelId = m_addModelUseCase->addedModelId();
+        if (m_addModelUseCase->addedActorId() >= 0) {
+            m_modelToActorMap[modelId] = m_addModelUseCase->addedActorId();
+        }
+        emit modelAdded(modelId, fileName);
+    } catch (const std::exception& e) {
+        emit errorOccurred(QString("Exception during model loading: %1").arg(e.what()));
+    } catch (...) {
+        emit errorOccurred("Unknown error during model loading");
+    }
+}
+
+void MainWindowViewModel::finishBatchLoad(PendingLoad& load) {
+    try {
+        const bool cancelled = load.batch->isCancelled();
+        auto added = m_addModelsBatchUseCase->finishLoad(*load.batch);
+        
+        for (const auto& entry : added) {
+            const QString fileName = QFileInfo(QString::fromStdString(entry.filePath)).fileName();
+            if (cancelled) {
+                emit loadCancelled(fileName);
+            } else if (!entry.isSuccess()) {
+                emit errorOccurred(QString::fromStdString(entry.errorMessage));
+            } else {
+                if (entry.actorId >= 0) {
+                    m_modelToActorMap[entry.modelId] = entry.actorId;
+                }
+                emit modelAdded(entry.modelId, fileName);
             }
         }
     } catch (const std::exception& e) {
@@ -87,6 +216,32 @@ void MainWindowViewModel::addModel(const QString& filePath) {
     }
 }
 
+bool MainWindowViewModel::PendingLoad::isReady() const {
+    return batch ? batch->isReady() : handle->isReady();
+}
+
+void MainWindowViewModel::PendingLoad::cancel() {
+    if (batch) {
+        batch->cancel();
+    } else {
+        handle->cancel();
+    }
+}
+
+double MainWindowViewModel::PendingLoad::progress() const {
+    return batch ? batch->progress() : handle->progress().fraction();
+}
+
+QString MainWindowViewModel::PendingLoad::displayName() const {
+    if (batch) {
+        return QString("%1 of %2 models").arg(batch->finishedCount()).arg(batch->fileCount());
+    }
+    if (handle->progress().phase() == MarcSLM::Application::LoadProgress::Phase::Hashing) {
+        return QString("Checking cache: %1").arg(QFileInfo(filePath).fileName());
+    }
+    return QFileInfo(filePath).fileName();
+}
+
 void MainWindowViewModel::removeModel(int modelId) {
     // Remove from renderer if mapped
     auto it = m_modelToActorMap.find(modelId);
@@ -115,13 +270,11 @@ void MainWindowViewModel::clearBuildPlate() {
 }
 
 void MainWindowViewModel::updateModelTransform(int modelId, const Domain::Transform& transform) {
-    auto modelPtr = m_buildPlate->getModel(modelId);
-    if (!modelPtr) {
+    // Through the plate, so its collision index follows the move
+    if (!m_buildPlate->setModelTransform(modelId, transform)) {
         return;
     }
     
-    modelPtr->setTransform(transform);
-    
     // Update renderer
     auto it = m_modelToActorMap.find(modelId);
     if (it != m_modelToActorMap.end() && m_renderer) {
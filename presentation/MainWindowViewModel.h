@@ -5,8 +5,11 @@
 #include <QString>
 #include <QStringList>
 #include <memory>
+#include <deque>
 #include <QThread>
 
+class QTimer;
+
 // Forward declarations to avoid circular dependencies
 namespace MarcSLM {
     namespace Domain {
@@ -16,7 +19,10 @@ namespace MarcSLM {
     }
     namespace Application {
         class AddModelUseCase;
+        class AddModelsBatchUseCase;
         class IStlFileLoader;
+        class MeshLoadHandle;
+        class MeshBatchLoadHandle;
         class IModelRenderer;
     }
     namespace Infrastructure {
@@ -31,6 +37,13 @@ namespace Presentation {
  * @brief ViewModel for MainWindow
  * 
  * Mediates between the UI (MainWindow) and the business logic (use cases).
+ * 
+ * Model files are loaded on background threads; a GUI-thread timer polls
+ * the running loads, reports progress and completes them in the order they
+ * were requested, so the UI stays responsive during large loads.
+ * 
+ * addModels() loads a whole set of files concurrently and adds them to
+ * the build plate together, rendering once for the batch.
  */
 class MainWindowViewModel : public QObject {
     Q_OBJECT
@@ -47,7 +60,10 @@ public:
     ~MainWindowViewModel();
     
     // Model management
-    void addModel(const QString& filePath);
+    void addModel(const QString& filePath);  // Asynchronous; see modelAdded / loadCancelled
+    void addModels(const QStringList& filePaths);  // Concurrent batch of addModel()
+    void cancelLoading();
+    bool isLoading() const;
     void removeModel(int modelId);
     void clearBuildPlate();
     
@@ -60,6 +76,9 @@ public:
     int getModelCount() const;
     bool hasModels() const;
     
+    /// Renderer actor id of every rendered model, by domain model id
+    const std::map<int, int>& modelToActorMap() const { return m_modelToActorMap; }
+    
     // Configuration
     void setConfigPath(const QString& configPath);
     QString getConfigPath() const;
@@ -74,6 +93,9 @@ signals:
     void buildPlateCleared();
     
     void progressUpdate(const QString& message);
+    void loadProgress(const QString& fileName, int percent);
+    void loadCancelled(const QString& fileName);
+    void loadingFinished();
     void errorOccurred(const QString& errorMessage);
     void slicingStarted();
     void slicingCompleted();
@@ -86,6 +108,7 @@ private:
     std::shared_ptr<Infrastructure::MarcDllAdapter> m_dllAdapter;
     
     std::unique_ptr<Application::AddModelUseCase> m_addModelUseCase;
+    std::unique_ptr<Application::AddModelsBatchUseCase> m_addModelsBatchUseCase;
     
     QString m_configPath;
     QString m_stylesPath;
@@ -93,7 +116,25 @@ private:
     // Mapping from domain model ID to VTK actor ID
     std::map<int, int> m_modelToActorMap;
     
+    // Background loads, oldest first; either a single file or a batch
+    struct PendingLoad {
+        QString filePath;
+        std::unique_ptr<Application::MeshLoadHandle> handle;
+        std::unique_ptr<Application::MeshBatchLoadHandle> batch;
+        
+        bool isReady() const;
+        void cancel();
+        double progress() const;
+        QString displayName() const;
+    };
+    std::deque<PendingLoad> m_pendingLoads;
+    QTimer* m_loadPollTimer;
+    
     void onProgressUpdate(const std::string& message);
+    void pollLoads();
+    void finishLoad(PendingLoad& load);
+    void finishBatchLoad(PendingLoad& load);
+    void enqueueLoad(PendingLoad load);
 };
 
 } // namespace Presentation
@@ -11,6 +11,16 @@
 namespace MarcSLM {
 namespace Presentation {
 
+namespace {
+
+// Formats the model file loader understands
+bool isModelFile(const QString& filePath) {
+    return filePath.endsWith(".stl", Qt::CaseInsensitive) ||
+           filePath.endsWith(".3mf", Qt::CaseInsensitive);
+}
+
+} // namespace
+
 ModelListWidget::ModelListWidget(MainWindowViewModel* viewModel, QWidget* parent)
     : QWidget(parent)
     , m_viewModel(viewModel)
@@ -69,7 +79,7 @@ void ModelListWidget::setupUI() {
     m_removeButton = new QPushButton("Remove", this);
     m_clearButton = new QPushButton("Clear All", this);
 
-    m_addButton->setToolTip("Add STL models");
+    m_addButton->setToolTip("Add STL or 3MF models");
     m_removeButton->setToolTip("Remove selected model");
     m_clearButton->setToolTip("Clear all models from build plate");
     
@@ -88,7 +98,7 @@ void ModelListWidget::setupUI() {
     layout->addWidget(m_buildVolumeLabel);
     
     // Drag and drop hint
-    auto* dropHintLabel = new QLabel("Drag & drop STL files here", this);
+    auto* dropHintLabel = new QLabel("Drag & drop STL or 3MF files here", this);
     dropHintLabel->setAlignment(Qt::AlignCenter);
     dropHintLabel->setStyleSheet("color: #81A1C1; font-size: 11px; font-style: italic;");
     layout->addWidget(dropHintLabel);
@@ -207,12 +217,12 @@ void ModelListWidget::onBuildPlateCleared() {
 }
 
 void ModelListWidget::onAddClicked() {
-    // Open file dialog here in the widget, emit per-file request
+    // Open file dialog here in the widget; several files go out as one batch
     QStringList fileNames = QFileDialog::getOpenFileNames(
         this,
-        tr("Open STL Models"),
+        tr("Open Models"),
         "",
-        tr("STL Files (*.stl);;All Files (*)")
+        tr("Model Files (*.stl *.3mf);;STL Files (*.stl);;3MF Files (*.3mf);;All Files (*)")
     );
 
     if (fileNames.isEmpty()) {
@@ -225,8 +235,10 @@ void ModelListWidget::onAddClicked() {
         return;
     }
 
-    for (const QString& fileName : fileNames) {
-        emit addModelRequested(fileName);
+    if (fileNames.size() == 1) {
+        emit addModelRequested(fileNames.front());
+    } else {
+        emit addModelsRequested(fileNames);
     }
 }
 
@@ -278,16 +290,16 @@ void ModelListWidget::dragEnterEvent(QDragEnterEvent* event)
 {
     // Accept drag if it contains file URLs
     if (event->mimeData()->hasUrls()) {
-        // Check if at least one URL is an STL file
-        bool hasStl = false;
+        // Check if at least one URL is a supported model file
+        bool hasModel = false;
         for (const QUrl& url : event->mimeData()->urls()) {
-            if (url.toLocalFile().endsWith(".stl", Qt::CaseInsensitive)) {
-                hasStl = true;
+            if (isModelFile(url.toLocalFile())) {
+                hasModel = true;
                 break;
             }
         }
         
-        if (hasStl) {
+        if (hasModel) {
             event->acceptProposedAction();
             m_listWidget->setStyleSheet(m_listWidget->styleSheet() + " QListWidget { border: 2px dashed #5E81AC; }");
         }
@@ -306,12 +318,18 @@ void ModelListWidget::dropEvent(QDropEvent* event)
     applyIndustrialStyle();
     
     if (event->mimeData()->hasUrls()) {
+        QStringList filePaths;
         for (const QUrl& url : event->mimeData()->urls()) {
             QString filePath = url.toLocalFile();
-            if (filePath.endsWith(".stl", Qt::CaseInsensitive)) {
-                emit addModelRequested(filePath);
+            if (isModelFile(filePath)) {
+                filePaths.append(filePath);
             }
         }
+        if (filePaths.size() == 1) {
+            emit addModelRequested(filePaths.front());
+        } else if (!filePaths.isEmpty()) {
+            emit addModelsRequested(filePaths);
+        }
         event->acceptProposedAction();
     }
 }
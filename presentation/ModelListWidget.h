@@ -43,6 +43,7 @@ signals:
     void modelSelected(int modelId);
     void addModelRequested();
     void addModelRequested(const QString& filePath);  // For drag-and-drop
+    void addModelsRequested(const QStringList& filePaths);  // Several files at once
     void removeModelRequested(int modelId);
     
 protected: